@@ -0,0 +1,5 @@
+module.exports = require('./webpack.config.base')({
+  target: 'worker_thread',
+  alwaysHasNode: true,
+  wrapInitWithTryCatch: true
+});
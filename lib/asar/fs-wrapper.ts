@@ -98,7 +98,8 @@ const enum AsarError {
   NOT_FOUND = 'NOT_FOUND',
   NOT_DIR = 'NOT_DIR',
   NO_ACCESS = 'NO_ACCESS',
-  INVALID_ARCHIVE = 'INVALID_ARCHIVE'
+  INVALID_ARCHIVE = 'INVALID_ARCHIVE',
+  INTEGRITY_FAILURE = 'INTEGRITY_FAILURE'
 }
 
 type AsarErrorObject = Error & { code?: string, errno?: number };
@@ -124,12 +125,24 @@ const createError = (errorType: AsarError, { asarPath, filePath }: { asarPath?:
     case AsarError.INVALID_ARCHIVE:
       error = new Error(`Invalid package ${asarPath}`);
       break;
+    case AsarError.INTEGRITY_FAILURE:
+      error = new Error(`Integrity check failed for ${filePath} in ${asarPath}`);
+      error.code = 'ERR_ASAR_INTEGRITY';
+      break;
     default:
       throw new Error(`Invalid error type "${errorType}" passed to createError.`);
   }
   return error;
 };
 
+// Copying a file out fails either because it does not exist, or because it
+// failed its integrity check.
+const createCopyFileOutError = (archive: NodeJS.AsarArchive, asarPath: string, filePath: string) => {
+  const info = archive.getFileInfo(filePath);
+  const errorType = info && info.hasIntegrity ? AsarError.INTEGRITY_FAILURE : AsarError.NOT_FOUND;
+  return createError(errorType, { asarPath, filePath });
+};
+
 const overrideAPISync = function (module: Record<string, any>, name: string, pathArgumentIndex?: number | null, fromAsync: boolean = false) {
   if (pathArgumentIndex == null) pathArgumentIndex = 0;
   const old = module[name];
@@ -143,7 +156,7 @@ const overrideAPISync = function (module: Record<string, any>, name: string, pat
     if (!archive) throw createError(AsarError.INVALID_ARCHIVE, { asarPath });
 
     const newPath = archive.copyFileOut(filePath);
-    if (!newPath) throw createError(AsarError.NOT_FOUND, { asarPath, filePath });
+    if (!newPath) throw createCopyFileOutError(archive, asarPath, filePath);
 
     args[pathArgumentIndex!] = newPath;
     return old.apply(this, args);
@@ -177,7 +190,7 @@ const overrideAPI = function (module: Record<string, any>, name: string, pathArg
 
     const newPath = archive.copyFileOut(filePath);
     if (!newPath) {
-      const error = createError(AsarError.NOT_FOUND, { asarPath, filePath });
+      const error = createCopyFileOutError(archive, asarPath, filePath);
       nextTick(callback, [error]);
       return;
     }
@@ -209,7 +222,7 @@ const makePromiseFunction = function (orig: Function, pathArgumentIndex: number)
 
     const newPath = archive.copyFileOut(filePath);
     if (!newPath) {
-      return Promise.reject(createError(AsarError.NOT_FOUND, { asarPath, filePath }));
+      return Promise.reject(createCopyFileOutError(archive, asarPath, filePath));
     }
 
     args[pathArgumentIndex] = newPath;
@@ -542,6 +555,9 @@ export const wrapFsWithAsar = (fs: Record<string, any>) => {
 
     logASARAccess(asarPath, filePath, info.offset);
     fs.read(fd, buffer, 0, info.size, info.offset, (error: Error) => {
+      if (!error && info.hasIntegrity && !archive.verifyRead(filePath, buffer, 0)) {
+        error = createError(AsarError.INTEGRITY_FAILURE, { asarPath, filePath });
+      }
       callback(error, encoding ? buffer.toString(encoding) : buffer);
     });
   };
@@ -581,6 +597,9 @@ export const wrapFsWithAsar = (fs: Record<string, any>) => {
 
     logASARAccess(asarPath, filePath, info.offset);
     fs.readSync(fd, buffer, 0, info.size, info.offset);
+    if (info.hasIntegrity && !archive.verifyRead(filePath, buffer, 0)) {
+      throw createError(AsarError.INTEGRITY_FAILURE, { asarPath, filePath });
+    }
     return (encoding) ? buffer.toString(encoding) : buffer;
   };
 
@@ -699,6 +718,9 @@ export const wrapFsWithAsar = (fs: Record<string, any>) => {
 
     logASARAccess(asarPath, filePath, info.offset);
     fs.readSync(fd, buffer, 0, info.size, info.offset);
+    if (info.hasIntegrity && !archive.verifyRead(filePath, buffer, 0)) {
+      throw createError(AsarError.INTEGRITY_FAILURE, { asarPath, filePath });
+    }
     const str = buffer.toString('utf8');
     return [str, str.length > 0];
   };
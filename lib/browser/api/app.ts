@@ -63,6 +63,18 @@ Object.defineProperty(app, 'applicationMenu', {
   return execFile !== 'electron';
 })();
 
+// Only watch garbage collections while someone listens for them.
+app.on('newListener', (event: string) => {
+  if (event === 'heap-statistics-updated' && app.listenerCount(event) === 0) {
+    app._setHeapStatisticsEnabled(true);
+  }
+});
+app.on('removeListener', (event: string) => {
+  if (event === 'heap-statistics-updated' && app.listenerCount(event) === 0) {
+    app._setHeapStatisticsEnabled(false);
+  }
+});
+
 app._setDefaultAppPaths = (packagePath) => {
   // Set the user path according to application's name.
   app.setPath('userData', path.join(app.getPath('appData'), app.name!));
@@ -135,40 +135,76 @@ class IncomingMessage extends Readable {
   }
 }
 
-/** Writable stream that buffers up everything written to it. */
+/**
+ * Writable stream that buffers up everything written to it.
+ *
+ * Chunks are kept as a list rather than concatenated; the list is handed to
+ * the URL loader as-is, which streams each chunk directly to the network
+ * service.
+ */
 class SlurpStream extends Writable {
-  _data: Buffer;
+  _data: (Buffer | NodeJS.UploadElement)[];
   constructor () {
     super();
-    this._data = Buffer.alloc(0);
+    this._data = [];
   }
 
+  // The chunks are read by the URL loader after the write callbacks have run,
+  // and callers are free to reuse their buffers by then, so keep copies.
   _write (chunk: Buffer, encoding: string, callback: () => void) {
-    this._data = Buffer.concat([this._data, chunk]);
+    this._data.push(Buffer.from(chunk));
+    callback();
+  }
+
+  _writev (chunks: { chunk: Buffer }[], callback: () => void) {
+    for (const { chunk } of chunks) {
+      this._data.push(Buffer.from(chunk));
+    }
     callback();
   }
 
+  appendElement (element: NodeJS.UploadElement) {
+    this._data.push(element);
+  }
+
   data () { return this._data; }
 }
 
+/**
+ * Writable stream that forwards chunks to the URL loader's data pipe.
+ *
+ * The native side writes straight from the chunks' memory without copying
+ * them, so a write callback only runs once its chunks are in the pipe and
+ * callers are free to reuse their buffers. Chunks that are written while a
+ * write is in flight are handed down together through _writev, which keeps
+ * several chunks queued natively without a round trip per chunk.
+ */
 class ChunkedBodyStream extends Writable {
-  _pendingChunk: Buffer | undefined;
+  _pendingChunks: Buffer[] | undefined;
   _downstream?: NodeJS.DataPipe;
   _pendingCallback?: (error?: Error) => void;
   _clientRequest: ClientRequest;
 
   constructor (clientRequest: ClientRequest) {
-    super();
+    super({ highWaterMark: clientRequest.writableHighWaterMark });
     this._clientRequest = clientRequest;
   }
 
-  _write (chunk: Buffer, encoding: string, callback: () => void) {
+  _write (chunk: Buffer, encoding: string, callback: (error?: Error) => void) {
+    this._writeChunks([chunk], callback);
+  }
+
+  _writev (chunks: { chunk: Buffer }[], callback: (error?: Error) => void) {
+    this._writeChunks(chunks.map(({ chunk }) => chunk), callback);
+  }
+
+  _writeChunks (chunks: Buffer[], callback: (error?: Error) => void) {
     if (this._downstream) {
-      this._downstream.write(chunk).then(callback, callback);
+      this._writeDownstream(chunks, callback);
     } else {
       // the contract of _write is that we won't be called again until we call
-      // the callback, so we're good to just save a single chunk.
-      this._pendingChunk = chunk;
+      // the callback, so we're good to just save a single batch of chunks.
+      this._pendingChunks = chunks;
       this._pendingCallback = callback;
 
       // The first write to a chunked body stream begins the request.
@@ -176,6 +212,13 @@ class ChunkedBodyStream extends Writable {
     }
   }
 
+  _writeDownstream (chunks: Buffer[], callback: (error?: Error) => void) {
+    // The native side holds on to the chunks until each promise resolves, and
+    // rejects every pending write once the pipe closes.
+    Promise.all(chunks.map(chunk => this._downstream!.write(chunk)))
+      .then(() => callback(), callback);
+  }
+
   _final (callback: () => void) {
     this._downstream!.done();
     callback();
@@ -186,14 +229,12 @@ class ChunkedBodyStream extends Writable {
       throw new Error('two startReading calls???');
     }
     this._downstream = pipe;
-    if (this._pendingChunk) {
-      const doneWriting = (maybeError: Error | void) => {
-        const cb = this._pendingCallback!;
-        delete this._pendingCallback;
-        delete this._pendingChunk;
-        cb(maybeError || undefined);
-      };
-      this._downstream.write(this._pendingChunk).then(doneWriting, doneWriting);
+    if (this._pendingChunks) {
+      const chunks = this._pendingChunks;
+      const callback = this._pendingCallback!;
+      delete this._pendingChunks;
+      delete this._pendingCallback;
+      this._writeDownstream(chunks, callback);
     }
   }
 }
@@ -383,8 +424,7 @@ export class ClientRequest extends Writable implements Electron.ClientRequest {
     delete this._urlLoaderOptions.headers[key];
   }
 
-  _write (chunk: Buffer, encoding: BufferEncoding, callback: () => void) {
-    this._firstWrite = true;
+  _ensureSlurpStream () {
     if (!this._body) {
       this._body = new SlurpStream();
       this._body.on('finish', () => {
@@ -392,8 +432,64 @@ export class ClientRequest extends Writable implements Electron.ClientRequest {
         this._startRequest();
       });
     }
+  }
+
+  _write (chunk: Buffer, encoding: BufferEncoding, callback: () => void) {
+    this._firstWrite = true;
+    this._ensureSlurpStream();
     // TODO: is this the right way to forward to another stream?
-    this._body.write(chunk, encoding, callback);
+    this._body!.write(chunk, encoding, callback);
+  }
+
+  _writev (chunks: { chunk: Buffer, encoding: BufferEncoding }[], callback: (error?: Error | null) => void) {
+    this._firstWrite = true;
+    this._ensureSlurpStream();
+    // Hand the whole batch down at once so a chunked body can queue it
+    // natively in a single pass.
+    const body = this._body!;
+    body.cork();
+    chunks.forEach(({ chunk, encoding }, i) => {
+      body.write(chunk, encoding, i === chunks.length - 1 ? callback : undefined);
+    });
+    body.uncork();
+  }
+
+  _writeUploadElement (element: NodeJS.UploadElement) {
+    if (this._chunkedEncoding) {
+      throw new Error('Files and blobs can not be uploaded with chunkedEncoding');
+    }
+    if (this._started || this.writableEnded) {
+      throw new Error('Can\'t write after the request has ended');
+    }
+    if (this.writableCorked || this.writableLength > 0) {
+      // Buffered writes haven't reached the body yet, so appending now would
+      // reorder the upload.
+      throw new Error('Can\'t write files or blobs while writes are buffered');
+    }
+    this._firstWrite = true;
+    this._ensureSlurpStream();
+    (this._body as SlurpStream).appendElement(element);
+  }
+
+  writeFile (filePath: string, options: { offset?: number, length?: number } = {}) {
+    if (typeof filePath !== 'string') {
+      throw new TypeError('`filePath` should be a string in writeFile(filePath)');
+    }
+    const { offset, length } = options;
+    if (offset != null && !(Number.isInteger(offset) && offset >= 0)) {
+      throw new TypeError('`offset` should be a non-negative integer');
+    }
+    if (length != null && !(Number.isInteger(length) && length >= 0)) {
+      throw new TypeError('`length` should be a non-negative integer');
+    }
+    this._writeUploadElement({ type: 'file', filePath, offset, length });
+  }
+
+  writeBlob (blobUUID: string) {
+    if (typeof blobUUID !== 'string') {
+      throw new TypeError('`blobUUID` should be a string in writeBlob(blobUUID)');
+    }
+    this._writeUploadElement({ type: 'blob', blobUUID });
   }
 
   _final (callback: () => void) {
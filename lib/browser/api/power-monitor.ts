@@ -9,6 +9,9 @@ const {
 } = process._linkedBinding('electron_browser_power_monitor');
 
 class PowerMonitor extends EventEmitter {
+  private _pm: any = null;
+  private _idleThreshold = 60;
+
   constructor () {
     super();
     // Don't start the event source until both a) the app is ready and b)
@@ -17,6 +20,21 @@ class PowerMonitor extends EventEmitter {
       app.whenReady().then(() => {
         const pm = createPowerMonitor();
         pm.emit = this.emit.bind(this);
+        this._pm = pm;
+
+        // Idle state is only polled while someone listens for changes, all
+        // listeners share the same native watcher.
+        this._updateIdleWatcher(this.listenerCount('idle-state-changed'));
+        this.on('newListener', (event) => {
+          if (event === 'idle-state-changed') {
+            this._updateIdleWatcher(this.listenerCount('idle-state-changed') + 1);
+          }
+        });
+        this.on('removeListener', (event) => {
+          if (event === 'idle-state-changed') {
+            this._updateIdleWatcher(this.listenerCount('idle-state-changed'));
+          }
+        });
 
         if (process.platform === 'linux') {
           // On Linux, we inhibit shutdown in order to give the app a chance to
@@ -47,6 +65,24 @@ class PowerMonitor extends EventEmitter {
     return getSystemIdleTime();
   }
 
+  setIdleThreshold (idleThreshold: number) {
+    if (!Number.isInteger(idleThreshold) || idleThreshold <= 0) {
+      throw new TypeError('Invalid idle threshold, must be a positive integer');
+    }
+    this._idleThreshold = idleThreshold;
+    this._updateIdleWatcher(this.listenerCount('idle-state-changed'));
+  }
+
+  getIdleThreshold () {
+    return this._idleThreshold;
+  }
+
+  private _updateIdleWatcher (listenerCount: number) {
+    if (this._pm) {
+      this._pm.setIdleThreshold(listenerCount > 0 ? this._idleThreshold : 0);
+    }
+  }
+
   isOnBatteryPower () {
     return isOnBatteryPower();
   }
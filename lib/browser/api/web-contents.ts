@@ -503,6 +503,18 @@ WebContents.prototype._init = function () {
 
   this._windowOpenHandler = null;
 
+  // Frame tree diffs are only computed while someone is listening for them.
+  this.on('newListener', (event: string) => {
+    if (event === 'frame-tree-changed') {
+      this._startObservingFrameTree();
+    }
+  });
+  this.on('removeListener', (event: string) => {
+    if (event === 'frame-tree-changed' && this.listenerCount('frame-tree-changed') === 0) {
+      this._stopObservingFrameTree();
+    }
+  });
+
   // Dispatch IPC messages to the ipc module.
   this.on('-ipc-message' as any, function (this: Electron.WebContents, event: Electron.IpcMainEvent, internal: boolean, channel: string, args: any[]) {
     addSenderFrameToEvent(event);
@@ -1,6 +1,7 @@
+import { webContents } from 'electron/main';
 import { MessagePortMain } from '@electron/internal/browser/message-port-main';
 
-const { WebFrameMain, fromId } = process._linkedBinding('electron_browser_web_frame_main');
+const { WebFrameMain, fromId, _broadcast } = process._linkedBinding('electron_browser_web_frame_main');
 
 WebFrameMain.prototype.send = function (channel, ...args) {
   if (typeof channel !== 'string') {
@@ -25,6 +26,30 @@ WebFrameMain.prototype.postMessage = function (...args) {
   this._postMessage(...args);
 };
 
+type BroadcastTargets = (Electron.WebContents | Electron.WebFrameMain)[] | Electron.Session;
+
+function getBroadcastFrames (targets: BroadcastTargets) {
+  if (Array.isArray(targets)) {
+    return targets.map(target => target instanceof WebFrameMain ? target : target.mainFrame);
+  }
+  // Every frame of every WebContents in the session.
+  const frames: Electron.WebFrameMain[] = [];
+  for (const contents of webContents.getAllWebContents()) {
+    if (contents.session === targets && !contents.isDestroyed()) {
+      frames.push(...contents.mainFrame.framesInSubtree);
+    }
+  }
+  return frames;
+}
+
+function broadcast (targets: BroadcastTargets, channel: string, ...args: any[]) {
+  if (typeof channel !== 'string') {
+    throw new Error('Missing required channel argument');
+  }
+  return _broadcast(getBroadcastFrames(targets), false /* internal */, channel, args);
+}
+
 export default {
-  fromId
+  fromId,
+  broadcast
 };
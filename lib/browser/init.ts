@@ -16,6 +16,14 @@ require('@electron/internal/common/init');
 
 process._linkedBinding('electron_browser_event_emitter').setEventEmitterPrototype(EventEmitter.prototype);
 
+// Stream protocols send the file of a plain fs.ReadStream directly. Node keeps
+// the fs implementation given in the |fs| option under an internal symbol.
+process._linkedBinding('electron_browser_protocol').setFileReadStreamChecker((stream: any) => {
+  if (Object.getPrototypeOf(stream) !== fs.ReadStream.prototype) return false;
+  const kFs = Object.getOwnPropertySymbols(stream).find(symbol => symbol.description === 'kFs');
+  return kFs !== undefined && stream[kFs] === fs;
+});
+
 // Don't quit on fatal error.
 process.on('uncaughtException', function (error) {
   // Do nothing if the user has a custom uncaught exception handler.
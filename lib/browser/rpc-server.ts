@@ -57,6 +57,14 @@ ipcMainUtils.handleSync(IPC_MESSAGES.BROWSER_CLIPBOARD_SYNC, function (event, me
   return typeUtils.serialize((clipboard as any)[method](...typeUtils.deserialize(args)));
 });
 
+ipcMainInternal.handle(IPC_MESSAGES.BROWSER_CLIPBOARD_ASYNC, async function (event, method: string, ...args: any[]) {
+  if (!allowedClipboardMethods.has(method) || !method.endsWith('Async')) {
+    throw new Error(`Invalid method: ${method}`);
+  }
+
+  return typeUtils.serialize(await (clipboard as any)[method](...typeUtils.deserialize(args)));
+});
+
 if (BUILDFLAG(ENABLE_DESKTOP_CAPTURER)) {
   const desktopCapturer = require('@electron/internal/browser/desktop-capturer');
 
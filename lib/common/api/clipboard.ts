@@ -14,10 +14,19 @@ if (process.type === 'renderer') {
     };
   };
 
+  const makeRemoteAsyncMethod = function (method: keyof Electron.Clipboard) {
+    const { ipcRendererInternal } = require('@electron/internal/renderer/ipc-renderer-internal');
+    return async (...args: any[]) => {
+      args = typeUtils.serialize(args);
+      const result = await ipcRendererInternal.invoke(IPC_MESSAGES.BROWSER_CLIPBOARD_ASYNC, method, ...args);
+      return typeUtils.deserialize(result);
+    };
+  };
+
   if (process.platform === 'linux') {
     // On Linux we could not access clipboard in renderer process.
     for (const method of Object.keys(clipboard) as (keyof Electron.Clipboard)[]) {
-      clipboard[method] = makeRemoteMethod(method);
+      clipboard[method] = method.endsWith('Async') ? makeRemoteAsyncMethod(method) : makeRemoteMethod(method);
     }
   } else if (process.platform === 'darwin') {
     // Read/write to find pasteboard over IPC since only main process is notified of changes
@@ -52,14 +52,20 @@ if (process.type === 'browser') {
 }
 
 if (process.platform === 'win32') {
-  // Always returns EOF for stdin stream.
-  const { Readable } = require('stream');
-  const stdin = new Readable();
-  stdin.push(null);
+  // Always returns EOF for stdin stream. The stream is only created when it is
+  // first used, so that processes and workers which never touch stdin don't
+  // load the stream module at startup.
+  let stdin: NodeJS.ReadableStream | undefined;
   Object.defineProperty(process, 'stdin', {
     configurable: false,
     enumerable: true,
     get () {
+      if (!stdin) {
+        const { Readable } = require('stream');
+        const readable = new Readable();
+        readable.push(null);
+        stdin = readable;
+      }
       return stdin;
     }
   });
@@ -1,5 +1,6 @@
 export const enum IPC_MESSAGES {
   BROWSER_CLIPBOARD_SYNC = 'BROWSER_CLIPBOARD_SYNC',
+  BROWSER_CLIPBOARD_ASYNC = 'BROWSER_CLIPBOARD_ASYNC',
   BROWSER_GET_LAST_WEB_PREFERENCES = 'BROWSER_GET_LAST_WEB_PREFERENCES',
   BROWSER_PRELOAD_ERROR = 'BROWSER_PRELOAD_ERROR',
   BROWSER_SANDBOX_LOAD = 'BROWSER_SANDBOX_LOAD',
@@ -0,0 +1,5 @@
+// Modules that are safe to use from main process worker threads, please sort
+// alphabetically
+export const workerThreadModuleList: ElectronInternal.ModuleEntry[] = [
+  { name: 'nativeImage', loader: () => require('@electron/internal/worker_thread/api/native-image') }
+];
@@ -0,0 +1,14 @@
+const { nativeImage } = process._linkedBinding('electron_common_native_image');
+
+const mainThreadOnly = (name: string) => () => {
+  throw new Error(`nativeImage.${name}() can only be used on the main thread`);
+};
+
+// Thumbnails and named images are created through APIs of the OS that must
+// run on the main thread.
+const workerNativeImage: typeof nativeImage = Object.assign({}, nativeImage, {
+  createThumbnailFromPath: mainThreadOnly('createThumbnailFromPath'),
+  createFromNamedImage: mainThreadOnly('createFromNamedImage')
+});
+
+export default workerNativeImage;
@@ -0,0 +1,12 @@
+// Worker threads of the main process are bootstrapped by Node, this only adds
+// the parts of Electron that can be used off the main thread.
+
+// Electron's bindings rely on gin, which is only set up for the isolates of
+// the workers that get here.
+process._linkedBinding('electron_browser_worker_thread').setUpIsolate();
+
+// Enable asar support, which Node only sets up for the main thread.
+process._linkedBinding('electron_common_asar').initAsarSupport(__non_webpack_require__);
+
+// Clear search paths.
+require('../common/reset-search-paths');
@@ -37,6 +37,10 @@ const main = async () => {
       name: 'worker_bundle_deps',
       config: 'webpack.config.worker.js'
     },
+    {
+      name: 'worker_thread_bundle_deps',
+      config: 'webpack.config.worker_thread.js'
+    },
     {
       name: 'asar_bundle_deps',
       config: 'webpack.config.asar.js'
@@ -48,6 +48,7 @@
 
 #if defined(OS_LINUX)
 #include "components/crash/core/app/breakpad_linux.h"
+#include "shell/browser/linux/headless_util.h"
 #include "v8/include/v8-wasm-trap-handler-posix.h"
 #include "v8/include/v8.h"
 #endif
@@ -325,6 +326,13 @@ void ElectronMainDelegate::PreSandboxStartup() {
     // Enable AVFoundation.
     command_line->AppendSwitch("enable-avfoundation");
 #endif
+
+#if defined(OS_LINUX)
+    // There is no display to present GPU output on in headless mode, offscreen
+    // windows are painted by the software compositor instead.
+    if (IsHeadlessOzonePlatform())
+      command_line->AppendSwitch(::switches::kDisableGpu);
+#endif
   }
 }
 
@@ -188,6 +188,7 @@ int NodeMain(int argc, char* argv[]) {
 
     // Initialize gin::IsolateHolder.
     JavascriptEnvironment gin_env(loop);
+    gin_env.UseThreadPoolForWorkerTasks();
 
     v8::Isolate* isolate = gin_env.isolate();
 
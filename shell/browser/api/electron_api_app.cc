@@ -42,6 +42,7 @@
 #include "shell/browser/javascript_environment.h"
 #include "shell/browser/login_handler.h"
 #include "shell/browser/relauncher.h"
+#include "shell/common/api/electron_bindings.h"
 #include "shell/common/application_info.h"
 #include "shell/common/electron_command_line.h"
 #include "shell/common/electron_paths.h"
@@ -588,6 +589,26 @@ void OnIconDataAvailable(gin_helper::Promise<gfx::Image> promise,
   }
 }
 
+// Reads an optional size given in megabytes, like --max-old-space-size, and
+// throws if it is not a non-negative integer.
+bool GetMegabytesOption(gin::Arguments* args,
+                        const gin_helper::Dictionary& options,
+                        const std::string& name,
+                        size_t* bytes) {
+  v8::Local<v8::Value> value;
+  if (!options.Get(name, &value) || value->IsUndefined())
+    return true;
+  int megabytes = -1;
+  if (!value->IsInt32() ||
+      !gin::ConvertFromV8(args->isolate(), value, &megabytes) ||
+      megabytes < 0) {
+    args->ThrowTypeError(name + " must be a non-negative integer");
+    return false;
+  }
+  *bytes = static_cast<size_t>(megabytes) * 1024 * 1024;
+  return true;
+}
+
 }  // namespace
 
 App::App() {
@@ -1453,6 +1474,58 @@ void App::SetUserAgentFallback(const std::string& user_agent) {
   ElectronBrowserClient::Get()->SetUserAgent(user_agent);
 }
 
+void App::OnNearHeapLimit(const HeapMonitor::NearHeapLimitDetails& details) {
+  v8::Isolate* isolate = JavascriptEnvironment::GetIsolate();
+  v8::HandleScope handle_scope(isolate);
+  auto dict = gin_helper::Dictionary::CreateEmpty(isolate);
+  dict.Set("heapLimit", static_cast<double>(details.heap_limit >> 10));
+  dict.Set("raisedHeapLimit",
+           static_cast<double>(details.raised_heap_limit >> 10));
+  if (!details.heap_snapshot_path.empty())
+    dict.Set("heapSnapshotPath", details.heap_snapshot_path);
+  Emit("near-heap-limit", dict);
+}
+
+void App::OnHeapStatisticsUpdated() {
+  v8::Isolate* isolate = JavascriptEnvironment::GetIsolate();
+  v8::HandleScope handle_scope(isolate);
+  Emit("heap-statistics-updated", ElectronBindings::GetHeapStatistics(isolate));
+}
+
+HeapMonitor* App::GetHeapMonitor() {
+  if (!heap_monitor_) {
+    heap_monitor_ = std::make_unique<HeapMonitor>(
+        JavascriptEnvironment::GetIsolate(), this);
+  }
+  return heap_monitor_.get();
+}
+
+void App::SetHeapLimitOptions(gin::Arguments* args) {
+  gin_helper::Dictionary options;
+  if (!args->GetNext(&options)) {
+    args->ThrowTypeError("Must pass an options object");
+    return;
+  }
+
+  HeapMonitor::Options heap_options;
+  if (!GetMegabytesOption(args, options, "maxOldSpaceSize",
+                          &heap_options.max_old_space_size) ||
+      !GetMegabytesOption(args, options, "extraOldSpaceSize",
+                          &heap_options.extra_old_space_size))
+    return;
+  if (options.Has("heapSnapshotPath") &&
+      !options.Get("heapSnapshotPath", &heap_options.heap_snapshot_path)) {
+    args->ThrowTypeError("heapSnapshotPath must be a string");
+    return;
+  }
+
+  GetHeapMonitor()->SetOptions(heap_options);
+}
+
+void App::SetHeapStatisticsEnabled(bool enabled) {
+  GetHeapMonitor()->SetStatisticsEnabled(enabled);
+}
+
 std::string App::GetUserAgentFallback() {
   return ElectronBrowserClient::Get()->GetUserAgent();
 }
@@ -1666,6 +1739,8 @@ gin::ObjectTemplateBuilder App::GetObjectTemplateBuilder(v8::Isolate* isolate) {
       .SetProperty("userAgentFallback", &App::GetUserAgentFallback,
                    &App::SetUserAgentFallback)
       .SetMethod("enableSandbox", &App::EnableSandbox)
+      .SetMethod("setHeapLimitOptions", &App::SetHeapLimitOptions)
+      .SetMethod("_setHeapStatisticsEnabled", &App::SetHeapStatisticsEnabled)
       .SetProperty("allowRendererProcessReuse",
                    &App::CanBrowserClientUseCustomSiteInstance,
                    &App::SetBrowserClientCanUseCustomSiteInstance);
@@ -26,6 +26,7 @@
 #include "shell/browser/browser_observer.h"
 #include "shell/browser/electron_browser_client.h"
 #include "shell/browser/event_emitter_mixin.h"
+#include "shell/common/heap_monitor.h"
 #include "shell/common/gin_helper/dictionary.h"
 #include "shell/common/gin_helper/error_thrower.h"
 #include "shell/common/gin_helper/promise.h"
@@ -51,7 +52,8 @@ class App : public ElectronBrowserClient::Delegate,
             public gin_helper::EventEmitterMixin<App>,
             public BrowserObserver,
             public content::GpuDataManagerObserver,
-            public content::BrowserChildProcessObserver {
+            public content::BrowserChildProcessObserver,
+            public HeapMonitor::Delegate {
  public:
   using FileIconCallback =
       base::RepeatingCallback<void(v8::Local<v8::Value>, const gfx::Image&)>;
@@ -160,6 +162,11 @@ class App : public ElectronBrowserClient::Delegate,
       const content::ChildProcessData& data,
       const content::ChildProcessTerminationInfo& info) override;
 
+  // HeapMonitor::Delegate:
+  void OnNearHeapLimit(
+      const HeapMonitor::NearHeapLimitDetails& details) override;
+  void OnHeapStatisticsUpdated() override;
+
  private:
   void BrowserChildProcessCrashedOrKilled(
       const content::ChildProcessData& data,
@@ -215,6 +222,9 @@ class App : public ElectronBrowserClient::Delegate,
   std::string GetUserAgentFallback();
   void SetBrowserClientCanUseCustomSiteInstance(bool should_disable);
   bool CanBrowserClientUseCustomSiteInstance();
+  void SetHeapLimitOptions(gin::Arguments* args);
+  void SetHeapStatisticsEnabled(bool enabled);
+  HeapMonitor* GetHeapMonitor();
 
 #if defined(OS_MAC)
   void SetActivationPolicy(gin_helper::ErrorThrower thrower,
@@ -254,6 +264,8 @@ class App : public ElectronBrowserClient::Delegate,
       std::map<int, std::unique_ptr<electron::ProcessMetric>>;
   ProcessMetricMap app_metrics_;
 
+  std::unique_ptr<HeapMonitor> heap_monitor_;
+
   bool disable_hw_acceleration_ = false;
   bool disable_domain_blocking_for_3DAPIs_ = false;
 
@@ -32,6 +32,10 @@
 #include "shell/browser/native_window_views.h"
 #endif
 
+#if defined(OS_LINUX)
+#include "shell/browser/linux/headless_util.h"
+#endif
+
 #if defined(OS_WIN)
 #include "shell/browser/ui/win/taskbar_host.h"
 #include "ui/base/win/shell.h"
@@ -1152,6 +1156,13 @@ void BaseWindow::RemoveFromParentChildWindows() {
 
 // static
 gin_helper::WrappableBase* BaseWindow::New(gin_helper::Arguments* args) {
+#if defined(OS_LINUX)
+  if (IsHeadlessOzonePlatform()) {
+    args->ThrowError("BaseWindow can not be created in headless mode");
+    return nullptr;
+  }
+#endif
+
   gin_helper::Dictionary options =
       gin::Dictionary::CreateEmpty(args->isolate());
   args->GetNext(&options);
@@ -26,6 +26,10 @@
 #include "shell/common/options_switches.h"
 #include "ui/gl/gpu_switching_manager.h"
 
+#if defined(OS_LINUX)
+#include "shell/browser/linux/headless_util.h"
+#endif
+
 namespace electron {
 
 namespace api {
@@ -484,6 +488,20 @@ gin_helper::WrappableBase* BrowserWindow::New(gin_helper::ErrorThrower thrower,
     options = gin::Dictionary::CreateEmpty(args->isolate());
   }
 
+#if defined(OS_LINUX)
+  if (IsHeadlessOzonePlatform()) {
+    gin_helper::Dictionary web_preferences;
+    bool offscreen = false;
+    if (options.Get(options::kWebPreferences, &web_preferences))
+      web_preferences.Get(options::kOffscreen, &offscreen);
+    if (!offscreen) {
+      thrower.ThrowError(
+          "Only offscreen windows can be created in headless mode");
+      return nullptr;
+    }
+  }
+#endif
+
   return new BrowserWindow(args, options);
 }
 
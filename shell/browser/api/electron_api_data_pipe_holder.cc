@@ -165,6 +165,14 @@ v8::Local<v8::Promise> DataPipeHolder::ReadAll(v8::Isolate* isolate) {
   return handle;
 }
 
+mojo::PendingRemote<network::mojom::DataPipeGetter>
+DataPipeHolder::CloneDataPipeGetter() {
+  mojo::PendingRemote<network::mojom::DataPipeGetter> data_pipe_getter;
+  if (data_pipe_)
+    data_pipe_->Clone(data_pipe_getter.InitWithNewPipeAndPassReceiver());
+  return data_pipe_getter;
+}
+
 // static
 gin::Handle<DataPipeHolder> DataPipeHolder::Create(
     v8::Isolate* isolate,
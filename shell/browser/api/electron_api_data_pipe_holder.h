@@ -9,6 +9,7 @@
 
 #include "gin/handle.h"
 #include "gin/wrappable.h"
+#include "mojo/public/cpp/bindings/pending_remote.h"
 #include "mojo/public/cpp/bindings/remote.h"
 #include "services/network/public/cpp/data_element.h"
 #include "services/network/public/mojom/data_pipe_getter.mojom.h"
@@ -34,6 +35,11 @@ class DataPipeHolder : public gin::Wrappable<DataPipeHolder> {
   // no one has complained about it yet.
   v8::Local<v8::Promise> ReadAll(v8::Isolate* isolate);
 
+  // Returns a new connection to the data pipe getter, which can be used as an
+  // element of another request body. Returns an invalid remote if the data
+  // has already been consumed by ReadAll.
+  mojo::PendingRemote<network::mojom::DataPipeGetter> CloneDataPipeGetter();
+
   // The unique ID that can be used to receive the object.
   const std::string& id() const { return id_; }
 
@@ -16,12 +16,32 @@
 #include "shell/common/gin_converters/native_window_converter.h"
 #include "shell/common/gin_converters/net_converter.h"
 #include "shell/common/gin_helper/dictionary.h"
+#include "shell/common/gin_helper/error_thrower.h"
 #include "shell/common/gin_helper/promise.h"
 #include "shell/common/node_includes.h"
 
+#if defined(OS_LINUX)
+#include "shell/browser/linux/headless_util.h"
+#endif
+
 namespace {
 
-int ShowMessageBoxSync(const electron::MessageBoxSettings& settings) {
+// Dialogs need a display server, which the headless Ozone platform lacks.
+bool ThrowIfHeadless(v8::Isolate* isolate) {
+#if defined(OS_LINUX)
+  if (electron::IsHeadlessOzonePlatform()) {
+    gin_helper::ErrorThrower(isolate).ThrowError(
+        "Cannot show dialogs in headless mode");
+    return true;
+  }
+#endif
+  return false;
+}
+
+int ShowMessageBoxSync(const electron::MessageBoxSettings& settings,
+                       gin::Arguments* args) {
+  if (ThrowIfHeadless(args->isolate()))
+    return -1;
   return electron::ShowMessageBoxSync(settings);
 }
 
@@ -42,6 +62,8 @@ v8::Local<v8::Promise> ShowMessageBox(
     const electron::MessageBoxSettings& settings,
     gin::Arguments* args) {
   v8::Isolate* isolate = args->isolate();
+  if (ThrowIfHeadless(isolate))
+    return v8::Local<v8::Promise>();
   gin_helper::Promise<gin_helper::Dictionary> promise(isolate);
   v8::Local<v8::Promise> handle = promise.GetHandle();
 
@@ -53,6 +75,8 @@ v8::Local<v8::Promise> ShowMessageBox(
 
 void ShowOpenDialogSync(const file_dialog::DialogSettings& settings,
                         gin::Arguments* args) {
+  if (ThrowIfHeadless(args->isolate()))
+    return;
   std::vector<base::FilePath> paths;
   if (file_dialog::ShowOpenDialogSync(settings, &paths))
     args->Return(paths);
@@ -61,6 +85,8 @@ void ShowOpenDialogSync(const file_dialog::DialogSettings& settings,
 v8::Local<v8::Promise> ShowOpenDialog(
     const file_dialog::DialogSettings& settings,
     gin::Arguments* args) {
+  if (ThrowIfHeadless(args->isolate()))
+    return v8::Local<v8::Promise>();
   gin_helper::Promise<gin_helper::Dictionary> promise(args->isolate());
   v8::Local<v8::Promise> handle = promise.GetHandle();
   file_dialog::ShowOpenDialog(settings, std::move(promise));
@@ -69,6 +95,8 @@ v8::Local<v8::Promise> ShowOpenDialog(
 
 void ShowSaveDialogSync(const file_dialog::DialogSettings& settings,
                         gin::Arguments* args) {
+  if (ThrowIfHeadless(args->isolate()))
+    return;
   base::FilePath path;
   if (file_dialog::ShowSaveDialogSync(settings, &path))
     args->Return(path);
@@ -77,6 +105,8 @@ void ShowSaveDialogSync(const file_dialog::DialogSettings& settings,
 v8::Local<v8::Promise> ShowSaveDialog(
     const file_dialog::DialogSettings& settings,
     gin::Arguments* args) {
+  if (ThrowIfHeadless(args->isolate()))
+    return v8::Local<v8::Promise>();
   gin_helper::Promise<gin_helper::Dictionary> promise(args->isolate());
   v8::Local<v8::Promise> handle = promise.GetHandle();
 
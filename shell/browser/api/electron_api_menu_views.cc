@@ -9,8 +9,13 @@
 
 #include "shell/browser/native_window_views.h"
 #include "shell/browser/unresponsive_suppressor.h"
+#include "shell/common/gin_helper/error_thrower.h"
 #include "ui/display/screen.h"
 
+#if defined(OS_LINUX)
+#include "shell/browser/linux/headless_util.h"
+#endif
+
 using views::MenuRunner;
 
 namespace electron {
@@ -26,6 +31,13 @@ void MenuViews::PopupAt(BaseWindow* window,
                         int y,
                         int positioning_item,
                         base::OnceClosure callback) {
+#if defined(OS_LINUX)
+  if (IsHeadlessOzonePlatform()) {
+    gin_helper::ErrorThrower().ThrowError("Cannot show menus in headless mode");
+    return;
+  }
+#endif
+
   auto* native_window = static_cast<NativeWindowViews*>(window->window());
   if (!native_window)
     return;
@@ -4,7 +4,9 @@
 
 #include "shell/browser/api/electron_api_net_log.h"
 
+#include <string>
 #include <utility>
+#include <vector>
 
 #include "base/command_line.h"
 #include "base/task/thread_pool.h"
@@ -14,8 +16,10 @@
 #include "electron/electron_version.h"
 #include "gin/object_template_builder.h"
 #include "shell/browser/electron_browser_context.h"
+#include "shell/browser/net/net_log_ring_buffer.h"
 #include "shell/browser/net/system_network_context_manager.h"
 #include "shell/common/gin_converters/file_path_converter.h"
+#include "shell/common/gin_converters/value_converter.h"
 #include "shell/common/gin_helper/dictionary.h"
 #include "shell/common/node_includes.h"
 
@@ -47,6 +51,16 @@ namespace electron {
 
 namespace {
 
+// Default upper bound of the memory used by the events of a recording.
+constexpr uint64_t kDefaultRecordingMaxSize = 10 * 1024 * 1024;
+
+// How often the events of a recording are moved from its file into memory,
+// and the size the file may reach in the meantime before the oldest events
+// are dropped from it.
+constexpr base::TimeDelta kRecordingSegmentInterval =
+    base::TimeDelta::FromSeconds(30);
+constexpr uint64_t kMaxRecordingSegmentSize = 100 * 1024 * 1024;
+
 scoped_refptr<base::SequencedTaskRunner> CreateFileTaskRunner() {
   // The tasks posted to this sequenced task runner do synchronous File I/O for
   // checking paths and setting permissions on files.
@@ -72,6 +86,14 @@ void ResolvePromiseWithNetError(gin_helper::Promise<void> promise,
   }
 }
 
+base::Value GetCustomConstants() {
+  auto command_line_string =
+      base::CommandLine::ForCurrentProcess()->GetCommandLineString();
+  auto channel_string = std::string("Electron " ELECTRON_VERSION);
+  return base::Value::FromUniquePtrValue(net_log::GetPlatformConstantsForNetLog(
+      command_line_string, channel_string));
+}
+
 }  // namespace
 
 namespace api {
@@ -124,12 +146,7 @@ v8::Local<v8::Promise> NetLog::StartLogging(base::FilePath log_path,
       base::make_optional<gin_helper::Promise<void>>(args->isolate());
   v8::Local<v8::Promise> handle = pending_start_promise_->GetHandle();
 
-  auto command_line_string =
-      base::CommandLine::ForCurrentProcess()->GetCommandLineString();
-  auto channel_string = std::string("Electron " ELECTRON_VERSION);
-  base::Value custom_constants =
-      base::Value::FromUniquePtrValue(net_log::GetPlatformConstantsForNetLog(
-          command_line_string, channel_string));
+  base::Value custom_constants = GetCustomConstants();
 
   auto* network_context =
       content::BrowserContext::GetDefaultStoragePartition(browser_context_)
@@ -213,12 +230,300 @@ v8::Local<v8::Promise> NetLog::StopLogging(gin::Arguments* args) {
   return handle;
 }
 
+v8::Local<v8::Promise> NetLog::StartRecording(gin::Arguments* args) {
+  net::NetLogCaptureMode capture_mode = net::NetLogCaptureMode::kDefault;
+  NetLogRingBuffer::Options options;
+  uint64_t max_size = kDefaultRecordingMaxSize;
+
+  gin_helper::Dictionary dict;
+  if (args->GetNext(&dict)) {
+    v8::Local<v8::Value> capture_mode_v8;
+    if (dict.Get("captureMode", &capture_mode_v8)) {
+      if (!gin::ConvertFromV8(args->isolate(), capture_mode_v8,
+                              &capture_mode)) {
+        args->ThrowTypeError("Invalid value for captureMode");
+        return v8::Local<v8::Promise>();
+      }
+    }
+    v8::Local<v8::Value> max_size_v8;
+    if (dict.Get("maxSize", &max_size_v8)) {
+      if (!gin::ConvertFromV8(args->isolate(), max_size_v8, &max_size) ||
+          max_size == 0) {
+        args->ThrowTypeError("Invalid value for maxSize");
+        return v8::Local<v8::Promise>();
+      }
+    }
+    std::vector<std::string> types;
+    if (dict.Get("eventTypes", &types))
+      options.event_types.insert(types.begin(), types.end());
+    types.clear();
+    if (dict.Get("sourceTypes", &types))
+      options.source_types.insert(types.begin(), types.end());
+  }
+  options.max_size = max_size;
+
+  if (recording_exporter_) {
+    args->ThrowTypeError("There is already a net log recording running");
+    return v8::Local<v8::Promise>();
+  }
+
+  pending_recording_promise_ =
+      base::make_optional<gin_helper::Promise<void>>(args->isolate());
+  v8::Local<v8::Promise> handle = pending_recording_promise_->GetHandle();
+
+  auto* network_context =
+      content::BrowserContext::GetDefaultStoragePartition(browser_context_)
+          ->GetNetworkContext();
+
+  network_context->CreateNetLogExporter(
+      mojo::MakeRequest(&recording_exporter_));
+  recording_exporter_.set_connection_error_handler(base::BindOnce(
+      &NetLog::OnRecordingConnectionError, weak_ptr_factory_.GetWeakPtr()));
+
+  recording_capture_mode_ = capture_mode;
+  recording_started_ = false;
+  ring_buffer_ =
+      base::MakeRefCounted<NetLogRingBuffer>(file_task_runner_, options);
+  base::PostTaskAndReplyWithResult(
+      file_task_runner_.get(), FROM_HERE,
+      base::BindOnce(&NetLogRingBuffer::OpenSegment, ring_buffer_),
+      base::BindOnce(&NetLog::StartRecordingAfterCreateFile,
+                     weak_ptr_factory_.GetWeakPtr()));
+
+  return handle;
+}
+
+void NetLog::StartRecordingAfterCreateFile(base::File output_file) {
+  if (!recording_exporter_) {
+    // The connection error handler has already rejected the promise.
+    return;
+  }
+  DCHECK(pending_recording_promise_);
+  if (!output_file.IsValid()) {
+    std::move(*pending_recording_promise_)
+        .RejectWithErrorMessage(
+            base::File::ErrorToString(output_file.error_details()));
+    recording_exporter_.reset();
+    ring_buffer_ = nullptr;
+    return;
+  }
+  // The exporter bounds the size of the file, so that a busy network does not
+  // grow it without limit on disk between two rotations.
+  recording_exporter_->Start(
+      std::move(output_file), GetCustomConstants(), recording_capture_mode_,
+      kMaxRecordingSegmentSize,
+      base::BindOnce(&NetLog::RecordingStarted, base::Unretained(this)));
+}
+
+void NetLog::RecordingStarted(int32_t error) {
+  DCHECK(pending_recording_promise_);
+  recording_started_ = error == net::OK;
+  if (recording_started_) {
+    rotation_timer_.Start(FROM_HERE, kRecordingSegmentInterval,
+                          base::BindRepeating(&NetLog::RotateSegments,
+                                              base::Unretained(this)));
+  }
+  ResolvePromiseWithNetError(std::move(*pending_recording_promise_), error);
+}
+
+void NetLog::OnRecordingConnectionError() {
+  recording_exporter_.reset();
+  next_recording_exporter_.reset();
+  ring_buffer_ = nullptr;
+  recording_started_ = false;
+  StopRotatingSegments();
+  if (pending_recording_promise_) {
+    std::move(*pending_recording_promise_)
+        .RejectWithErrorMessage("Failed to start net log exporter");
+  }
+  RejectPendingEvents("Net log recording failed");
+}
+
+bool NetLog::IsCurrentlyRecording() const {
+  return !!recording_exporter_;
+}
+
+v8::Local<v8::Promise> NetLog::GetRecordedEvents(gin::Arguments* args) {
+  gin_helper::Promise<base::Value> promise(args->isolate());
+  v8::Local<v8::Promise> handle = promise.GetHandle();
+
+  if (!ring_buffer_) {
+    promise.RejectWithErrorMessage("No net log recording in progress");
+    return handle;
+  }
+
+  if (!recording_started_) {
+    // Nothing has been logged yet.
+    promise.Resolve(base::Value(base::Value::Type::LIST));
+    return handle;
+  }
+
+  // A rotation that is already running may have stopped the segment that
+  // holds the latest events, so reads that arrive during it wait for the next
+  // one.
+  if (rotating_segments_) {
+    queued_events_promises_.push_back(std::move(promise));
+    return handle;
+  }
+  pending_events_promises_.push_back(std::move(promise));
+  RotateSegments();
+
+  return handle;
+}
+
+void NetLog::RotateSegments() {
+  if (rotating_segments_)
+    return;
+  rotating_segments_ = true;
+  // The net log only finishes writing a file when it is stopped, so start
+  // logging to a new segment, then stop the current one and read it.
+  base::PostTaskAndReplyWithResult(
+      file_task_runner_.get(), FROM_HERE,
+      base::BindOnce(&NetLogRingBuffer::OpenSegment, ring_buffer_),
+      base::BindOnce(&NetLog::StartNextSegment, weak_ptr_factory_.GetWeakPtr(),
+                     ring_buffer_));
+}
+
+void NetLog::StartNextSegment(scoped_refptr<NetLogRingBuffer> ring_buffer,
+                              base::File output_file) {
+  if (ring_buffer != ring_buffer_) {
+    // The recording has stopped in the meantime.
+    return;
+  }
+  if (!output_file.IsValid()) {
+    RejectPendingEvents(base::File::ErrorToString(output_file.error_details()));
+    return;
+  }
+
+  auto* network_context =
+      content::BrowserContext::GetDefaultStoragePartition(browser_context_)
+          ->GetNetworkContext();
+  network_context->CreateNetLogExporter(
+      mojo::MakeRequest(&next_recording_exporter_));
+  next_recording_exporter_.set_connection_error_handler(base::BindOnce(
+      &NetLog::OnRecordingConnectionError, weak_ptr_factory_.GetWeakPtr()));
+  next_recording_exporter_->Start(
+      std::move(output_file), GetCustomConstants(), recording_capture_mode_,
+      kMaxRecordingSegmentSize,
+      base::BindOnce(&NetLog::NextSegmentStarted, base::Unretained(this)));
+}
+
+void NetLog::NextSegmentStarted(int32_t error) {
+  if (error != net::OK) {
+    next_recording_exporter_.reset();
+    file_task_runner_->PostTask(
+        FROM_HERE,
+        base::BindOnce(&NetLogRingBuffer::DiscardNewestSegment, ring_buffer_));
+    RejectPendingEvents(net::ErrorToString(error));
+    return;
+  }
+
+  // Both segments receive the events logged until the previous one stops,
+  // which the ring buffer skips when it reads the new segment.
+  network::mojom::NetLogExporterPtr previous = std::move(recording_exporter_);
+  recording_exporter_ = std::move(next_recording_exporter_);
+  previous->Stop(
+      base::Value(base::Value::Type::DICTIONARY),
+      base::BindOnce(
+          [](network::mojom::NetLogExporterPtr, base::WeakPtr<NetLog> net_log,
+             scoped_refptr<NetLogRingBuffer> ring_buffer, int32_t error) {
+            if (net_log)
+              net_log->PreviousSegmentStopped(std::move(ring_buffer));
+          },
+          std::move(previous), weak_ptr_factory_.GetWeakPtr(), ring_buffer_));
+}
+
+void NetLog::PreviousSegmentStopped(
+    scoped_refptr<NetLogRingBuffer> ring_buffer) {
+  file_task_runner_->PostTaskAndReply(
+      FROM_HERE, base::BindOnce(&NetLogRingBuffer::ReadSegment, ring_buffer),
+      base::BindOnce(&NetLog::PreviousSegmentRead,
+                     weak_ptr_factory_.GetWeakPtr(), ring_buffer));
+}
+
+void NetLog::PreviousSegmentRead(scoped_refptr<NetLogRingBuffer> ring_buffer) {
+  if (ring_buffer != ring_buffer_)
+    return;
+  rotating_segments_ = false;
+
+  if (!pending_events_promises_.empty()) {
+    base::PostTaskAndReplyWithResult(
+        file_task_runner_.get(), FROM_HERE,
+        base::BindOnce(&NetLogRingBuffer::GetEvents, ring_buffer),
+        base::BindOnce(&NetLog::ResolvePendingEvents,
+                       weak_ptr_factory_.GetWeakPtr(),
+                       std::move(pending_events_promises_)));
+    pending_events_promises_.clear();
+  }
+
+  if (!queued_events_promises_.empty()) {
+    pending_events_promises_ = std::move(queued_events_promises_);
+    queued_events_promises_.clear();
+    RotateSegments();
+  }
+}
+
+void NetLog::ResolvePendingEvents(
+    std::vector<gin_helper::Promise<base::Value>> promises,
+    base::Value events) {
+  for (auto& promise : promises)
+    promise.Resolve(events);
+}
+
+void NetLog::RejectPendingEvents(base::StringPiece message) {
+  rotating_segments_ = false;
+  auto promises = std::move(pending_events_promises_);
+  pending_events_promises_.clear();
+  for (auto& promise : queued_events_promises_)
+    promises.push_back(std::move(promise));
+  queued_events_promises_.clear();
+  for (auto& promise : promises)
+    promise.RejectWithErrorMessage(message);
+}
+
+void NetLog::StopRotatingSegments() {
+  rotation_timer_.Stop();
+  rotating_segments_ = false;
+}
+
+v8::Local<v8::Promise> NetLog::StopRecording(gin::Arguments* args) {
+  gin_helper::Promise<void> promise(args->isolate());
+  v8::Local<v8::Promise> handle = promise.GetHandle();
+
+  if (recording_exporter_) {
+    StopRotatingSegments();
+    RejectPendingEvents("Net log recording stopped");
+    next_recording_exporter_.reset();
+    recording_started_ = false;
+    // Keep the buffer, and thus its files, alive until the network service
+    // is done writing to them.
+    recording_exporter_->Stop(
+        base::Value(base::Value::Type::DICTIONARY),
+        base::BindOnce(
+            [](network::mojom::NetLogExporterPtr,
+               scoped_refptr<NetLogRingBuffer>,
+               gin_helper::Promise<void> promise, int32_t error) {
+              ResolvePromiseWithNetError(std::move(promise), error);
+            },
+            std::move(recording_exporter_), std::move(ring_buffer_),
+            std::move(promise)));
+  } else {
+    promise.RejectWithErrorMessage("No net log recording in progress");
+  }
+
+  return handle;
+}
+
 gin::ObjectTemplateBuilder NetLog::GetObjectTemplateBuilder(
     v8::Isolate* isolate) {
   return gin::Wrappable<NetLog>::GetObjectTemplateBuilder(isolate)
       .SetProperty("currentlyLogging", &NetLog::IsCurrentlyLogging)
       .SetMethod("startLogging", &NetLog::StartLogging)
-      .SetMethod("stopLogging", &NetLog::StopLogging);
+      .SetMethod("stopLogging", &NetLog::StopLogging)
+      .SetProperty("currentlyRecording", &NetLog::IsCurrentlyRecording)
+      .SetMethod("startRecording", &NetLog::StartRecording)
+      .SetMethod("getRecordedEvents", &NetLog::GetRecordedEvents)
+      .SetMethod("stopRecording", &NetLog::StopRecording);
 }
 
 const char* NetLog::GetTypeName() {
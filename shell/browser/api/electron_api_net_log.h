@@ -8,9 +8,13 @@
 #include <list>
 #include <memory>
 #include <string>
+#include <vector>
 
 #include "base/callback.h"
 #include "base/optional.h"
+#include "base/sequenced_task_runner.h"
+#include "base/strings/string_piece.h"
+#include "base/timer/timer.h"
 #include "base/values.h"
 #include "gin/handle.h"
 #include "gin/wrappable.h"
@@ -24,6 +28,7 @@ class Arguments;
 namespace electron {
 
 class ElectronBrowserContext;
+class NetLogRingBuffer;
 
 namespace api {
 
@@ -36,6 +41,10 @@ class NetLog : public gin::Wrappable<NetLog> {
                                       gin::Arguments* args);
   v8::Local<v8::Promise> StopLogging(gin::Arguments* args);
   bool IsCurrentlyLogging() const;
+  v8::Local<v8::Promise> StartRecording(gin::Arguments* args);
+  v8::Local<v8::Promise> GetRecordedEvents(gin::Arguments* args);
+  v8::Local<v8::Promise> StopRecording(gin::Arguments* args);
+  bool IsCurrentlyRecording() const;
 
   // gin::Wrappable
   static gin::WrapperInfo kWrapperInfo;
@@ -56,6 +65,23 @@ class NetLog : public gin::Wrappable<NetLog> {
                                   base::File output_file);
   void NetLogStarted(int32_t error);
 
+  void OnRecordingConnectionError();
+
+  void StartRecordingAfterCreateFile(base::File output_file);
+  void RecordingStarted(int32_t error);
+
+  void RotateSegments();
+  void StartNextSegment(scoped_refptr<NetLogRingBuffer> ring_buffer,
+                        base::File output_file);
+  void NextSegmentStarted(int32_t error);
+  void PreviousSegmentStopped(scoped_refptr<NetLogRingBuffer> ring_buffer);
+  void PreviousSegmentRead(scoped_refptr<NetLogRingBuffer> ring_buffer);
+  void ResolvePendingEvents(
+      std::vector<gin_helper::Promise<base::Value>> promises,
+      base::Value events);
+  void RejectPendingEvents(base::StringPiece message);
+  void StopRotatingSegments();
+
  private:
   ElectronBrowserContext* browser_context_;
 
@@ -63,7 +89,25 @@ class NetLog : public gin::Wrappable<NetLog> {
 
   base::Optional<gin_helper::Promise<void>> pending_start_promise_;
 
-  scoped_refptr<base::TaskRunner> file_task_runner_;
+  // In-memory recording, independent of the file log above. Rotating the
+  // segments starts the next segment of the recording with
+  // |next_recording_exporter_| and then stops |recording_exporter_| and
+  // reads its events into |ring_buffer_|. The segments are rotated
+  // periodically and whenever the events are read.
+  network::mojom::NetLogExporterPtr recording_exporter_;
+  network::mojom::NetLogExporterPtr next_recording_exporter_;
+  scoped_refptr<NetLogRingBuffer> ring_buffer_;
+  net::NetLogCaptureMode recording_capture_mode_;
+  bool recording_started_ = false;
+  bool rotating_segments_ = false;
+  base::RepeatingTimer rotation_timer_;
+  base::Optional<gin_helper::Promise<void>> pending_recording_promise_;
+  // Reads that wait for the current rotation, and reads that arrived during
+  // it and wait for the next one.
+  std::vector<gin_helper::Promise<base::Value>> pending_events_promises_;
+  std::vector<gin_helper::Promise<base::Value>> queued_events_promises_;
+
+  scoped_refptr<base::SequencedTaskRunner> file_task_runner_;
 
   base::WeakPtrFactory<NetLog> weak_ptr_factory_{this};
 
@@ -58,6 +58,28 @@ PowerMonitor::~PowerMonitor() {
   base::PowerMonitor::RemoveObserver(this);
 }
 
+void PowerMonitor::SetIdleThreshold(int idle_threshold) {
+  if (idle_threshold <= 0) {
+    idle_state_watcher_.reset();
+    return;
+  }
+
+  base::TimeDelta threshold = base::TimeDelta::FromSeconds(idle_threshold);
+  if (idle_state_watcher_) {
+    idle_state_watcher_->SetThreshold(threshold);
+  } else {
+    // unretained is OK because we own idle_state_watcher_
+    idle_state_watcher_ = std::make_unique<IdleStateWatcher>(
+        threshold, base::BindRepeating(&PowerMonitor::OnIdleStateChanged,
+                                       base::Unretained(this)));
+  }
+}
+
+void PowerMonitor::OnIdleStateChanged(ui::IdleState state,
+                                      base::TimeDelta idle_time) {
+  Emit("idle-state-changed", state, idle_time.InSeconds());
+}
+
 bool PowerMonitor::ShouldShutdown() {
   return !Emit("shutdown");
 }
@@ -103,6 +125,7 @@ gin::ObjectTemplateBuilder PowerMonitor::GetObjectTemplateBuilder(
   auto builder =
       gin_helper::EventEmitterMixin<PowerMonitor>::GetObjectTemplateBuilder(
           isolate);
+  builder.SetMethod("setIdleThreshold", &PowerMonitor::SetIdleThreshold);
 #if defined(OS_LINUX)
   builder.SetMethod("setListeningForShutdown",
                     &PowerMonitor::SetListeningForShutdown);
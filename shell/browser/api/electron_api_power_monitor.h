@@ -5,9 +5,12 @@
 #ifndef SHELL_BROWSER_API_ELECTRON_API_POWER_MONITOR_H_
 #define SHELL_BROWSER_API_ELECTRON_API_POWER_MONITOR_H_
 
+#include <memory>
+
 #include "base/power_monitor/power_observer.h"
 #include "gin/wrappable.h"
 #include "shell/browser/event_emitter_mixin.h"
+#include "shell/browser/idle_state_watcher.h"
 #include "shell/common/gin_helper/pinnable.h"
 #include "ui/base/idle/idle.h"
 
@@ -40,6 +43,11 @@ class PowerMonitor : public gin::Wrappable<PowerMonitor>,
   void SetListeningForShutdown(bool);
 #endif
 
+  // Starts emitting "idle-state-changed" for |idle_threshold| seconds, or
+  // stops when it is 0.
+  void SetIdleThreshold(int idle_threshold);
+  void OnIdleStateChanged(ui::IdleState state, base::TimeDelta idle_time);
+
   // Called by native calles.
   bool ShouldShutdown();
 
@@ -78,6 +86,8 @@ class PowerMonitor : public gin::Wrappable<PowerMonitor>,
   PowerObserverLinux power_observer_linux_{this};
 #endif
 
+  std::unique_ptr<IdleStateWatcher> idle_state_watcher_;
+
   DISALLOW_COPY_AND_ASSIGN(PowerMonitor);
 };
 
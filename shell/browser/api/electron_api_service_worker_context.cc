@@ -6,20 +6,29 @@
 
 #include <string>
 #include <utility>
+#include <vector>
 
+#include "base/memory/ref_counted.h"
 #include "chrome/browser/browser_process.h"
 #include "content/public/browser/console_message.h"
 #include "content/public/browser/storage_partition.h"
 #include "gin/data_object_builder.h"
 #include "gin/handle.h"
 #include "gin/object_template_builder.h"
+#include "shell/browser/api/message_port.h"
 #include "shell/browser/electron_browser_context.h"
 #include "shell/browser/javascript_environment.h"
+#include "shell/common/gin_converters/blink_converter.h"
 #include "shell/common/gin_converters/gurl_converter.h"
 #include "shell/common/gin_converters/value_converter.h"
 #include "shell/common/gin_helper/dictionary.h"
 #include "shell/common/gin_helper/function_template_extensions.h"
+#include "shell/common/gin_helper/promise.h"
 #include "shell/common/node_includes.h"
+#include "shell/common/v8_value_serializer.h"
+#include "third_party/blink/public/common/messaging/transferable_message.h"
+#include "third_party/blink/public/common/service_worker/service_worker_status_code.h"
+#include "url/origin.h"
 
 namespace electron {
 
@@ -72,6 +81,13 @@ v8::Local<v8::Value> ServiceWorkerRunningInfoToDict(
 
 gin::WrapperInfo ServiceWorkerContext::kWrapperInfo = {gin::kEmbedderNativeGin};
 
+ServiceWorkerContext::PendingStop::PendingStop(
+    std::set<int64_t> version_ids,
+    gin_helper::Promise<void> promise)
+    : version_ids(std::move(version_ids)), promise(std::move(promise)) {}
+ServiceWorkerContext::PendingStop::PendingStop(PendingStop&&) = default;
+ServiceWorkerContext::PendingStop::~PendingStop() = default;
+
 ServiceWorkerContext::ServiceWorkerContext(
     v8::Isolate* isolate,
     ElectronBrowserContext* browser_context)
@@ -110,6 +126,18 @@ void ServiceWorkerContext::OnRegistrationCompleted(const GURL& scope) {
        gin::DataObjectBuilder(isolate).Set("scope", scope).Build());
 }
 
+void ServiceWorkerContext::OnVersionStoppedRunning(int64_t version_id) {
+  for (auto it = pending_stops_.begin(); it != pending_stops_.end();) {
+    it->version_ids.erase(version_id);
+    if (it->version_ids.empty()) {
+      gin_helper::Promise<void>::ResolvePromise(std::move(it->promise));
+      it = pending_stops_.erase(it);
+    } else {
+      ++it;
+    }
+  }
+}
+
 void ServiceWorkerContext::OnDestruct(content::ServiceWorkerContext* context) {
   if (context == service_worker_context_) {
     delete this;
@@ -143,6 +171,119 @@ v8::Local<v8::Value> ServiceWorkerContext::GetWorkerInfoFromID(
                                         std::move(iter->second));
 }
 
+v8::Local<v8::Promise> ServiceWorkerContext::PostMessageToScope(
+    v8::Isolate* isolate,
+    const GURL& scope,
+    v8::Local<v8::Value> message_value,
+    base::Optional<v8::Local<v8::Value>> transfer) {
+  gin_helper::Promise<void> promise(isolate);
+  v8::Local<v8::Promise> handle = promise.GetHandle();
+
+  blink::TransferableMessage transferable_message;
+  if (!electron::SerializeV8Value(isolate, message_value,
+                                  &transferable_message)) {
+    // SerializeV8Value sets an exception.
+    return handle;
+  }
+
+  std::vector<gin::Handle<MessagePort>> wrapped_ports;
+  if (transfer) {
+    if (!gin::ConvertFromV8(isolate, *transfer, &wrapped_ports)) {
+      isolate->ThrowException(v8::Exception::Error(
+          gin::StringToV8(isolate, "Invalid value for transfer")));
+      return handle;
+    }
+  }
+
+  bool threw_exception = false;
+  transferable_message.ports =
+      MessagePort::DisentanglePorts(isolate, wrapped_ports, &threw_exception);
+  if (threw_exception)
+    return handle;
+
+  service_worker_context_->StartServiceWorkerAndDispatchMessage(
+      scope, std::move(transferable_message),
+      base::BindOnce(
+          [](gin_helper::Promise<void> promise, bool success) {
+            if (success)
+              gin_helper::Promise<void>::ResolvePromise(std::move(promise));
+            else
+              gin_helper::Promise<void>::RejectPromise(
+                  std::move(promise),
+                  "Failed to dispatch message to service worker");
+          },
+          std::move(promise)));
+  return handle;
+}
+
+v8::Local<v8::Promise> ServiceWorkerContext::StartWorkerForScope(
+    v8::Isolate* isolate,
+    const GURL& scope) {
+  gin_helper::Promise<int64_t> promise(isolate);
+  v8::Local<v8::Promise> handle = promise.GetHandle();
+
+  // Only one of the two callbacks is run, so they share the promise.
+  auto shared_promise =
+      base::MakeRefCounted<base::RefCountedData<gin_helper::Promise<int64_t>>>(
+          std::move(promise));
+  service_worker_context_->StartWorkerForScope(
+      scope,
+      base::BindOnce(
+          [](scoped_refptr<
+                 base::RefCountedData<gin_helper::Promise<int64_t>>> promise,
+             int64_t version_id, int process_id, int thread_id) {
+            gin_helper::Promise<int64_t>::ResolvePromise(
+                std::move(promise->data), version_id);
+          },
+          shared_promise),
+      base::BindOnce(
+          [](scoped_refptr<
+                 base::RefCountedData<gin_helper::Promise<int64_t>>> promise,
+             blink::ServiceWorkerStatusCode status) {
+            gin_helper::Promise<int64_t>::RejectPromise(
+                std::move(promise->data),
+                std::string("Failed to start service worker: ") +
+                    blink::ServiceWorkerStatusToString(status));
+          },
+          shared_promise));
+  return handle;
+}
+
+v8::Local<v8::Promise> ServiceWorkerContext::StopRunningForOrigin(
+    v8::Isolate* isolate,
+    const GURL& origin) {
+  // Content does not report when the workers of an origin have stopped, so
+  // wait for each version of the origin that is running now to stop.
+  const url::Origin stopped_origin = url::Origin::Create(origin);
+  std::set<int64_t> version_ids;
+  for (const auto& iter :
+       service_worker_context_->GetRunningServiceWorkerInfos()) {
+    if (url::Origin::Create(iter.second.scope).IsSameOriginWith(stopped_origin))
+      version_ids.insert(iter.first);
+  }
+
+  service_worker_context_->StopAllServiceWorkersForOrigin(stopped_origin);
+  if (version_ids.empty())
+    return gin_helper::Promise<void>::ResolvedPromise(isolate);
+
+  gin_helper::Promise<void> promise(isolate);
+  v8::Local<v8::Promise> handle = promise.GetHandle();
+  pending_stops_.emplace_back(std::move(version_ids), std::move(promise));
+  return handle;
+}
+
+v8::Local<v8::Promise> ServiceWorkerContext::StopAllRunning(
+    v8::Isolate* isolate) {
+  gin_helper::Promise<void> promise(isolate);
+  v8::Local<v8::Promise> handle = promise.GetHandle();
+  service_worker_context_->StopAllServiceWorkers(base::BindOnce(
+      [](gin_helper::Promise<void> promise) {
+        gin_helper::Promise<void>::ResolvePromise(std::move(promise));
+      },
+      std::move(promise)));
+  return handle;
+}
+
 // static
 gin::Handle<ServiceWorkerContext> ServiceWorkerContext::Create(
     v8::Isolate* isolate,
@@ -159,7 +300,13 @@ gin::ObjectTemplateBuilder ServiceWorkerContext::GetObjectTemplateBuilder(
       .SetMethod("getAllRunning",
                  &ServiceWorkerContext::GetAllRunningWorkerInfo)
       .SetMethod("getFromVersionID",
-                 &ServiceWorkerContext::GetWorkerInfoFromID);
+                 &ServiceWorkerContext::GetWorkerInfoFromID)
+      .SetMethod("postMessage", &ServiceWorkerContext::PostMessageToScope)
+      .SetMethod("startWorkerForScope",
+                 &ServiceWorkerContext::StartWorkerForScope)
+      .SetMethod("stopRunningForOrigin",
+                 &ServiceWorkerContext::StopRunningForOrigin)
+      .SetMethod("stopAllRunning", &ServiceWorkerContext::StopAllRunning);
 }
 
 const char* ServiceWorkerContext::GetTypeName() {
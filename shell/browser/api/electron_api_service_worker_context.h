@@ -5,11 +5,16 @@
 #ifndef SHELL_BROWSER_API_ELECTRON_API_SERVICE_WORKER_CONTEXT_H_
 #define SHELL_BROWSER_API_ELECTRON_API_SERVICE_WORKER_CONTEXT_H_
 
+#include <list>
+#include <set>
+
+#include "base/optional.h"
 #include "content/public/browser/service_worker_context.h"
 #include "content/public/browser/service_worker_context_observer.h"
 #include "gin/handle.h"
 #include "gin/wrappable.h"
 #include "shell/browser/event_emitter_mixin.h"
+#include "shell/common/gin_helper/promise.h"
 
 namespace electron {
 
@@ -29,12 +34,23 @@ class ServiceWorkerContext
   v8::Local<v8::Value> GetAllRunningWorkerInfo(v8::Isolate* isolate);
   v8::Local<v8::Value> GetWorkerInfoFromID(gin_helper::ErrorThrower thrower,
                                            int64_t version_id);
+  v8::Local<v8::Promise> PostMessageToScope(
+      v8::Isolate* isolate,
+      const GURL& scope,
+      v8::Local<v8::Value> message_value,
+      base::Optional<v8::Local<v8::Value>> transfer);
+  v8::Local<v8::Promise> StartWorkerForScope(v8::Isolate* isolate,
+                                             const GURL& scope);
+  v8::Local<v8::Promise> StopRunningForOrigin(v8::Isolate* isolate,
+                                              const GURL& origin);
+  v8::Local<v8::Promise> StopAllRunning(v8::Isolate* isolate);
 
   // content::ServiceWorkerContextObserver
   void OnReportConsoleMessage(int64_t version_id,
                               const GURL& scope,
                               const content::ConsoleMessage& message) override;
   void OnRegistrationCompleted(const GURL& scope) override;
+  void OnVersionStoppedRunning(int64_t version_id) override;
   void OnDestruct(content::ServiceWorkerContext* context) override;
 
   // gin::Wrappable
@@ -53,6 +69,18 @@ class ServiceWorkerContext
 
   content::ServiceWorkerContext* service_worker_context_;
 
+  // Calls to stopRunningForOrigin() that wait for their versions to stop.
+  struct PendingStop {
+    PendingStop(std::set<int64_t> version_ids,
+                gin_helper::Promise<void> promise);
+    PendingStop(PendingStop&&);
+    ~PendingStop();
+
+    std::set<int64_t> version_ids;
+    gin_helper::Promise<void> promise;
+  };
+  std::list<PendingStop> pending_stops_;
+
   base::WeakPtrFactory<ServiceWorkerContext> weak_ptr_factory_{this};
 
   DISALLOW_COPY_AND_ASSIGN(ServiceWorkerContext);
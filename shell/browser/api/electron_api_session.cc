@@ -34,7 +34,9 @@
 #include "content/public/browser/download_manager_delegate.h"
 #include "content/public/browser/network_service_instance.h"
 #include "content/public/browser/storage_partition.h"
+#include "extensions/common/url_pattern.h"
 #include "gin/arguments.h"
+#include "gin/data_object_builder.h"
 #include "mojo/public/cpp/bindings/pending_remote.h"
 #include "mojo/public/cpp/bindings/self_owned_receiver.h"
 #include "net/base/completion_repeating_callback.h"
@@ -42,6 +44,7 @@
 #include "net/http/http_auth_handler_factory.h"
 #include "net/http/http_auth_preferences.h"
 #include "net/http/http_cache.h"
+#include "net/http/http_response_headers.h"
 #include "net/http/http_util.h"
 #include "services/network/network_service.h"
 #include "services/network/public/cpp/features.h"
@@ -60,6 +63,8 @@
 #include "shell/browser/javascript_environment.h"
 #include "shell/browser/media/media_device_id_salt.h"
 #include "shell/browser/net/cert_verifier_client.h"
+#include "shell/browser/net/http_cache_seeder.h"
+#include "shell/browser/net/traffic_shaper.h"
 #include "shell/browser/session_preferences.h"
 #include "shell/common/gin_converters/callback_converter.h"
 #include "shell/common/gin_converters/content_converter.h"
@@ -160,6 +165,20 @@ uint32_t GetQuotaMask(const std::vector<std::string>& quota_types) {
   return quota_mask;
 }
 
+network::mojom::NetworkConditionsPtr ParseNetworkConditions(
+    const gin_helper::Dictionary& options) {
+  auto conditions = network::mojom::NetworkConditions::New();
+
+  options.Get("offline", &conditions->offline);
+  options.Get("downloadThroughput", &conditions->download_throughput);
+  options.Get("uploadThroughput", &conditions->upload_throughput);
+  double latency = 0.0;
+  if (options.Get("latency", &latency) && latency) {
+    conditions->latency = base::TimeDelta::FromMillisecondsD(latency);
+  }
+  return conditions;
+}
+
 }  // namespace
 
 namespace gin {
@@ -182,6 +201,32 @@ struct Converter<ClearStorageDataOptions> {
   }
 };
 
+template <>
+struct Converter<net::RequestPriority> {
+  static bool FromV8(v8::Isolate* isolate,
+                     v8::Local<v8::Value> val,
+                     net::RequestPriority* out) {
+    std::string priority;
+    if (!ConvertFromV8(isolate, val, &priority))
+      return false;
+    if (priority == "throttled")
+      *out = net::THROTTLED;
+    else if (priority == "idle")
+      *out = net::IDLE;
+    else if (priority == "lowest")
+      *out = net::LOWEST;
+    else if (priority == "low")
+      *out = net::LOW;
+    else if (priority == "medium")
+      *out = net::MEDIUM;
+    else if (priority == "highest")
+      *out = net::HIGHEST;
+    else
+      return false;
+    return true;
+  }
+};
+
 bool SSLProtocolVersionFromString(const std::string& version_str,
                                   network::mojom::SSLVersion* version) {
   if (version_str == switches::kSSLVersionTLSv1) {
@@ -460,6 +505,73 @@ v8::Local<v8::Promise> Session::ClearCache() {
   return handle;
 }
 
+v8::Local<v8::Promise> Session::SeedHttpCache(gin::Arguments* args) {
+  std::vector<gin_helper::Dictionary> options;
+  if (!args->GetNext(&options)) {
+    args->ThrowTypeError("Must pass an array of cache entries");
+    return v8::Local<v8::Promise>();
+  }
+
+  std::vector<HttpCacheSeeder::Entry> entries;
+  for (const auto& option : options) {
+    HttpCacheSeeder::Entry entry;
+    option.Get("url", &entry.url);
+    option.Get("path", &entry.path);
+    GURL top_frame_url;
+    if (option.Get("topFrameOrigin", &top_frame_url))
+      entry.top_frame_origin = url::Origin::Create(top_frame_url);
+    entry.headers =
+        base::MakeRefCounted<net::HttpResponseHeaders>("HTTP/1.1 200 OK");
+    std::map<std::string, std::string> headers;
+    if (option.Get("headers", &headers)) {
+      for (const auto& header : headers) {
+        if (!net::HttpUtil::IsValidHeaderName(header.first) ||
+            !net::HttpUtil::IsValidHeaderValue(header.second)) {
+          args->ThrowTypeError("Invalid header " + header.first);
+          return v8::Local<v8::Promise>();
+        }
+        entry.headers->AddHeader(header.first, header.second);
+      }
+    }
+    std::map<std::string, std::string> request_headers;
+    if (option.Get("requestHeaders", &request_headers)) {
+      for (const auto& header : request_headers) {
+        if (!net::HttpUtil::IsValidHeaderName(header.first) ||
+            !net::HttpUtil::IsValidHeaderValue(header.second)) {
+          args->ThrowTypeError("Invalid request header " + header.first);
+          return v8::Local<v8::Promise>();
+        }
+        entry.request_headers.SetHeader(header.first, header.second);
+      }
+    }
+
+    std::string error;
+    if (!HttpCacheSeeder::ValidateEntry(entry, &error)) {
+      args->ThrowTypeError(error);
+      return v8::Local<v8::Promise>();
+    }
+    entries.push_back(std::move(entry));
+  }
+
+  gin_helper::Promise<void> promise(isolate_);
+  v8::Local<v8::Promise> handle = promise.GetHandle();
+  HttpCacheSeeder::Start(
+      browser_context_, std::move(entries),
+      base::BindOnce(
+          [](gin_helper::Promise<void> promise, int net_error,
+             const GURL& failed_url) {
+            if (net_error == net::OK) {
+              promise.Resolve();
+            } else {
+              promise.RejectWithErrorMessage(
+                  "Failed to import " + failed_url.spec() + ": " +
+                  net::ErrorToString(net_error));
+            }
+          },
+          std::move(promise)));
+  return handle;
+}
+
 v8::Local<v8::Promise> Session::ClearStorageData(gin::Arguments* args) {
   v8::Isolate* isolate = args->isolate();
   gin_helper::Promise<void> promise(isolate);
@@ -573,21 +685,13 @@ void Session::SetDownloadPath(const base::FilePath& path) {
 }
 
 void Session::EnableNetworkEmulation(const gin_helper::Dictionary& options) {
-  auto conditions = network::mojom::NetworkConditions::New();
-
-  options.Get("offline", &conditions->offline);
-  options.Get("downloadThroughput", &conditions->download_throughput);
-  options.Get("uploadThroughput", &conditions->upload_throughput);
-  double latency = 0.0;
-  if (options.Get("latency", &latency) && latency) {
-    conditions->latency = base::TimeDelta::FromMillisecondsD(latency);
-  }
-
   auto* network_context =
       content::BrowserContext::GetDefaultStoragePartition(browser_context_)
           ->GetNetworkContext();
   network_context->SetNetworkConditions(network_emulation_token_,
-                                        std::move(conditions));
+                                        ParseNetworkConditions(options));
+  TrafficShaper::FromBrowserContext(browser_context_)
+      ->set_default_throttling_profile_id(network_emulation_token_);
 }
 
 void Session::DisableNetworkEmulation() {
@@ -596,6 +700,96 @@ void Session::DisableNetworkEmulation() {
           ->GetNetworkContext();
   network_context->SetNetworkConditions(
       network_emulation_token_, network::mojom::NetworkConditions::New());
+  TrafficShaper::FromBrowserContext(browser_context_)
+      ->set_default_throttling_profile_id(base::nullopt);
+}
+
+void Session::SetTrafficClasses(
+    gin_helper::ErrorThrower thrower,
+    const std::vector<gin_helper::Dictionary>& options) {
+  std::vector<TrafficShaper::TrafficClass> classes;
+  for (const auto& option : options) {
+    TrafficShaper::TrafficClass traffic_class;
+    if (!option.Get("name", &traffic_class.name) ||
+        traffic_class.name.empty()) {
+      thrower.ThrowError("Each traffic class must have a name");
+      return;
+    }
+
+    std::vector<std::string> urls;
+    option.Get("urls", &urls);
+    for (const auto& url : urls) {
+      URLPattern pattern(URLPattern::SCHEME_ALL);
+      const URLPattern::ParseResult result = pattern.Parse(url);
+      if (result != URLPattern::ParseResult::kSuccess) {
+        thrower.ThrowError("Invalid url pattern " + url + ": " +
+                           URLPattern::GetParseResultString(result));
+        return;
+      }
+      traffic_class.url_patterns.insert(pattern);
+    }
+
+    std::vector<std::string> resource_types;
+    option.Get("resourceTypes", &resource_types);
+    traffic_class.resource_types.insert(resource_types.begin(),
+                                        resource_types.end());
+
+    if (option.Has("priority")) {
+      net::RequestPriority priority;
+      if (!option.Get("priority", &priority)) {
+        thrower.ThrowError("Invalid priority for traffic class " +
+                           traffic_class.name);
+        return;
+      }
+      traffic_class.priority = priority;
+    }
+
+    if (option.Has("offline") || option.Has("latency") ||
+        option.Has("downloadThroughput") || option.Has("uploadThroughput")) {
+      traffic_class.throttling_profile_id = base::UnguessableToken::Create();
+    }
+
+    classes.push_back(std::move(traffic_class));
+  }
+
+  auto* network_context =
+      content::BrowserContext::GetDefaultStoragePartition(browser_context_)
+          ->GetNetworkContext();
+  auto* traffic_shaper = TrafficShaper::FromBrowserContext(browser_context_);
+
+  // Drop the throttling profiles of the classes being replaced.
+  for (const auto& traffic_class : traffic_shaper->traffic_classes()) {
+    if (traffic_class.throttling_profile_id) {
+      network_context->SetNetworkConditions(
+          *traffic_class.throttling_profile_id,
+          network::mojom::NetworkConditions::New());
+    }
+  }
+
+  for (size_t i = 0; i < classes.size(); ++i) {
+    if (classes[i].throttling_profile_id) {
+      network_context->SetNetworkConditions(*classes[i].throttling_profile_id,
+                                            ParseNetworkConditions(options[i]));
+    }
+  }
+
+  traffic_shaper->SetTrafficClasses(std::move(classes));
+}
+
+v8::Local<v8::Value> Session::GetTrafficClassStats(v8::Isolate* isolate) {
+  gin::DataObjectBuilder builder(isolate);
+  for (const auto& it :
+       TrafficShaper::FromBrowserContext(browser_context_)->stats()) {
+    builder.Set(it.first,
+                gin::DataObjectBuilder(isolate)
+                    .Set("requestCount",
+                         static_cast<double>(it.second.request_count))
+                    .Set("bytesSent", static_cast<double>(it.second.bytes_sent))
+                    .Set("bytesReceived",
+                         static_cast<double>(it.second.bytes_received))
+                    .Build());
+  }
+  return builder.Build();
 }
 
 void Session::SetCertVerifyProc(v8::Local<v8::Value> val,
@@ -1143,6 +1337,7 @@ gin::ObjectTemplateBuilder Session::GetObjectTemplateBuilder(
       .SetMethod("resolveProxy", &Session::ResolveProxy)
       .SetMethod("getCacheSize", &Session::GetCacheSize)
       .SetMethod("clearCache", &Session::ClearCache)
+      .SetMethod("seedHttpCache", &Session::SeedHttpCache)
       .SetMethod("clearStorageData", &Session::ClearStorageData)
       .SetMethod("flushStorageData", &Session::FlushStorageData)
       .SetMethod("setProxy", &Session::SetProxy)
@@ -1150,6 +1345,8 @@ gin::ObjectTemplateBuilder Session::GetObjectTemplateBuilder(
       .SetMethod("setDownloadPath", &Session::SetDownloadPath)
       .SetMethod("enableNetworkEmulation", &Session::EnableNetworkEmulation)
       .SetMethod("disableNetworkEmulation", &Session::DisableNetworkEmulation)
+      .SetMethod("setTrafficClasses", &Session::SetTrafficClasses)
+      .SetMethod("getTrafficClassStats", &Session::GetTrafficClassStats)
       .SetMethod("setCertificateVerifyProc", &Session::SetCertVerifyProc)
       .SetMethod("setPermissionRequestHandler",
                  &Session::SetPermissionRequestHandler)
@@ -92,6 +92,7 @@ class Session : public gin::Wrappable<Session>,
   v8::Local<v8::Promise> ResolveProxy(gin::Arguments* args);
   v8::Local<v8::Promise> GetCacheSize();
   v8::Local<v8::Promise> ClearCache();
+  v8::Local<v8::Promise> SeedHttpCache(gin::Arguments* args);
   v8::Local<v8::Promise> ClearStorageData(gin::Arguments* args);
   void FlushStorageData();
   v8::Local<v8::Promise> SetProxy(gin::Arguments* args);
@@ -99,6 +100,9 @@ class Session : public gin::Wrappable<Session>,
   void SetDownloadPath(const base::FilePath& path);
   void EnableNetworkEmulation(const gin_helper::Dictionary& options);
   void DisableNetworkEmulation();
+  void SetTrafficClasses(gin_helper::ErrorThrower thrower,
+                         const std::vector<gin_helper::Dictionary>& options);
+  v8::Local<v8::Value> GetTrafficClassStats(v8::Isolate* isolate);
   void SetCertVerifyProc(v8::Local<v8::Value> proc, gin::Arguments* args);
   void SetPermissionRequestHandler(v8::Local<v8::Value> val,
                                    gin::Arguments* args);
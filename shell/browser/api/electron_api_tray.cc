@@ -5,6 +5,7 @@
 #include "shell/browser/api/electron_api_tray.h"
 
 #include <string>
+#include <utility>
 
 #include "base/threading/thread_task_runner_handle.h"
 #include "gin/dictionary.h"
@@ -23,6 +24,10 @@
 #include "shell/common/node_includes.h"
 #include "ui/gfx/image/image.h"
 
+#if defined(OS_LINUX)
+#include "shell/browser/linux/headless_util.h"
+#endif
+
 namespace gin {
 
 template <>
@@ -82,6 +87,13 @@ gin::Handle<Tray> Tray::New(gin_helper::ErrorThrower thrower,
     return gin::Handle<Tray>();
   }
 
+#if defined(OS_LINUX)
+  if (IsHeadlessOzonePlatform()) {
+    thrower.ThrowError("Cannot create Tray in headless mode");
+    return gin::Handle<Tray>();
+  }
+#endif
+
 #if defined(OS_WIN)
   if (!guid.has_value() && args->Length() > 1) {
     thrower.ThrowError("Invalid GUID format");
@@ -180,6 +192,7 @@ void Tray::OnDragEnded() {
 }
 
 void Tray::Destroy() {
+  StopAnimation();
   menu_.Reset();
   tray_icon_.reset();
 }
@@ -191,6 +204,7 @@ bool Tray::IsDestroyed() {
 void Tray::SetImage(v8::Isolate* isolate, v8::Local<v8::Value> image) {
   if (!CheckAlive())
     return;
+  StopAnimation();
 
   NativeImage* native_image = nullptr;
   if (!NativeImage::TryConvertNativeImage(isolate, image, &native_image))
@@ -219,6 +233,78 @@ void Tray::SetPressedImage(v8::Isolate* isolate, v8::Local<v8::Value> image) {
 #endif
 }
 
+void Tray::SetAnimatedImage(
+    gin_helper::ErrorThrower thrower,
+    const std::vector<v8::Local<v8::Value>>& images,
+    const base::Optional<gin_helper::Dictionary>& options) {
+  if (!CheckAlive())
+    return;
+  if (images.empty()) {
+    thrower.ThrowError("images must not be empty");
+    return;
+  }
+
+  int interval = 100;
+  if (options && options->Get("interval", &interval) && interval < 16) {
+    thrower.ThrowError("interval must be at least 16 milliseconds");
+    return;
+  }
+
+  decltype(animation_frames_) frames;
+  for (auto image : images) {
+    NativeImage* native_image = nullptr;
+    if (!NativeImage::TryConvertNativeImage(thrower.isolate(), image,
+                                            &native_image))
+      return;
+#if defined(OS_WIN)
+    frames.emplace_back(
+        CopyIcon(native_image->GetHICON(GetSystemMetrics(SM_CXSMICON))));
+#else
+    frames.push_back(native_image->image());
+#endif
+  }
+
+  animation_frames_ = std::move(frames);
+  animation_frame_index_ = 0;
+  ShowNextAnimationFrame();
+  if (animation_frames_.size() > 1) {
+    animation_timer_.Start(FROM_HERE,
+                           base::TimeDelta::FromMilliseconds(interval),
+                           base::BindRepeating(&Tray::ShowNextAnimationFrame,
+                                               base::Unretained(this)));
+  }
+}
+
+void Tray::StopAnimation() {
+  animation_timer_.Stop();
+  animation_frames_.clear();
+}
+
+bool Tray::IsAnimating() const {
+  return animation_timer_.IsRunning();
+}
+
+void Tray::ShowNextAnimationFrame() {
+  if (!tray_icon_ || animation_frames_.empty())
+    return;
+  const auto& frame = animation_frames_[animation_frame_index_];
+  animation_frame_index_ =
+      (animation_frame_index_ + 1) % animation_frames_.size();
+#if defined(OS_WIN)
+  tray_icon_->SetImage(frame.get());
+#else
+  tray_icon_->SetImage(frame);
+#endif
+}
+
+void Tray::SetBadgeCount(int count) {
+  if (!CheckAlive())
+    return;
+#if defined(OS_LINUX)
+  tray_icon_->SetBadgeCount(count);
+#endif
+}
+
 void Tray::SetToolTip(const std::string& tool_tip) {
   if (!CheckAlive())
     return;
@@ -403,6 +489,10 @@ v8::Local<v8::ObjectTemplate> Tray::FillObjectTemplate(
       .SetMethod("isDestroyed", &Tray::IsDestroyed)
       .SetMethod("setImage", &Tray::SetImage)
       .SetMethod("setPressedImage", &Tray::SetPressedImage)
+      .SetMethod("setAnimatedImage", &Tray::SetAnimatedImage)
+      .SetMethod("stopAnimation", &Tray::StopAnimation)
+      .SetMethod("isAnimating", &Tray::IsAnimating)
+      .SetMethod("setBadgeCount", &Tray::SetBadgeCount)
       .SetMethod("setToolTip", &Tray::SetToolTip)
       .SetMethod("setTitle", &Tray::SetTitle)
       .SetMethod("getTitle", &Tray::GetTitle)
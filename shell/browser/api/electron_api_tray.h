@@ -9,6 +9,7 @@
 #include <string>
 #include <vector>
 
+#include "base/timer/timer.h"
 #include "gin/handle.h"
 #include "gin/wrappable.h"
 #include "shell/browser/event_emitter_mixin.h"
@@ -20,9 +21,11 @@
 #include "shell/common/gin_helper/constructible.h"
 #include "shell/common/gin_helper/error_thrower.h"
 
-namespace gfx {
-class Image;
-}
+#if defined(OS_WIN)
+#include "base/win/scoped_gdi_object.h"
+#else
+#include "ui/gfx/image/image.h"
+#endif
 
 namespace gin_helper {
 class Dictionary;
@@ -85,6 +88,12 @@ class Tray : public gin::Wrappable<Tray>,
   bool IsDestroyed();
   void SetImage(v8::Isolate* isolate, v8::Local<v8::Value> image);
   void SetPressedImage(v8::Isolate* isolate, v8::Local<v8::Value> image);
+  void SetAnimatedImage(gin_helper::ErrorThrower thrower,
+                        const std::vector<v8::Local<v8::Value>>& images,
+                        const base::Optional<gin_helper::Dictionary>& options);
+  void StopAnimation();
+  bool IsAnimating() const;
+  void SetBadgeCount(int count);
   void SetToolTip(const std::string& tool_tip);
   void SetTitle(const std::string& title,
                 const base::Optional<gin_helper::Dictionary>& options,
@@ -103,10 +112,21 @@ class Tray : public gin::Wrappable<Tray>,
   gfx::Rect GetBounds();
 
   bool CheckAlive();
+  void ShowNextAnimationFrame();
 
   v8::Global<v8::Value> menu_;
   std::unique_ptr<TrayIcon> tray_icon_;
 
+  // The frames of the animated image are converted once and then handed to
+  // the tray icon in turn.
+#if defined(OS_WIN)
+  std::vector<base::win::ScopedHICON> animation_frames_;
+#else
+  std::vector<gfx::Image> animation_frames_;
+#endif
+  size_t animation_frame_index_ = 0;
+  base::RepeatingTimer animation_timer_;
+
   DISALLOW_COPY_AND_ASSIGN(Tray);
 };
 
@@ -5,6 +5,7 @@
 #include "shell/browser/api/electron_api_url_loader.h"
 
 #include <algorithm>
+#include <limits>
 #include <map>
 #include <memory>
 #include <string>
@@ -12,21 +13,26 @@
 #include <vector>
 
 #include "base/containers/id_map.h"
+#include "base/containers/queue.h"
 #include "base/no_destructor.h"
 #include "gin/handle.h"
 #include "gin/object_template_builder.h"
 #include "gin/wrappable.h"
+#include "mojo/public/cpp/bindings/receiver_set.h"
 #include "mojo/public/cpp/bindings/remote.h"
 #include "mojo/public/cpp/system/data_pipe_producer.h"
 #include "net/base/load_flags.h"
 #include "services/network/public/cpp/resource_request.h"
 #include "services/network/public/cpp/simple_url_loader.h"
 #include "services/network/public/mojom/chunked_data_pipe_getter.mojom.h"
+#include "services/network/public/mojom/data_pipe_getter.mojom.h"
 #include "services/network/public/mojom/url_loader_factory.mojom.h"
+#include "shell/browser/api/electron_api_data_pipe_holder.h"
 #include "shell/browser/api/electron_api_session.h"
 #include "shell/browser/electron_browser_context.h"
 #include "shell/browser/javascript_environment.h"
 #include "shell/common/gin_converters/callback_converter.h"
+#include "shell/common/gin_converters/file_path_converter.h"
 #include "shell/common/gin_converters/gurl_converter.h"
 #include "shell/common/gin_converters/net_converter.h"
 #include "shell/common/gin_helper/dictionary.h"
@@ -76,35 +82,128 @@ namespace api {
 
 namespace {
 
-class BufferDataSource : public mojo::DataPipeProducer::DataSource {
+// A region of a JS ArrayBuffer. Holding the backing store keeps the memory
+// alive after the JS object is collected, so the bytes can be read off the
+// JS thread without copying them first.
+struct PinnedBuffer {
+  explicit PinnedBuffer(v8::Local<v8::ArrayBufferView> view)
+      : backing_store(view->Buffer()->GetBackingStore()),
+        offset(view->ByteOffset()),
+        length(view->ByteLength()) {}
+
+  const char* data() const {
+    return static_cast<const char*>(backing_store->Data()) + offset;
+  }
+
+  std::shared_ptr<v8::BackingStore> backing_store;
+  size_t offset;
+  size_t length;
+};
+
+// Reads a list of pinned buffers as if they were one contiguous buffer.
+class BufferListDataSource : public mojo::DataPipeProducer::DataSource {
  public:
-  explicit BufferDataSource(base::span<char> buffer) {
-    buffer_.resize(buffer.size());
-    memcpy(buffer_.data(), buffer.data(), buffer_.size());
+  explicit BufferListDataSource(std::vector<PinnedBuffer> buffers)
+      : buffers_(std::move(buffers)) {
+    ends_.reserve(buffers_.size());
+    uint64_t end = 0;
+    for (const auto& buffer : buffers_) {
+      end += buffer.length;
+      ends_.push_back(end);
+    }
   }
-  ~BufferDataSource() override = default;
+  ~BufferListDataSource() override = default;
 
  private:
   // mojo::DataPipeProducer::DataSource:
-  uint64_t GetLength() const override { return buffer_.size(); }
+  uint64_t GetLength() const override {
+    return ends_.empty() ? 0 : ends_.back();
+  }
   ReadResult Read(uint64_t offset, base::span<char> buffer) override {
     ReadResult result;
-    if (offset <= buffer_.size()) {
-      size_t readable_size = buffer_.size() - offset;
-      size_t writable_size = buffer.size();
-      size_t copyable_size = std::min(readable_size, writable_size);
-      if (copyable_size > 0) {
-        memcpy(buffer.data(), &buffer_[offset], copyable_size);
-      }
-      result.bytes_read = copyable_size;
-    } else {
+    if (offset > GetLength()) {
       NOTREACHED();
       result.result = MOJO_RESULT_OUT_OF_RANGE;
+      return result;
     }
+    // Find the first buffer that ends after |offset|.
+    size_t index =
+        std::upper_bound(ends_.begin(), ends_.end(), offset) - ends_.begin();
+    size_t written = 0;
+    while (index < buffers_.size() && written < buffer.size()) {
+      const PinnedBuffer& source = buffers_[index];
+      uint64_t start = ends_[index] - source.length;
+      size_t source_offset = offset + written - start;
+      size_t copyable_size =
+          std::min(source.length - source_offset, buffer.size() - written);
+      if (copyable_size > 0) {
+        memcpy(buffer.data() + written, source.data() + source_offset,
+               copyable_size);
+      }
+      written += copyable_size;
+      ++index;
+    }
+    result.bytes_read = written;
     return result;
   }
 
-  std::vector<char> buffer_;
+  std::vector<PinnedBuffer> buffers_;
+  // Offset one past the last byte of each buffer in |buffers_|.
+  std::vector<uint64_t> ends_;
+};
+
+// Serves a buffered request body to the network service straight out of the
+// ArrayBuffers written from JS. The body can be read more than once, e.g.
+// when a 307 redirect requires it to be re-sent. Deletes itself once every
+// remote has disconnected.
+class BufferListDataPipeGetter : public network::mojom::DataPipeGetter {
+ public:
+  static void Create(
+      std::vector<PinnedBuffer> buffers,
+      mojo::PendingReceiver<network::mojom::DataPipeGetter> receiver) {
+    new BufferListDataPipeGetter(std::move(buffers), std::move(receiver));
+  }
+
+ private:
+  BufferListDataPipeGetter(
+      std::vector<PinnedBuffer> buffers,
+      mojo::PendingReceiver<network::mojom::DataPipeGetter> receiver)
+      : buffers_(std::move(buffers)) {
+    for (const auto& buffer : buffers_)
+      size_ += buffer.length;
+    receivers_.Add(this, std::move(receiver));
+    receivers_.set_disconnect_handler(
+        base::BindRepeating(&BufferListDataPipeGetter::OnDisconnect,
+                            base::Unretained(this)));
+  }
+  ~BufferListDataPipeGetter() override = default;
+
+  // network::mojom::DataPipeGetter:
+  void Read(mojo::ScopedDataPipeProducerHandle pipe,
+            ReadCallback callback) override {
+    std::move(callback).Run(net::OK, size_);
+    auto producer = std::make_unique<mojo::DataPipeProducer>(std::move(pipe));
+    auto* raw_producer = producer.get();
+    raw_producer->Write(
+        std::make_unique<BufferListDataSource>(buffers_),
+        base::BindOnce([](std::unique_ptr<mojo::DataPipeProducer> producer,
+                          MojoResult result) {},
+                       std::move(producer)));
+  }
+
+  void Clone(
+      mojo::PendingReceiver<network::mojom::DataPipeGetter> receiver) override {
+    receivers_.Add(this, std::move(receiver));
+  }
+
+  void OnDisconnect() {
+    if (receivers_.empty())
+      delete this;
+  }
+
+  std::vector<PinnedBuffer> buffers_;
+  uint64_t size_ = 0;
+  mojo::ReceiverSet<network::mojom::DataPipeGetter> receivers_;
 };
 
 class JSChunkedDataPipeGetter : public gin::Wrappable<JSChunkedDataPipeGetter>,
@@ -170,6 +269,10 @@ class JSChunkedDataPipeGetter : public gin::Wrappable<JSChunkedDataPipeGetter>,
                        node::arraysize(argv), argv, {0, 0});
   }
 
+  // Queues a chunk to be written to the data pipe. Several writes may be
+  // pending at once; they are written in order, directly from the chunk's
+  // ArrayBuffer, and each promise resolves once its chunk is in the pipe.
+  // Bounding the amount of data in flight is up to the caller.
   v8::Local<v8::Promise> WriteChunk(v8::Local<v8::Value> buffer_val) {
     gin_helper::Promise<void> promise(isolate_);
     v8::Local<v8::Promise> handle = promise.GetHandle();
@@ -177,37 +280,44 @@ class JSChunkedDataPipeGetter : public gin::Wrappable<JSChunkedDataPipeGetter>,
       promise.RejectWithErrorMessage("Expected an ArrayBufferView");
       return handle;
     }
-    if (is_writing_) {
-      promise.RejectWithErrorMessage("Only one write can be pending at a time");
-      return handle;
-    }
-    if (!size_callback_) {
+    if (!size_callback_ || !data_producer_) {
       promise.RejectWithErrorMessage("Can't write after calling done()");
       return handle;
     }
     auto buffer = buffer_val.As<v8::ArrayBufferView>();
-    is_writing_ = true;
     bytes_written_ += buffer->ByteLength();
-    auto backing_store = buffer->Buffer()->GetBackingStore();
-    auto buffer_span = base::make_span(
-        static_cast<char*>(backing_store->Data()) + buffer->ByteOffset(),
-        buffer->ByteLength());
-    auto buffer_source = std::make_unique<BufferDataSource>(buffer_span);
+    pending_writes_.push(
+        PendingWrite{PinnedBuffer(buffer), std::move(promise)});
+    if (!is_writing_)
+      WriteNextChunk();
+    return handle;
+  }
+
+  void WriteNextChunk() {
+    DCHECK(!is_writing_);
+    if (pending_writes_.empty()) {
+      if (is_done_)
+        Finished();
+      return;
+    }
+    is_writing_ = true;
+    std::vector<PinnedBuffer> buffers{pending_writes_.front().buffer};
     data_producer_->Write(
-        std::move(buffer_source),
+        std::make_unique<BufferListDataSource>(std::move(buffers)),
         base::BindOnce(&JSChunkedDataPipeGetter::OnWriteChunkComplete,
                        // We're OK to use Unretained here because we own
                        // |data_producer_|.
-                       base::Unretained(this), std::move(promise)));
-    return handle;
+                       base::Unretained(this)));
   }
 
-  void OnWriteChunkComplete(gin_helper::Promise<void> promise,
-                            MojoResult result) {
+  void OnWriteChunkComplete(MojoResult result) {
     DCHECK_CURRENTLY_ON(content::BrowserThread::UI);
     is_writing_ = false;
+    auto promise = std::move(pending_writes_.front().promise);
+    pending_writes_.pop();
     if (result == MOJO_RESULT_OK) {
       promise.Resolve();
+      WriteNextChunk();
     } else {
       promise.RejectWithErrorMessage("mojo result not ok");
       Finished();
@@ -219,7 +329,12 @@ class JSChunkedDataPipeGetter : public gin::Wrappable<JSChunkedDataPipeGetter>,
   void Done() {
     if (size_callback_) {
       std::move(size_callback_).Run(net::OK, bytes_written_);
-      Finished();
+      // Chunks that are still queued must make it into the pipe before it
+      // is closed.
+      if (is_writing_)
+        is_done_ = true;
+      else
+        Finished();
     }
   }
 
@@ -228,12 +343,25 @@ class JSChunkedDataPipeGetter : public gin::Wrappable<JSChunkedDataPipeGetter>,
     data_producer_.reset();
     receiver_.reset();
     size_callback_.Reset();
+    is_writing_ = false;
+    while (!pending_writes_.empty()) {
+      pending_writes_.front().promise.RejectWithErrorMessage(
+          "The request body was closed");
+      pending_writes_.pop();
+    }
   }
 
+  struct PendingWrite {
+    PinnedBuffer buffer;
+    gin_helper::Promise<void> promise;
+  };
+
   GetSizeCallback size_callback_;
   mojo::Receiver<network::mojom::ChunkedDataPipeGetter> receiver_{this};
   std::unique_ptr<mojo::DataPipeProducer> data_producer_;
+  base::queue<PendingWrite> pending_writes_;
   bool is_writing_ = false;
+  bool is_done_ = false;
   uint64_t bytes_written_ = 0;
 
   v8::Isolate* isolate_;
@@ -243,6 +371,74 @@ class JSChunkedDataPipeGetter : public gin::Wrappable<JSChunkedDataPipeGetter>,
 gin::WrapperInfo JSChunkedDataPipeGetter::kWrapperInfo = {
     gin::kEmbedderNativeGin};
 
+void AppendBufferList(std::vector<PinnedBuffer> buffers,
+                      network::ResourceRequestBody* request_body) {
+  mojo::PendingRemote<network::mojom::DataPipeGetter> data_pipe_getter;
+  BufferListDataPipeGetter::Create(
+      std::move(buffers), data_pipe_getter.InitWithNewPipeAndPassReceiver());
+  request_body->AppendDataPipe(std::move(data_pipe_getter));
+}
+
+// Converts the body list built by ClientRequest into request body elements.
+// Each entry is either an ArrayBufferView or an upload element object:
+//   { type: 'file', filePath, offset?, length? }
+//   { type: 'blob', blobUUID }
+// Runs of consecutive buffers are not concatenated; they become a single data
+// pipe element that streams each buffer directly from its ArrayBuffer. Files
+// and blobs are read by the network service without going through JS.
+bool AppendBodyElements(v8::Isolate* isolate,
+                        v8::Local<v8::Array> elements,
+                        network::ResourceRequestBody* request_body) {
+  auto context = isolate->GetCurrentContext();
+  std::vector<PinnedBuffer> buffers;
+  for (uint32_t i = 0; i < elements->Length(); ++i) {
+    v8::Local<v8::Value> element;
+    if (!elements->Get(context, i).ToLocal(&element))
+      return false;
+    if (element->IsArrayBufferView()) {
+      if (element.As<v8::ArrayBufferView>()->ByteLength() > 0)
+        buffers.emplace_back(element.As<v8::ArrayBufferView>());
+      continue;
+    }
+
+    gin_helper::Dictionary dict;
+    std::string type;
+    if (!gin::ConvertFromV8(isolate, element, &dict) ||
+        !dict.Get("type", &type))
+      return false;
+    if (!buffers.empty())
+      AppendBufferList(std::move(buffers), request_body);
+    buffers.clear();
+
+    if (type == "file") {
+      base::FilePath file_path;
+      if (!dict.Get("filePath", &file_path))
+        return false;
+      uint64_t offset = 0;
+      uint64_t length = std::numeric_limits<uint64_t>::max();
+      dict.Get("offset", &offset);
+      dict.Get("length", &length);
+      request_body->AppendFileRange(file_path, offset, length, base::Time());
+    } else if (type == "blob") {
+      std::string uuid;
+      if (!dict.Get("blobUUID", &uuid))
+        return false;
+      gin::Handle<DataPipeHolder> holder = DataPipeHolder::From(isolate, uuid);
+      if (holder.IsEmpty())
+        return false;
+      auto data_pipe_getter = holder->CloneDataPipeGetter();
+      if (!data_pipe_getter)
+        return false;
+      request_body->AppendDataPipe(std::move(data_pipe_getter));
+    } else {
+      return false;
+    }
+  }
+  if (!buffers.empty())
+    AppendBufferList(std::move(buffers), request_body);
+  return true;
+}
+
 const net::NetworkTrafficAnnotationTag kTrafficAnnotation =
     net::DefineNetworkTrafficAnnotation("electron_net_module", R"(
         semantics {
@@ -484,6 +680,15 @@ gin::Handle<SimpleURLLoaderWrapper> SimpleURLLoaderWrapper::Create(
       request->request_body = network::ResourceRequestBody::CreateFromBytes(
           static_cast<char*>(backing_store->Data()) + buffer_body->ByteOffset(),
           buffer_body->ByteLength());
+    } else if (body->IsArray()) {
+      // A list of chunks and upload elements buffered by ClientRequest.
+      request->request_body =
+          base::MakeRefCounted<network::ResourceRequestBody>();
+      if (!AppendBodyElements(args->isolate(), body.As<v8::Array>(),
+                              request->request_body.get())) {
+        args->ThrowTypeError("Invalid request body");
+        return gin::Handle<SimpleURLLoaderWrapper>();
+      }
     } else if (body->IsFunction()) {
       auto body_func = body.As<v8::Function>();
 
@@ -17,6 +17,7 @@
 #include "base/json/json_reader.h"
 #include "base/no_destructor.h"
 #include "base/optional.h"
+#include "base/strings/string_number_conversions.h"
 #include "base/strings/utf_string_conversions.h"
 #include "base/task/current_thread.h"
 #include "base/task/post_task.h"
@@ -60,6 +61,7 @@
 #include "content/public/browser/storage_partition.h"
 #include "content/public/browser/web_contents.h"
 #include "content/public/common/referrer_type_converters.h"
+#include "content/public/common/result_codes.h"
 #include "content/public/common/webplugininfo.h"
 #include "electron/buildflags/buildflags.h"
 #include "electron/shell/common/api/api.mojom.h"
@@ -79,6 +81,7 @@
 #include "shell/browser/api/electron_api_debugger.h"
 #include "shell/browser/api/electron_api_session.h"
 #include "shell/browser/api/electron_api_web_frame_main.h"
+#include "shell/browser/api/frame_tree_observer.h"
 #include "shell/browser/api/message_port.h"
 #include "shell/browser/browser.h"
 #include "shell/browser/child_web_contents_tracker.h"
@@ -385,6 +388,22 @@ void OnCapturePageDone(gin_helper::Promise<gfx::Image> promise,
   promise.Resolve(gfx::Image::CreateFrom1xBitmap(bitmap));
 }
 
+void OnRecordingStopped(gin_helper::Promise<gin_helper::Dictionary> promise,
+                        bool success,
+                        const WebContentsRecorder::Stats& stats) {
+  if (!success) {
+    promise.RejectWithErrorMessage("Failed to write the recording");
+    return;
+  }
+  v8::HandleScope handle_scope(promise.isolate());
+  gin_helper::Dictionary dict =
+      gin::Dictionary::CreateEmpty(promise.isolate());
+  dict.Set("framesCaptured", stats.frames_captured);
+  dict.Set("framesEncoded", stats.frames_encoded);
+  dict.Set("framesDropped", stats.frames_dropped);
+  promise.Resolve(dict);
+}
+
 base::Optional<base::TimeDelta> GetCursorBlinkInterval() {
 #if defined(OS_MAC)
   base::TimeDelta interval;
@@ -588,6 +607,31 @@ bool IsDevToolsFileSystemAdded(content::WebContents* web_contents,
   return file_system_paths.find(file_system_path) != file_system_paths.end();
 }
 
+// Converts a JS input event object into the blink event of the matching type,
+// returns nullptr if the object is not a valid input event.
+std::unique_ptr<blink::WebInputEvent> ConvertInputEvent(
+    v8::Isolate* isolate,
+    v8::Local<v8::Value> input_event) {
+  blink::WebInputEvent::Type type =
+      gin::GetWebInputEventType(isolate, input_event);
+  if (blink::WebInputEvent::IsMouseEventType(type)) {
+    auto mouse_event = std::make_unique<blink::WebMouseEvent>();
+    if (gin::ConvertFromV8(isolate, input_event, mouse_event.get()))
+      return mouse_event;
+  } else if (blink::WebInputEvent::IsKeyboardEventType(type)) {
+    auto keyboard_event = std::make_unique<content::NativeWebKeyboardEvent>(
+        blink::WebKeyboardEvent::Type::kRawKeyDown,
+        blink::WebInputEvent::Modifiers::kNoModifiers, ui::EventTimeForNow());
+    if (gin::ConvertFromV8(isolate, input_event, keyboard_event.get()))
+      return keyboard_event;
+  } else if (type == blink::WebInputEvent::Type::kMouseWheel) {
+    auto mouse_wheel_event = std::make_unique<blink::WebMouseWheelEvent>();
+    if (gin::ConvertFromV8(isolate, input_event, mouse_wheel_event.get()))
+      return mouse_wheel_event;
+  }
+  return nullptr;
+}
+
 }  // namespace
 
 #if BUILDFLAG(ENABLE_ELECTRON_EXTENSIONS)
@@ -2653,60 +2697,133 @@ void WebContents::SendInputEvent(v8::Isolate* isolate,
   if (!view)
     return;
 
+  std::unique_ptr<blink::WebInputEvent> event =
+      ConvertInputEvent(isolate, input_event);
+  if (!event) {
+    isolate->ThrowException(
+        v8::Exception::Error(gin::StringToV8(isolate, "Invalid event object")));
+    return;
+  }
+
+  ForwardInputEvent(view->GetRenderWidgetHost(), *event);
+}
+
+int WebContents::SendInputEvents(gin::Arguments* args) {
+  v8::Isolate* isolate = args->isolate();
+  std::vector<v8::Local<v8::Value>> input_events;
+  if (!args->GetNext(&input_events)) {
+    args->ThrowTypeError("Expected an array of input events");
+    return 0;
+  }
+
+  bool coalesce = true;
+  gin_helper::Dictionary options;
+  if (args->GetNext(&options))
+    options.Get("coalesce", &coalesce);
+
+  content::RenderWidgetHostView* view =
+      web_contents()->GetRenderWidgetHostView();
+  if (!view)
+    return 0;
+
+  // Convert the whole batch before delivering anything, so an invalid event
+  // does not leave the page with only part of the batch.
+  std::vector<std::unique_ptr<blink::WebInputEvent>> events;
+  std::vector<base::Optional<double>> timestamps;
+  events.reserve(input_events.size());
+  timestamps.reserve(input_events.size());
+  base::Optional<double> latest_timestamp;
+  for (size_t i = 0; i < input_events.size(); ++i) {
+    std::unique_ptr<blink::WebInputEvent> event =
+        ConvertInputEvent(isolate, input_events[i]);
+    if (!event) {
+      args->ThrowTypeError("Invalid event object at index " +
+                           base::NumberToString(i));
+      return 0;
+    }
+
+    gin_helper::Dictionary dict;
+    double timestamp;
+    if (gin::ConvertFromV8(isolate, input_events[i], &dict) &&
+        dict.Get("timestamp", &timestamp)) {
+      timestamps.emplace_back(timestamp);
+      if (!latest_timestamp || timestamp > *latest_timestamp)
+        latest_timestamp = timestamp;
+    } else {
+      timestamps.emplace_back();
+    }
+    events.push_back(std::move(event));
+  }
+
+  // Timestamps are only meaningful relative to each other, the latest event
+  // is treated as happening now and the others are placed before it.
+  base::TimeTicks now = ui::EventTimeForNow();
+  std::vector<std::unique_ptr<blink::WebInputEvent>> queue;
+  queue.reserve(events.size());
+  for (size_t i = 0; i < events.size(); ++i) {
+    std::unique_ptr<blink::WebInputEvent>& event = events[i];
+    if (timestamps[i]) {
+      event->SetTimeStamp(now - base::TimeDelta::FromMillisecondsD(
+                                    *latest_timestamp - *timestamps[i]));
+    }
+
+    // Consecutive mouse moves and wheel scrolls with the same modifiers are
+    // merged the same way the input router merges them, accumulating the
+    // movement and scroll deltas.
+    if (coalesce && !queue.empty() && queue.back()->CanCoalesce(*event)) {
+      queue.back()->Coalesce(*event);
+      continue;
+    }
+    queue.push_back(std::move(event));
+  }
+
   content::RenderWidgetHost* rwh = view->GetRenderWidgetHost();
-  blink::WebInputEvent::Type type =
-      gin::GetWebInputEventType(isolate, input_event);
+  for (const auto& event : queue)
+    ForwardInputEvent(rwh, *event);
+  return static_cast<int>(queue.size());
+}
+
+void WebContents::ForwardInputEvent(content::RenderWidgetHost* rwh,
+                                    const blink::WebInputEvent& event) {
+  blink::WebInputEvent::Type type = event.GetType();
   if (blink::WebInputEvent::IsMouseEventType(type)) {
-    blink::WebMouseEvent mouse_event;
-    if (gin::ConvertFromV8(isolate, input_event, &mouse_event)) {
-      if (IsOffScreen()) {
+    const auto& mouse_event = static_cast<const blink::WebMouseEvent&>(event);
+    if (IsOffScreen()) {
 #if BUILDFLAG(ENABLE_OSR)
-        GetOffScreenRenderWidgetHostView()->SendMouseEvent(mouse_event);
+      GetOffScreenRenderWidgetHostView()->SendMouseEvent(mouse_event);
 #endif
-      } else {
-        rwh->ForwardMouseEvent(mouse_event);
-      }
-      return;
+    } else {
+      rwh->ForwardMouseEvent(mouse_event);
     }
   } else if (blink::WebInputEvent::IsKeyboardEventType(type)) {
-    content::NativeWebKeyboardEvent keyboard_event(
-        blink::WebKeyboardEvent::Type::kRawKeyDown,
-        blink::WebInputEvent::Modifiers::kNoModifiers, ui::EventTimeForNow());
-    if (gin::ConvertFromV8(isolate, input_event, &keyboard_event)) {
-      rwh->ForwardKeyboardEvent(keyboard_event);
-      return;
-    }
+    rwh->ForwardKeyboardEvent(
+        static_cast<const content::NativeWebKeyboardEvent&>(event));
   } else if (type == blink::WebInputEvent::Type::kMouseWheel) {
-    blink::WebMouseWheelEvent mouse_wheel_event;
-    if (gin::ConvertFromV8(isolate, input_event, &mouse_wheel_event)) {
-      if (IsOffScreen()) {
+    blink::WebMouseWheelEvent mouse_wheel_event =
+        static_cast<const blink::WebMouseWheelEvent&>(event);
+    if (IsOffScreen()) {
 #if BUILDFLAG(ENABLE_OSR)
-        GetOffScreenRenderWidgetHostView()->SendMouseWheelEvent(
-            mouse_wheel_event);
+      GetOffScreenRenderWidgetHostView()->SendMouseWheelEvent(
+          mouse_wheel_event);
 #endif
-      } else {
-        // Chromium expects phase info in wheel events (and applies a
-        // DCHECK to verify it). See: https://crbug.com/756524.
-        mouse_wheel_event.phase = blink::WebMouseWheelEvent::kPhaseBegan;
-        mouse_wheel_event.dispatch_type =
-            blink::WebInputEvent::DispatchType::kBlocking;
-        rwh->ForwardWheelEvent(mouse_wheel_event);
-
-        // Send a synthetic wheel event with phaseEnded to finish scrolling.
-        mouse_wheel_event.has_synthetic_phase = true;
-        mouse_wheel_event.delta_x = 0;
-        mouse_wheel_event.delta_y = 0;
-        mouse_wheel_event.phase = blink::WebMouseWheelEvent::kPhaseEnded;
-        mouse_wheel_event.dispatch_type =
-            blink::WebInputEvent::DispatchType::kEventNonBlocking;
-        rwh->ForwardWheelEvent(mouse_wheel_event);
-      }
-      return;
+    } else {
+      // Chromium expects phase info in wheel events (and applies a
+      // DCHECK to verify it). See: https://crbug.com/756524.
+      mouse_wheel_event.phase = blink::WebMouseWheelEvent::kPhaseBegan;
+      mouse_wheel_event.dispatch_type =
+          blink::WebInputEvent::DispatchType::kBlocking;
+      rwh->ForwardWheelEvent(mouse_wheel_event);
+
+      // Send a synthetic wheel event with phaseEnded to finish scrolling.
+      mouse_wheel_event.has_synthetic_phase = true;
+      mouse_wheel_event.delta_x = 0;
+      mouse_wheel_event.delta_y = 0;
+      mouse_wheel_event.phase = blink::WebMouseWheelEvent::kPhaseEnded;
+      mouse_wheel_event.dispatch_type =
+          blink::WebInputEvent::DispatchType::kEventNonBlocking;
+      rwh->ForwardWheelEvent(mouse_wheel_event);
     }
   }
-
-  isolate->ThrowException(
-      v8::Exception::Error(gin::StringToV8(isolate, "Invalid event object")));
 }
 
 void WebContents::BeginFrameSubscription(gin::Arguments* args) {
@@ -2732,6 +2849,133 @@ void WebContents::EndFrameSubscription() {
   frame_subscriber_.reset();
 }
 
+v8::Local<v8::Promise> WebContents::StartRecording(const base::FilePath& path,
+                                                   gin::Arguments* args) {
+  gin_helper::Promise<void> promise(args->isolate());
+  v8::Local<v8::Promise> handle = promise.GetHandle();
+
+  if (recorder_) {
+    promise.RejectWithErrorMessage("A recording is already in progress");
+    return handle;
+  }
+
+  WebContentsRecorder::Options options;
+  gin_helper::Dictionary dict;
+  if (args->GetNext(&dict)) {
+    std::string codec;
+    if (dict.Get("codec", &codec)) {
+      if (codec == "vp9") {
+        options.codec = media::kCodecVP9;
+      } else if (codec != "vp8") {
+        promise.RejectWithErrorMessage("Unsupported codec: " + codec);
+        return handle;
+      }
+    }
+    dict.Get("frameRate", &options.frame_rate);
+    if (options.frame_rate < 1 || options.frame_rate > 60) {
+      promise.RejectWithErrorMessage("frameRate must be between 1 and 60");
+      return handle;
+    }
+    uint64_t bitrate;
+    if (dict.Get("bitrate", &bitrate))
+      options.bitrate = bitrate;
+  }
+
+  recorder_ = std::make_unique<WebContentsRecorder>(web_contents(), options);
+  recorder_->Start(
+      path, base::BindOnce(&WebContents::OnRecordingStarted, GetWeakPtr(),
+                           recorder_->GetWeakPtr(), std::move(promise)));
+  return handle;
+}
+
+void WebContents::OnRecordingStarted(
+    base::WeakPtr<WebContentsRecorder> recorder,
+    gin_helper::Promise<void> promise,
+    const std::string& error) {
+  if (error.empty()) {
+    promise.Resolve();
+    return;
+  }
+  // Only drop the recorder that failed, a new recording may have been started
+  // since then.
+  if (recorder && recorder.get() == recorder_.get())
+    recorder_.reset();
+  promise.RejectWithErrorMessage(error);
+}
+
+void WebContents::PauseRecording() {
+  if (recorder_)
+    recorder_->Pause();
+}
+
+void WebContents::ResumeRecording() {
+  if (recorder_)
+    recorder_->Resume();
+}
+
+v8::Local<v8::Promise> WebContents::StopRecording(v8::Isolate* isolate) {
+  gin_helper::Promise<gin_helper::Dictionary> promise(isolate);
+  v8::Local<v8::Promise> handle = promise.GetHandle();
+
+  if (!recorder_) {
+    promise.RejectWithErrorMessage("No recording is in progress");
+    return handle;
+  }
+
+  // The recorder finishes writing the file on its own.
+  recorder_->Stop(base::BindOnce(&OnRecordingStopped, std::move(promise)));
+  recorder_.reset();
+  return handle;
+}
+
+bool WebContents::IsRecording() const {
+  return !!recorder_;
+}
+
+void WebContents::StartObservingFrameTree() {
+  if (frame_tree_observer_)
+    return;
+  frame_tree_observer_ = std::make_unique<FrameTreeObserver>(
+      web_contents(),
+      base::BindRepeating(
+          [](base::WeakPtr<WebContents> self, const FrameTreeDiff& diff) {
+            if (self)
+              self->Emit("frame-tree-changed", diff);
+          },
+          GetWeakPtr()));
+}
+
+void WebContents::StopObservingFrameTree() {
+  frame_tree_observer_.reset();
+}
+
+void WebContents::SetDirectoryEnumerationOptions(gin::Arguments* args) {
+  gin_helper::Dictionary dict;
+  if (!args->GetNext(&dict)) {
+    args->ThrowTypeError("Expected an options object");
+    return;
+  }
+
+  DirectoryEnumerator::Options options;
+  v8::Local<v8::Value> value;
+  if (dict.Get("maxFiles", &value)) {
+    int max_files = 0;
+    if (!gin::ConvertFromV8(args->isolate(), value, &max_files) ||
+        max_files < 0) {
+      args->ThrowTypeError("maxFiles must be a non-negative integer");
+      return;
+    }
+    options.max_files = max_files;
+  }
+  if (dict.Get("ignore", &value) &&
+      !gin::ConvertFromV8(args->isolate(), value, &options.ignore_patterns)) {
+    args->ThrowTypeError("ignore must be an array of strings");
+    return;
+  }
+
+  directory_enumeration_options_ = options;
+}
+
 void WebContents::StartDrag(const gin_helper::Dictionary& item,
                             gin::Arguments* args) {
   base::FilePath file;
@@ -2961,6 +3205,33 @@ void WebContents::DoGetZoomLevel(
   std::move(callback).Run(GetZoomLevel());
 }
 
+void WebContents::OnNearHeapLimit(uint64_t heap_limit,
+                                  uint64_t raised_heap_limit,
+                                  content::RenderFrameHost* render_frame_host) {
+  if (render_frame_host != web_contents()->GetMainFrame())
+    return;
+
+  // The limit belongs to the renderer process, which can host the pages of
+  // other WebContents. Only the ones that asked for a limit are told, and
+  // the process is left alone so that they do not take the others down.
+  // A limit of 0 is not applied, like in AppendCommandLineSwitches().
+  auto* web_preferences = WebContentsPreferences::From(web_contents());
+  if (!web_preferences)
+    return;
+  base::Optional<int> max_old_space_size =
+      web_preferences->last_preference()->FindIntKey(
+          options::kMaxOldSpaceSize);
+  if (!max_old_space_size || *max_old_space_size <= 0)
+    return;
+
+  v8::Isolate* isolate = JavascriptEnvironment::GetIsolate();
+  v8::HandleScope handle_scope(isolate);
+  auto details = gin_helper::Dictionary::CreateEmpty(isolate);
+  details.Set("heapLimit", static_cast<double>(heap_limit >> 10));
+  details.Set("raisedHeapLimit", static_cast<double>(raised_heap_limit >> 10));
+  Emit("near-heap-limit", details);
+}
+
 std::vector<base::FilePath> WebContents::GetPreloadPaths() const {
   auto result = SessionPreferences::GetValidPreloads(GetBrowserContext());
 
@@ -3565,8 +3836,20 @@ v8::Local<v8::ObjectTemplate> WebContents::FillObjectTemplate(
       .SetMethod("focus", &WebContents::Focus)
       .SetMethod("isFocused", &WebContents::IsFocused)
       .SetMethod("sendInputEvent", &WebContents::SendInputEvent)
+      .SetMethod("sendInputEvents", &WebContents::SendInputEvents)
       .SetMethod("beginFrameSubscription", &WebContents::BeginFrameSubscription)
       .SetMethod("endFrameSubscription", &WebContents::EndFrameSubscription)
+      .SetMethod("startRecording", &WebContents::StartRecording)
+      .SetMethod("pauseRecording", &WebContents::PauseRecording)
+      .SetMethod("resumeRecording", &WebContents::ResumeRecording)
+      .SetMethod("stopRecording", &WebContents::StopRecording)
+      .SetMethod("isRecording", &WebContents::IsRecording)
+      .SetMethod("_startObservingFrameTree",
+                 &WebContents::StartObservingFrameTree)
+      .SetMethod("_stopObservingFrameTree",
+                 &WebContents::StopObservingFrameTree)
+      .SetMethod("setDirectoryEnumerationOptions",
+                 &WebContents::SetDirectoryEnumerationOptions)
       .SetMethod("startDrag", &WebContents::StartDrag)
       .SetMethod("attachToIframe", &WebContents::AttachToIframe)
       .SetMethod("detachFromOuterFrame", &WebContents::DetachFromOuterFrame)
@@ -32,6 +32,8 @@
 #include "services/service_manager/public/cpp/binder_registry.h"
 #include "shell/browser/api/frame_subscriber.h"
 #include "shell/browser/api/save_page_handler.h"
+#include "shell/browser/api/web_contents_recorder.h"
+#include "shell/browser/directory_enumerator.h"
 #include "shell/browser/event_emitter_mixin.h"
 #include "shell/browser/extended_web_contents_observer.h"
 #include "shell/browser/ui/inspectable_web_contents.h"
@@ -40,6 +42,7 @@
 #include "shell/common/gin_helper/cleaned_up_at_exit.h"
 #include "shell/common/gin_helper/constructible.h"
 #include "shell/common/gin_helper/error_thrower.h"
+#include "shell/common/gin_helper/promise.h"
 #include "ui/gfx/image/image.h"
 
 #if BUILDFLAG(ENABLE_PRINTING)
@@ -57,6 +60,7 @@ class ScriptExecutor;
 
 namespace blink {
 struct DeviceEmulationParams;
+class WebInputEvent;
 }
 
 namespace gin_helper {
@@ -79,6 +83,8 @@ class InspectableWebContents;
 class WebContentsZoomController;
 class WebViewGuestDelegate;
 class FrameSubscriber;
+class FrameTreeObserver;
+struct FrameTreeDiff;
 class WebDialogHelper;
 class NativeWindow;
 
@@ -238,11 +244,32 @@ class WebContents : public gin::Wrappable<WebContents>,
 
   // Send WebInputEvent to the page.
   void SendInputEvent(v8::Isolate* isolate, v8::Local<v8::Value> input_event);
+  // Send a batch of WebInputEvents, returns the number of events delivered
+  // after coalescing.
+  int SendInputEvents(gin::Arguments* args);
 
   // Subscribe to the frame updates.
   void BeginFrameSubscription(gin::Arguments* args);
   void EndFrameSubscription();
 
+  // Record the page into a WebM file.
+  v8::Local<v8::Promise> StartRecording(const base::FilePath& path,
+                                        gin::Arguments* args);
+  void PauseRecording();
+  void ResumeRecording();
+  v8::Local<v8::Promise> StopRecording(v8::Isolate* isolate);
+  bool IsRecording() const;
+
+  // Start and stop emitting "frame-tree-changed" events.
+  void StartObservingFrameTree();
+  void StopObservingFrameTree();
+
+  // Limits applied when a folder is selected for a webkitdirectory upload.
+  void SetDirectoryEnumerationOptions(gin::Arguments* args);
+  const DirectoryEnumerator::Options& directory_enumeration_options() const {
+    return directory_enumeration_options_;
+  }
+
   // Dragging native items.
   void StartDrag(const gin_helper::Dictionary& item, gin::Arguments* args);
 
@@ -411,6 +438,9 @@ class WebContents : public gin::Wrappable<WebContents>,
   void SetTemporaryZoomLevel(double level);
   void DoGetZoomLevel(
       electron::mojom::ElectronBrowser::DoGetZoomLevelCallback callback);
+  void OnNearHeapLimit(uint64_t heap_limit,
+                       uint64_t raised_heap_limit,
+                       content::RenderFrameHost* render_frame_host);
 
  private:
   // Does not manage lifetime of |web_contents|.
@@ -441,6 +471,14 @@ class WebContents : public gin::Wrappable<WebContents>,
                              extensions::mojom::ViewType view_type);
 #endif
 
+  void OnRecordingStarted(base::WeakPtr<WebContentsRecorder> recorder,
+                          gin_helper::Promise<void> promise,
+                          const std::string& error);
+
+  // Delivers a converted input event to |rwh|, or to the offscreen view.
+  void ForwardInputEvent(content::RenderWidgetHost* rwh,
+                         const blink::WebInputEvent& event);
+
   // content::WebContentsDelegate:
   bool DidAddMessageToConsole(content::WebContents* source,
                               blink::mojom::ConsoleMessageLevel level,
@@ -680,6 +718,10 @@ class WebContents : public gin::Wrappable<WebContents>,
   std::unique_ptr<ElectronJavaScriptDialogManager> dialog_manager_;
   std::unique_ptr<WebViewGuestDelegate> guest_delegate_;
   std::unique_ptr<FrameSubscriber> frame_subscriber_;
+  std::unique_ptr<WebContentsRecorder> recorder_;
+  std::unique_ptr<FrameTreeObserver> frame_tree_observer_;
+
+  DirectoryEnumerator::Options directory_enumeration_options_;
 
 #if BUILDFLAG(ENABLE_ELECTRON_EXTENSIONS)
   std::unique_ptr<extensions::ScriptExecutor> script_executor_;
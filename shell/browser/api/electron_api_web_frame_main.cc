@@ -6,6 +6,7 @@
 
 #include <string>
 #include <unordered_map>
+#include <unordered_set>
 #include <utility>
 #include <vector>
 
@@ -140,6 +141,39 @@ void WebFrameMain::Send(v8::Isolate* isolate,
                             0 /* sender_id */);
 }
 
+// static
+int WebFrameMain::Broadcast(v8::Isolate* isolate,
+                            const std::vector<WebFrameMain*>& frames,
+                            bool internal,
+                            const std::string& channel,
+                            v8::Local<v8::Value> args) {
+  blink::CloneableMessage message;
+  if (!gin::ConvertFromV8(isolate, args, &message)) {
+    isolate->ThrowException(v8::Exception::Error(
+        gin::StringToV8(isolate, "Failed to serialize arguments")));
+    return 0;
+  }
+
+  // Check every frame up front, so a disposed frame does not leave the message
+  // sent to only some of the targets.
+  for (auto* frame : frames) {
+    if (!frame->CheckRenderFrame())
+      return 0;
+  }
+
+  // The same frame may be reachable through more than one target.
+  std::unordered_set<WebFrameMain*> sent;
+  for (auto* frame : frames) {
+    if (!sent.insert(frame).second)
+      continue;
+    // Every message points at the same encoded bytes, which are only copied
+    // when mojo serializes the message for the pipe.
+    frame->GetRendererApi()->Message(internal, channel, message.ShallowClone(),
+                                     0 /* sender_id */);
+  }
+  return static_cast<int>(sent.size());
+}
+
 const mojo::Remote<mojom::ElectronRenderer>& WebFrameMain::GetRendererApi() {
   if (!renderer_api_) {
     pending_receiver_ = renderer_api_.BindNewPipeAndPassReceiver();
@@ -265,6 +299,12 @@ std::vector<content::RenderFrameHost*> WebFrameMain::FramesInSubtree() const {
   return frame_hosts;
 }
 
+std::vector<FrameTreeEntry> WebFrameMain::GetFrameTreeSnapshot() const {
+  if (!CheckRenderFrame())
+    return std::vector<FrameTreeEntry>();
+  return TakeFrameTreeSnapshot(render_frame_);
+}
+
 // static
 gin::Handle<WebFrameMain> WebFrameMain::New(v8::Isolate* isolate) {
   return gin::Handle<WebFrameMain>();
@@ -335,6 +375,7 @@ v8::Local<v8::ObjectTemplate> WebFrameMain::FillObjectTemplate(
       .SetProperty("parent", &WebFrameMain::Parent)
       .SetProperty("frames", &WebFrameMain::Frames)
       .SetProperty("framesInSubtree", &WebFrameMain::FramesInSubtree)
+      .SetMethod("getFrameTreeSnapshot", &WebFrameMain::GetFrameTreeSnapshot)
       .Build();
 }
 
@@ -371,6 +412,7 @@ void Initialize(v8::Local<v8::Object> exports,
   gin_helper::Dictionary dict(isolate, exports);
   dict.Set("WebFrameMain", WebFrameMain::GetConstructor(context));
   dict.SetMethod("fromId", &FromID);
+  dict.SetMethod("_broadcast", &WebFrameMain::Broadcast);
 }
 
 }  // namespace
@@ -13,6 +13,7 @@
 #include "base/process/process.h"
 #include "gin/handle.h"
 #include "gin/wrappable.h"
+#include "shell/browser/api/frame_tree_observer.h"
 #include "shell/common/gin_helper/constructible.h"
 #include "shell/common/gin_helper/pinnable.h"
 
@@ -60,6 +61,15 @@ class WebFrameMain : public gin::Wrappable<WebFrameMain>,
 
   const mojo::Remote<mojom::ElectronRenderer>& GetRendererApi();
 
+  // Serializes |args| once and sends the resulting message to every frame in
+  // |frames|, or throws without sending anything if one of them was disposed.
+  // Returns the number of frames the message was sent to.
+  static int Broadcast(v8::Isolate* isolate,
+                       const std::vector<WebFrameMain*>& frames,
+                       bool internal,
+                       const std::string& channel,
+                       v8::Local<v8::Value> args);
+
   // gin::Wrappable
   static gin::WrapperInfo kWrapperInfo;
   static v8::Local<v8::ObjectTemplate> FillObjectTemplate(
@@ -100,6 +110,7 @@ class WebFrameMain : public gin::Wrappable<WebFrameMain>,
   content::RenderFrameHost* Parent() const;
   std::vector<content::RenderFrameHost*> Frames() const;
   std::vector<content::RenderFrameHost*> FramesInSubtree() const;
+  std::vector<FrameTreeEntry> GetFrameTreeSnapshot() const;
 
   void OnRendererConnectionError();
 
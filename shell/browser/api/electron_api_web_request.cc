@@ -42,40 +42,6 @@ struct Converter<URLPattern> {
   }
 };
 
-template <>
-struct Converter<extensions::WebRequestResourceType> {
-  static v8::Local<v8::Value> ToV8(v8::Isolate* isolate,
-                                   extensions::WebRequestResourceType type) {
-    const char* result;
-    switch (type) {
-      case extensions::WebRequestResourceType::MAIN_FRAME:
-        result = "mainFrame";
-        break;
-      case extensions::WebRequestResourceType::SUB_FRAME:
-        result = "subFrame";
-        break;
-      case extensions::WebRequestResourceType::STYLESHEET:
-        result = "stylesheet";
-        break;
-      case extensions::WebRequestResourceType::SCRIPT:
-        result = "script";
-        break;
-      case extensions::WebRequestResourceType::IMAGE:
-        result = "image";
-        break;
-      case extensions::WebRequestResourceType::OBJECT:
-        result = "object";
-        break;
-      case extensions::WebRequestResourceType::XHR:
-        result = "xhr";
-        break;
-      default:
-        result = "other";
-    }
-    return StringToV8(isolate, result);
-  }
-};
-
 }  // namespace gin
 
 namespace electron {
@@ -0,0 +1,30 @@
+// Copyright (c) 2021 GitHub, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#include "shell/browser/javascript_environment.h"
+#include "shell/common/node_includes.h"
+
+namespace {
+
+void SetUpIsolate(const v8::FunctionCallbackInfo<v8::Value>& info) {
+  electron::JavascriptEnvironment::SetUpWorkerIsolate(info.GetIsolate());
+}
+
+void Initialize(v8::Local<v8::Object> exports,
+                v8::Local<v8::Value> unused,
+                v8::Local<v8::Context> context,
+                void* priv) {
+  // gin is not set up in the isolate yet, so only plain V8 can be used.
+  v8::Isolate* isolate = context->GetIsolate();
+  exports
+      ->Set(context, v8::String::NewFromUtf8Literal(isolate, "setUpIsolate"),
+            v8::FunctionTemplate::New(isolate, &SetUpIsolate)
+                ->GetFunction(context)
+                .ToLocalChecked())
+      .Check();
+}
+
+}  // namespace
+
+NODE_LINKED_MODULE_CONTEXT_AWARE(electron_browser_worker_thread, Initialize)
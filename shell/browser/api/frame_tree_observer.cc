@@ -0,0 +1,168 @@
+// Copyright (c) 2021 GitHub, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#include "shell/browser/api/frame_tree_observer.h"
+
+#include <utility>
+
+#include "base/threading/sequenced_task_runner_handle.h"
+#include "content/public/browser/navigation_handle.h"
+#include "content/public/browser/render_frame_host.h"
+#include "content/public/browser/render_process_host.h"
+#include "content/public/browser/web_contents.h"
+#include "shell/common/gin_converters/gurl_converter.h"
+#include "shell/common/gin_converters/std_converter.h"
+#include "shell/common/gin_helper/dictionary.h"
+
+namespace electron {
+
+namespace api {
+
+FrameTreeEntry::FrameTreeEntry() = default;
+
+FrameTreeEntry::FrameTreeEntry(content::RenderFrameHost* rfh)
+    : frame_tree_node_id(rfh->GetFrameTreeNodeId()),
+      process_id(rfh->GetProcess()->GetID()),
+      routing_id(rfh->GetRoutingID()),
+      name(rfh->GetFrameName()),
+      url(rfh->GetLastCommittedURL()),
+      origin(rfh->GetLastCommittedOrigin()) {
+  if (rfh->GetParent())
+    parent_frame_tree_node_id = rfh->GetParent()->GetFrameTreeNodeId();
+}
+
+FrameTreeEntry::FrameTreeEntry(const FrameTreeEntry&) = default;
+
+FrameTreeEntry::~FrameTreeEntry() = default;
+
+bool FrameTreeEntry::operator==(const FrameTreeEntry& other) const {
+  return frame_tree_node_id == other.frame_tree_node_id &&
+         parent_frame_tree_node_id == other.parent_frame_tree_node_id &&
+         process_id == other.process_id && routing_id == other.routing_id &&
+         name == other.name && url == other.url && origin == other.origin;
+}
+
+std::vector<FrameTreeEntry> TakeFrameTreeSnapshot(
+    content::RenderFrameHost* rfh) {
+  std::vector<FrameTreeEntry> entries;
+  if (!rfh)
+    return entries;
+  for (auto* frame : rfh->GetFramesInSubtree())
+    entries.emplace_back(frame);
+  return entries;
+}
+
+FrameTreeDiff::FrameTreeDiff() = default;
+
+FrameTreeDiff::~FrameTreeDiff() = default;
+
+FrameTreeObserver::FrameTreeObserver(content::WebContents* web_contents,
+                                     const DiffCallback& callback)
+    : content::WebContentsObserver(web_contents), callback_(callback) {
+  // Report the frames that already exist as added.
+  ScheduleUpdate();
+}
+
+FrameTreeObserver::~FrameTreeObserver() = default;
+
+void FrameTreeObserver::RenderFrameCreated(
+    content::RenderFrameHost* render_frame_host) {
+  ScheduleUpdate();
+}
+
+void FrameTreeObserver::RenderFrameDeleted(
+    content::RenderFrameHost* render_frame_host) {
+  ScheduleUpdate();
+}
+
+void FrameTreeObserver::RenderFrameHostChanged(
+    content::RenderFrameHost* old_host,
+    content::RenderFrameHost* new_host) {
+  ScheduleUpdate();
+}
+
+void FrameTreeObserver::FrameNameChanged(
+    content::RenderFrameHost* render_frame_host,
+    const std::string& name) {
+  ScheduleUpdate();
+}
+
+void FrameTreeObserver::DidFinishNavigation(
+    content::NavigationHandle* navigation_handle) {
+  if (navigation_handle->HasCommitted())
+    ScheduleUpdate();
+}
+
+void FrameTreeObserver::ScheduleUpdate() {
+  if (update_pending_)
+    return;
+  update_pending_ = true;
+  base::SequencedTaskRunnerHandle::Get()->PostTask(
+      FROM_HERE, base::BindOnce(&FrameTreeObserver::Update,
+                                weak_factory_.GetWeakPtr()));
+}
+
+void FrameTreeObserver::Update() {
+  update_pending_ = false;
+  if (!web_contents())
+    return;
+
+  std::map<int, FrameTreeEntry> tree;
+  for (auto& entry : TakeFrameTreeSnapshot(web_contents()->GetMainFrame()))
+    tree.emplace(entry.frame_tree_node_id, std::move(entry));
+
+  FrameTreeDiff diff;
+  for (const auto& it : tree) {
+    auto last = last_tree_.find(it.first);
+    if (last == last_tree_.end())
+      diff.added.push_back(it.second);
+    else if (last->second != it.second)
+      diff.changed.push_back(it.second);
+  }
+  for (const auto& it : last_tree_) {
+    if (tree.find(it.first) == tree.end())
+      diff.removed.push_back(it.first);
+  }
+
+  last_tree_ = std::move(tree);
+  if (!diff.empty())
+    callback_.Run(diff);
+}
+
+}  // namespace api
+
+}  // namespace electron
+
+namespace gin {
+
+// static
+v8::Local<v8::Value> Converter<electron::api::FrameTreeEntry>::ToV8(
+    v8::Isolate* isolate,
+    const electron::api::FrameTreeEntry& val) {
+  gin_helper::Dictionary dict = gin::Dictionary::CreateEmpty(isolate);
+  dict.Set("frameTreeNodeId", val.frame_tree_node_id);
+  if (val.parent_frame_tree_node_id != -1)
+    dict.Set("parentFrameTreeNodeId", val.parent_frame_tree_node_id);
+  else
+    dict.Set("parentFrameTreeNodeId", nullptr);
+  dict.Set("processId", val.process_id);
+  dict.Set("routingId", val.routing_id);
+  dict.Set("name", val.name);
+  dict.Set("url", val.url);
+  dict.Set("origin", val.origin.Serialize());
+  return dict.GetHandle();
+}
+
+// static
+v8::Local<v8::Value> Converter<electron::api::FrameTreeDiff>::ToV8(
+    v8::Isolate* isolate,
+    const electron::api::FrameTreeDiff& val) {
+  gin_helper::Dictionary dict = gin::Dictionary::CreateEmpty(isolate);
+  dict.Set("added", val.added);
+  dict.Set("changed", val.changed);
+  dict.Set("removed", val.removed);
+  return dict.GetHandle();
+}
+
+}  // namespace gin
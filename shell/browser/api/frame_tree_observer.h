@@ -0,0 +1,122 @@
+// Copyright (c) 2021 GitHub, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#ifndef SHELL_BROWSER_API_FRAME_TREE_OBSERVER_H_
+#define SHELL_BROWSER_API_FRAME_TREE_OBSERVER_H_
+
+#include <map>
+#include <string>
+#include <vector>
+
+#include "base/callback.h"
+#include "base/memory/weak_ptr.h"
+#include "content/public/browser/web_contents_observer.h"
+#include "gin/converter.h"
+#include "url/gurl.h"
+#include "url/origin.h"
+
+namespace content {
+class RenderFrameHost;
+}
+
+namespace electron {
+
+namespace api {
+
+// The commonly needed properties of a single frame, read in one pass so that
+// inspecting a large frame tree doesn't cost a native call per property.
+struct FrameTreeEntry {
+  FrameTreeEntry();
+  explicit FrameTreeEntry(content::RenderFrameHost* rfh);
+  FrameTreeEntry(const FrameTreeEntry&);
+  ~FrameTreeEntry();
+
+  bool operator==(const FrameTreeEntry& other) const;
+  bool operator!=(const FrameTreeEntry& other) const {
+    return !(*this == other);
+  }
+
+  int frame_tree_node_id = -1;
+  int parent_frame_tree_node_id = -1;
+  int process_id = -1;
+  int routing_id = -1;
+  std::string name;
+  GURL url;
+  url::Origin origin;
+};
+
+// Flat list of every frame under a root, parents before their children.
+std::vector<FrameTreeEntry> TakeFrameTreeSnapshot(
+    content::RenderFrameHost* rfh);
+
+struct FrameTreeDiff {
+  FrameTreeDiff();
+  ~FrameTreeDiff();
+
+  bool empty() const {
+    return added.empty() && changed.empty() && removed.empty();
+  }
+
+  std::vector<FrameTreeEntry> added;
+  std::vector<FrameTreeEntry> changed;
+  // frameTreeNodeIds of frames that are gone.
+  std::vector<int> removed;
+};
+
+// Watches the frame tree of a WebContents and reports what changed. Changes
+// that happen in the same task are coalesced into a single diff.
+class FrameTreeObserver : public content::WebContentsObserver {
+ public:
+  using DiffCallback = base::RepeatingCallback<void(const FrameTreeDiff&)>;
+
+  FrameTreeObserver(content::WebContents* web_contents,
+                    const DiffCallback& callback);
+  ~FrameTreeObserver() override;
+
+ private:
+  // content::WebContentsObserver:
+  void RenderFrameCreated(content::RenderFrameHost* render_frame_host) override;
+  void RenderFrameDeleted(content::RenderFrameHost* render_frame_host) override;
+  void RenderFrameHostChanged(content::RenderFrameHost* old_host,
+                              content::RenderFrameHost* new_host) override;
+  void FrameNameChanged(content::RenderFrameHost* render_frame_host,
+                        const std::string& name) override;
+  void DidFinishNavigation(
+      content::NavigationHandle* navigation_handle) override;
+
+  void ScheduleUpdate();
+  void Update();
+
+  DiffCallback callback_;
+  bool update_pending_ = false;
+
+  // The tree as last reported, keyed by frameTreeNodeId.
+  std::map<int, FrameTreeEntry> last_tree_;
+
+  base::WeakPtrFactory<FrameTreeObserver> weak_factory_{this};
+
+  DISALLOW_COPY_AND_ASSIGN(FrameTreeObserver);
+};
+
+}  // namespace api
+
+}  // namespace electron
+
+namespace gin {
+
+template <>
+struct Converter<electron::api::FrameTreeEntry> {
+  static v8::Local<v8::Value> ToV8(v8::Isolate* isolate,
+                                   const electron::api::FrameTreeEntry& val);
+};
+
+template <>
+struct Converter<electron::api::FrameTreeDiff> {
+  static v8::Local<v8::Value> ToV8(v8::Isolate* isolate,
+                                   const electron::api::FrameTreeDiff& val);
+};
+
+}  // namespace gin
+
+#endif  // SHELL_BROWSER_API_FRAME_TREE_OBSERVER_H_
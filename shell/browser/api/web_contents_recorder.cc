@@ -0,0 +1,428 @@
+// Copyright (c) 2021 GitHub, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#include "shell/browser/api/web_contents_recorder.h"
+
+#include <utility>
+
+#include "base/bind.h"
+#include "base/files/file.h"
+#include "base/strings/string_piece.h"
+#include "base/task/post_task.h"
+#include "base/task/thread_pool.h"
+#include "base/task_runner_util.h"
+#include "base/threading/sequenced_task_runner_handle.h"
+#include "content/public/browser/render_view_host.h"
+#include "content/public/browser/render_widget_host.h"
+#include "content/public/browser/render_widget_host_view.h"
+#include "media/base/bind_to_current_loop.h"
+#include "media/base/video_encoder.h"
+#include "media/base/video_frame.h"
+#include "media/capture/mojom/video_capture_types.mojom.h"
+#include "media/media_buildflags.h"
+#include "media/muxers/webm_muxer.h"
+#include "mojo/public/cpp/bindings/remote.h"
+#include "ui/gfx/geometry/size_conversions.h"
+
+#if BUILDFLAG(ENABLE_LIBVPX)
+#include "media/video/vpx_video_encoder.h"
+#endif
+
+namespace electron {
+
+namespace api {
+
+namespace {
+
+// Frames that have been captured but not yet encoded keep their capture
+// buffer alive, so only allow a few of them before dropping new frames.
+constexpr int kMaxFramesInFlight = 4;
+
+void FinishStop(WebContentsRecorder::Stats stats,
+                WebContentsRecorder::StopCallback callback,
+                bool success,
+                int frames_encoded,
+                int frames_failed) {
+  stats.frames_encoded = frames_encoded;
+  stats.frames_dropped += frames_failed;
+  std::move(callback).Run(success, stats);
+}
+
+}  // namespace
+
+// Encodes frames and writes them to a WebM file, lives on a worker sequence.
+class WebMEncoder {
+ public:
+  using FinishCallback = base::OnceCallback<
+      void(bool success, int frames_encoded, int frames_failed)>;
+
+  WebMEncoder(const WebContentsRecorder::Options& options,
+              scoped_refptr<base::SequencedTaskRunner> reply_task_runner,
+              base::RepeatingClosure on_frame_encoded)
+      : options_(options),
+        reply_task_runner_(std::move(reply_task_runner)),
+        on_frame_encoded_(std::move(on_frame_encoded)) {}
+
+  ~WebMEncoder() = default;
+
+  // Opens |path| for writing, returns an error message on failure.
+  std::string Open(const base::FilePath& path) {
+#if BUILDFLAG(ENABLE_LIBVPX)
+    file_.Initialize(path,
+                     base::File::FLAG_CREATE_ALWAYS | base::File::FLAG_WRITE);
+    if (!file_.IsValid()) {
+      return "Failed to open file: " +
+             base::File::ErrorToString(file_.error_details());
+    }
+    muxer_ = std::make_unique<media::WebmMuxer>(
+        media::kUnknownAudioCodec, true /* has_video */, false /* has_audio */,
+        base::BindRepeating(&WebMEncoder::WriteData, base::Unretained(this)));
+    return std::string();
+#else
+    return "WebM recording is not supported in this build";
+#endif
+  }
+
+  void Encode(scoped_refptr<media::VideoFrame> frame, bool key_frame) {
+    if (!encoder_ && !InitializeEncoder(frame->visible_rect().size())) {
+      OnEncodeDone(
+          media::Status(media::StatusCode::kEncoderInitializationError));
+      return;
+    }
+    if (frame->visible_rect().size() != frame_size_) {
+      OnEncodeDone(media::Status(media::StatusCode::kEncoderFailedEncode));
+      return;
+    }
+    encoder_->Encode(std::move(frame), key_frame,
+                     base::BindOnce(&WebMEncoder::OnEncodeDone,
+                                    weak_factory_.GetWeakPtr()));
+  }
+
+  void Pause() {
+    if (muxer_)
+      muxer_->Pause();
+  }
+
+  void Resume() {
+    if (muxer_)
+      muxer_->Resume();
+  }
+
+  // Flushes the pending frames and closes the file, |callback| is run on the
+  // reply task runner. |encoder| is kept alive until the flush completes.
+  static void Finish(
+      std::unique_ptr<WebMEncoder, base::OnTaskRunnerDeleter> encoder,
+      FinishCallback callback) {
+    WebMEncoder* self = encoder.get();
+    if (!self->encoder_) {
+      OnFlushDone(std::move(encoder), std::move(callback), media::Status());
+      return;
+    }
+    self->encoder_->Flush(base::BindOnce(&WebMEncoder::OnFlushDone,
+                                         std::move(encoder),
+                                         std::move(callback)));
+  }
+
+ private:
+  bool InitializeEncoder(const gfx::Size& size) {
+#if BUILDFLAG(ENABLE_LIBVPX)
+    frame_size_ = size;
+    encoder_ = std::make_unique<media::VpxVideoEncoder>();
+
+    media::VideoEncoder::Options options;
+    options.frame_size = size;
+    options.framerate = options_.frame_rate;
+    options.bitrate = options_.bitrate;
+    media::VideoCodecProfile profile = options_.codec == media::kCodecVP9
+                                           ? media::VP9PROFILE_PROFILE0
+                                           : media::VP8PROFILE_ANY;
+    encoder_->Initialize(
+        profile, options,
+        base::BindRepeating(&WebMEncoder::OnEncoderOutput,
+                            weak_factory_.GetWeakPtr()),
+        base::BindOnce(&WebMEncoder::OnInitializeDone,
+                       weak_factory_.GetWeakPtr()));
+    return true;
+#else
+    return false;
+#endif
+  }
+
+  void OnInitializeDone(media::Status status) {
+    if (!status.is_ok())
+      failed_ = true;
+  }
+
+  void OnEncoderOutput(
+      media::VideoEncoderOutput output,
+      base::Optional<media::VideoEncoder::CodecDescription> description) {
+    media::WebmMuxer::VideoParameters params(
+        frame_size_, options_.frame_rate, options_.codec, base::nullopt);
+    std::string data(reinterpret_cast<const char*>(output.data.get()),
+                     output.size);
+    if (!muxer_->OnEncodedVideo(params, std::move(data), std::string(),
+                                base::TimeTicks() + output.timestamp,
+                                output.key_frame)) {
+      failed_ = true;
+    }
+  }
+
+  void OnEncodeDone(media::Status status) {
+    if (status.is_ok())
+      ++frames_encoded_;
+    else
+      ++frames_failed_;
+    reply_task_runner_->PostTask(FROM_HERE, on_frame_encoded_);
+  }
+
+  static void OnFlushDone(
+      std::unique_ptr<WebMEncoder, base::OnTaskRunnerDeleter> encoder,
+      FinishCallback callback,
+      media::Status status) {
+    if (encoder->muxer_)
+      encoder->muxer_->Flush();
+    encoder->file_.Close();
+    bool success = status.is_ok() && !encoder->failed_;
+    encoder->reply_task_runner_->PostTask(
+        FROM_HERE,
+        base::BindOnce(std::move(callback), success, encoder->frames_encoded_,
+                       encoder->frames_failed_));
+  }
+
+  void WriteData(base::StringPiece data) {
+    if (failed_)
+      return;
+    int written = file_.WriteAtCurrentPos(data.data(), data.size());
+    if (written < 0 || static_cast<size_t>(written) != data.size())
+      failed_ = true;
+  }
+
+  const WebContentsRecorder::Options options_;
+  scoped_refptr<base::SequencedTaskRunner> reply_task_runner_;
+  base::RepeatingClosure on_frame_encoded_;
+
+  base::File file_;
+  std::unique_ptr<media::WebmMuxer> muxer_;
+  std::unique_ptr<media::VideoEncoder> encoder_;
+  gfx::Size frame_size_;
+  bool failed_ = false;
+  int frames_encoded_ = 0;
+  int frames_failed_ = 0;
+
+  base::WeakPtrFactory<WebMEncoder> weak_factory_{this};
+
+  DISALLOW_COPY_AND_ASSIGN(WebMEncoder);
+};
+
+WebContentsRecorder::WebContentsRecorder(content::WebContents* web_contents,
+                                         const Options& options)
+    : content::WebContentsObserver(web_contents),
+      options_(options),
+      encoder_task_runner_(base::ThreadPool::CreateSequencedTaskRunner(
+          {base::MayBlock(), base::TaskPriority::USER_VISIBLE,
+           base::TaskShutdownBehavior::BLOCK_SHUTDOWN})),
+      encoder_(nullptr, base::OnTaskRunnerDeleter(encoder_task_runner_)) {}
+
+WebContentsRecorder::~WebContentsRecorder() = default;
+
+void WebContentsRecorder::Start(const base::FilePath& path,
+                                StartCallback callback) {
+  start_callback_ = std::move(callback);
+  encoder_.reset(new WebMEncoder(
+      options_, base::SequencedTaskRunnerHandle::Get(),
+      base::BindRepeating(&WebContentsRecorder::OnFrameEncoded,
+                          weak_factory_.GetWeakPtr())));
+  base::PostTaskAndReplyWithResult(
+      encoder_task_runner_.get(), FROM_HERE,
+      base::BindOnce(&WebMEncoder::Open, base::Unretained(encoder_.get()),
+                     path),
+      base::BindOnce(&WebContentsRecorder::OnOpened,
+                     weak_factory_.GetWeakPtr()));
+}
+
+void WebContentsRecorder::Pause() {
+  if (!started_ || paused_)
+    return;
+  paused_ = true;
+  encoder_task_runner_->PostTask(
+      FROM_HERE,
+      base::BindOnce(&WebMEncoder::Pause, base::Unretained(encoder_.get())));
+}
+
+void WebContentsRecorder::Resume() {
+  if (!started_ || !paused_)
+    return;
+  paused_ = false;
+  request_key_frame_ = true;
+  encoder_task_runner_->PostTask(
+      FROM_HERE,
+      base::BindOnce(&WebMEncoder::Resume, base::Unretained(encoder_.get())));
+}
+
+void WebContentsRecorder::Stop(StopCallback callback) {
+  DetachFromHost();
+  started_ = false;
+  if (start_callback_) {
+    base::SequencedTaskRunnerHandle::Get()->PostTask(
+        FROM_HERE, base::BindOnce(std::move(start_callback_),
+                                  std::string("The recording was stopped")));
+  }
+  if (!encoder_) {
+    std::move(callback).Run(false, stats_);
+    return;
+  }
+  encoder_task_runner_->PostTask(
+      FROM_HERE,
+      base::BindOnce(&WebMEncoder::Finish, std::move(encoder_),
+                     base::BindOnce(&FinishStop, stats_, std::move(callback))));
+}
+
+void WebContentsRecorder::OnOpened(const std::string& error) {
+  StartCallback callback = std::move(start_callback_);
+  if (!error.empty()) {
+    encoder_.reset();
+    std::move(callback).Run(error);
+    return;
+  }
+
+  content::RenderViewHost* rvh = web_contents()->GetRenderViewHost();
+  if (rvh)
+    AttachToHost(rvh->GetWidget());
+  if (!video_capturer_) {
+    encoder_.reset();
+    std::move(callback).Run("The page has no view to record");
+    return;
+  }
+
+  started_ = true;
+  std::move(callback).Run(std::string());
+}
+
+void WebContentsRecorder::OnFrameEncoded() {
+  --frames_in_flight_;
+}
+
+void WebContentsRecorder::AttachToHost(content::RenderWidgetHost* host) {
+  host_ = host;
+
+  // The view can be null if the renderer process has crashed.
+  // (https://crbug.com/847363)
+  if (!host_->GetView())
+    return;
+
+  // The encoder needs frames of a constant size, keep the size of the first
+  // frame for the whole recording and let the capturer letterbox the rest.
+  if (frame_size_.IsEmpty()) {
+    gfx::Size size = GetRenderViewSize();
+    // I420 frames must have even dimensions.
+    frame_size_ = gfx::Size((size.width() + 1) & ~1, (size.height() + 1) & ~1);
+  }
+
+  video_capturer_ = host_->GetView()->CreateVideoCapturer();
+  video_capturer_->SetResolutionConstraints(frame_size_, frame_size_, true);
+  video_capturer_->SetAutoThrottlingEnabled(false);
+  video_capturer_->SetMinSizeChangePeriod(base::TimeDelta());
+  video_capturer_->SetFormat(media::PIXEL_FORMAT_I420,
+                             gfx::ColorSpace::CreateREC709());
+  video_capturer_->SetMinCapturePeriod(base::TimeDelta::FromSeconds(1) /
+                                       options_.frame_rate);
+  video_capturer_->Start(this);
+}
+
+void WebContentsRecorder::DetachFromHost() {
+  if (!host_)
+    return;
+  video_capturer_.reset();
+  host_ = nullptr;
+}
+
+void WebContentsRecorder::RenderViewDeleted(content::RenderViewHost* host) {
+  if (host->GetWidget() == host_) {
+    DetachFromHost();
+  }
+}
+
+void WebContentsRecorder::RenderViewHostChanged(
+    content::RenderViewHost* old_host,
+    content::RenderViewHost* new_host) {
+  if (!started_)
+    return;
+  if ((old_host && old_host->GetWidget() == host_) || (!old_host && !host_)) {
+    DetachFromHost();
+    AttachToHost(new_host->GetWidget());
+  }
+}
+
+void WebContentsRecorder::OnFrameCaptured(
+    base::ReadOnlySharedMemoryRegion data,
+    ::media::mojom::VideoFrameInfoPtr info,
+    const gfx::Rect& content_rect,
+    mojo::PendingRemote<viz::mojom::FrameSinkVideoConsumerFrameCallbacks>
+        callbacks) {
+  mojo::Remote<viz::mojom::FrameSinkVideoConsumerFrameCallbacks>
+      callbacks_remote(std::move(callbacks));
+  if (!started_ || paused_ || !data.IsValid()) {
+    callbacks_remote->Done();
+    return;
+  }
+
+  ++stats_.frames_captured;
+  if (frames_in_flight_ >= kMaxFramesInFlight) {
+    ++stats_.frames_dropped;
+    callbacks_remote->Done();
+    return;
+  }
+
+  base::ReadOnlySharedMemoryMapping mapping = data.Map();
+  if (!mapping.IsValid() ||
+      mapping.size() < media::VideoFrame::AllocationSize(info->pixel_format,
+                                                         info->coded_size)) {
+    DLOG(ERROR) << "Invalid shared memory for captured frame.";
+    ++stats_.frames_dropped;
+    callbacks_remote->Done();
+    return;
+  }
+
+  scoped_refptr<media::VideoFrame> frame = media::VideoFrame::WrapExternalData(
+      info->pixel_format, info->coded_size, info->visible_rect,
+      info->visible_rect.size(), static_cast<const uint8_t*>(mapping.memory()),
+      mapping.size(), info->timestamp);
+  if (!frame) {
+    ++stats_.frames_dropped;
+    callbacks_remote->Done();
+    return;
+  }
+
+  // Keep the capture buffer mapped, and out of the capturer's pool, until the
+  // encoder has released the frame. The frame is released on the encoder
+  // sequence, so bounce the release back to this thread.
+  frame->AddDestructionObserver(media::BindToCurrentLoop(base::BindOnce(
+      [](base::ReadOnlySharedMemoryMapping mapping,
+         mojo::Remote<viz::mojom::FrameSinkVideoConsumerFrameCallbacks>
+             releaser) {},
+      std::move(mapping), std::move(callbacks_remote))));
+
+  ++frames_in_flight_;
+  bool key_frame = request_key_frame_;
+  request_key_frame_ = false;
+  encoder_task_runner_->PostTask(
+      FROM_HERE,
+      base::BindOnce(&WebMEncoder::Encode, base::Unretained(encoder_.get()),
+                     std::move(frame), key_frame));
+}
+
+void WebContentsRecorder::OnStopped() {}
+
+void WebContentsRecorder::OnLog(const std::string& message) {}
+
+gfx::Size WebContentsRecorder::GetRenderViewSize() const {
+  content::RenderWidgetHostView* view = host_->GetView();
+  gfx::Size size = view->GetViewBounds().size();
+  return gfx::ToRoundedSize(
+      gfx::ScaleSize(gfx::SizeF(size), view->GetDeviceScaleFactor()));
+}
+
+}  // namespace api
+
+}  // namespace electron
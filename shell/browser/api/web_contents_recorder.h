@@ -0,0 +1,124 @@
+// Copyright (c) 2021 GitHub, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#ifndef SHELL_BROWSER_API_WEB_CONTENTS_RECORDER_H_
+#define SHELL_BROWSER_API_WEB_CONTENTS_RECORDER_H_
+
+#include <memory>
+#include <string>
+
+#include "base/callback.h"
+#include "base/files/file_path.h"
+#include "base/memory/scoped_refptr.h"
+#include "base/memory/weak_ptr.h"
+#include "base/optional.h"
+#include "base/sequenced_task_runner.h"
+#include "components/viz/host/client_frame_sink_video_capturer.h"
+#include "content/public/browser/web_contents.h"
+#include "content/public/browser/web_contents_observer.h"
+#include "media/base/video_codecs.h"
+#include "mojo/public/cpp/bindings/pending_remote.h"
+
+namespace electron {
+
+namespace api {
+
+class WebMEncoder;
+
+// Records the output of a WebContents into a WebM file. Frames are captured on
+// the UI thread and encoded and muxed on a worker sequence.
+class WebContentsRecorder : public content::WebContentsObserver,
+                            public viz::mojom::FrameSinkVideoConsumer {
+ public:
+  struct Options {
+    media::VideoCodec codec = media::kCodecVP8;
+    int frame_rate = 30;
+    base::Optional<uint64_t> bitrate;
+  };
+
+  struct Stats {
+    // Frames delivered by the capturer while the recording was not paused.
+    int frames_captured = 0;
+    // Frames written to the file.
+    int frames_encoded = 0;
+    // Frames that were captured but not written, either because the encoder
+    // could not keep up or because encoding failed.
+    int frames_dropped = 0;
+  };
+
+  // |error| is empty on success.
+  using StartCallback = base::OnceCallback<void(const std::string& error)>;
+  using StopCallback = base::OnceCallback<void(bool success, const Stats&)>;
+
+  WebContentsRecorder(content::WebContents* web_contents,
+                      const Options& options);
+  ~WebContentsRecorder() override;
+
+  // Opens |path| and starts capturing frames once it is ready.
+  void Start(const base::FilePath& path, StartCallback callback);
+  void Pause();
+  void Resume();
+  // Stops capturing and finishes writing the file. The recorder can be
+  // destroyed right after calling this, |callback| is still run once the
+  // file has been closed.
+  void Stop(StopCallback callback);
+
+  bool is_paused() const { return paused_; }
+
+  base::WeakPtr<WebContentsRecorder> GetWeakPtr() {
+    return weak_factory_.GetWeakPtr();
+  }
+
+ private:
+  void OnOpened(const std::string& error);
+  void OnFrameEncoded();
+
+  void AttachToHost(content::RenderWidgetHost* host);
+  void DetachFromHost();
+
+  // content::WebContentsObserver:
+  void RenderViewDeleted(content::RenderViewHost* host) override;
+  void RenderViewHostChanged(content::RenderViewHost* old_host,
+                             content::RenderViewHost* new_host) override;
+
+  // viz::mojom::FrameSinkVideoConsumer implementation.
+  void OnFrameCaptured(
+      base::ReadOnlySharedMemoryRegion data,
+      ::media::mojom::VideoFrameInfoPtr info,
+      const gfx::Rect& content_rect,
+      mojo::PendingRemote<viz::mojom::FrameSinkVideoConsumerFrameCallbacks>
+          callbacks) override;
+  void OnStopped() override;
+  void OnLog(const std::string& message) override;
+
+  // Get the pixel size of render view.
+  gfx::Size GetRenderViewSize() const;
+
+  Options options_;
+  Stats stats_;
+  // Set while the file is being opened.
+  StartCallback start_callback_;
+  bool started_ = false;
+  bool paused_ = false;
+  bool request_key_frame_ = true;
+  int frames_in_flight_ = 0;
+  // The size of the recording, fixed when capturing starts.
+  gfx::Size frame_size_;
+
+  content::RenderWidgetHost* host_ = nullptr;
+  std::unique_ptr<viz::ClientFrameSinkVideoCapturer> video_capturer_;
+
+  scoped_refptr<base::SequencedTaskRunner> encoder_task_runner_;
+  std::unique_ptr<WebMEncoder, base::OnTaskRunnerDeleter> encoder_;
+
+  base::WeakPtrFactory<WebContentsRecorder> weak_factory_{this};
+
+  DISALLOW_COPY_AND_ASSIGN(WebContentsRecorder);
+};
+
+}  // namespace api
+
+}  // namespace electron
+
+#endif  // SHELL_BROWSER_API_WEB_CONTENTS_RECORDER_H_
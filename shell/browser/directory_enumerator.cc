@@ -0,0 +1,144 @@
+// Copyright (c) 2021 GitHub, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#include "shell/browser/directory_enumerator.h"
+
+#include <utility>
+
+#include "base/bind.h"
+#include "base/containers/stack.h"
+#include "base/files/file_enumerator.h"
+#include "base/files/file_util.h"
+#include "base/sequenced_task_runner.h"
+#include "base/strings/pattern.h"
+#include "base/task/thread_pool.h"
+#include "base/threading/sequenced_task_runner_handle.h"
+
+namespace electron {
+
+namespace {
+
+bool IsIgnored(const base::FilePath& path,
+               const std::vector<std::string>& patterns) {
+  if (patterns.empty())
+    return false;
+  std::string name = path.BaseName().AsUTF8Unsafe();
+  for (const auto& pattern : patterns) {
+    if (base::MatchPattern(name, pattern))
+      return true;
+  }
+  return false;
+}
+
+}  // namespace
+
+DirectoryEnumerator::Options::Options() = default;
+DirectoryEnumerator::Options::Options(const Options&) = default;
+DirectoryEnumerator::Options::~Options() = default;
+
+DirectoryEnumerator::DirectoryEnumerator(const base::FilePath& root,
+                                         const Options& options)
+    : root_(root),
+      options_(options),
+      canceled_(base::MakeRefCounted<CancellationFlag>()) {
+  if (options_.batch_size == 0)
+    options_.batch_size = 1;
+}
+
+DirectoryEnumerator::~DirectoryEnumerator() {
+  Cancel();
+}
+
+void DirectoryEnumerator::Start(BatchCallback batch_callback,
+                                DoneCallback done_callback) {
+  DCHECK(!done_callback_);
+  batch_callback_ = std::move(batch_callback);
+  done_callback_ = std::move(done_callback);
+  base::ThreadPool::PostTask(
+      FROM_HERE,
+      {base::MayBlock(), base::TaskPriority::USER_BLOCKING,
+       base::TaskShutdownBehavior::SKIP_ON_SHUTDOWN},
+      base::BindOnce(&DirectoryEnumerator::EnumerateOnWorker, root_, options_,
+                     canceled_, base::SequencedTaskRunnerHandle::Get(),
+                     weak_factory_.GetWeakPtr()));
+}
+
+void DirectoryEnumerator::Cancel() {
+  canceled_->data.Set();
+  weak_factory_.InvalidateWeakPtrs();
+  batch_callback_.Reset();
+  done_callback_.Reset();
+}
+
+// static
+void DirectoryEnumerator::EnumerateOnWorker(
+    const base::FilePath& root,
+    const Options& options,
+    scoped_refptr<CancellationFlag> canceled,
+    scoped_refptr<base::SequencedTaskRunner> reply_task_runner,
+    base::WeakPtr<DirectoryEnumerator> enumerator) {
+  std::vector<base::FilePath> batch;
+  size_t file_count = 0;
+  bool truncated = false;
+
+  // Walk the tree depth first with an explicit stack, rather than with a
+  // recursive base::FileEnumerator, so ignored directories can be pruned.
+  base::stack<base::FilePath> pending_dirs;
+  pending_dirs.push(root);
+  while (!pending_dirs.empty() && !truncated) {
+    if (canceled->data.IsSet())
+      return;
+
+    base::FilePath dir = pending_dirs.top();
+    pending_dirs.pop();
+    base::FileEnumerator file_enum(
+        dir, false,
+        base::FileEnumerator::FILES | base::FileEnumerator::DIRECTORIES);
+    for (base::FilePath path = file_enum.Next(); !path.empty();
+         path = file_enum.Next()) {
+      if (IsIgnored(path, options.ignore_patterns))
+        continue;
+
+      if (file_enum.GetInfo().IsDirectory()) {
+        if (!base::IsLink(path))
+          pending_dirs.push(path);
+        continue;
+      }
+
+      if (options.max_files && file_count >= options.max_files) {
+        truncated = true;
+        break;
+      }
+
+      batch.push_back(path);
+      ++file_count;
+      if (batch.size() >= options.batch_size) {
+        reply_task_runner->PostTask(
+            FROM_HERE, base::BindOnce(&DirectoryEnumerator::OnBatch,
+                                      enumerator, std::move(batch)));
+        batch = std::vector<base::FilePath>();
+      }
+    }
+  }
+
+  if (!batch.empty()) {
+    reply_task_runner->PostTask(
+        FROM_HERE, base::BindOnce(&DirectoryEnumerator::OnBatch, enumerator,
+                                  std::move(batch)));
+  }
+  reply_task_runner->PostTask(
+      FROM_HERE,
+      base::BindOnce(&DirectoryEnumerator::OnDone, enumerator, truncated));
+}
+
+void DirectoryEnumerator::OnBatch(std::vector<base::FilePath> paths) {
+  batch_callback_.Run(std::move(paths));
+}
+
+void DirectoryEnumerator::OnDone(bool truncated) {
+  batch_callback_.Reset();
+  std::move(done_callback_).Run(truncated);
+}
+
+}  // namespace electron
@@ -0,0 +1,84 @@
+// Copyright (c) 2021 GitHub, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#ifndef SHELL_BROWSER_DIRECTORY_ENUMERATOR_H_
+#define SHELL_BROWSER_DIRECTORY_ENUMERATOR_H_
+
+#include <string>
+#include <vector>
+
+#include "base/callback.h"
+#include "base/files/file_path.h"
+#include "base/macros.h"
+#include "base/memory/ref_counted.h"
+#include "base/memory/weak_ptr.h"
+#include "base/sequenced_task_runner.h"
+#include "base/synchronization/atomic_flag.h"
+
+namespace electron {
+
+// Lists the files below a directory on a worker sequence and reports them to
+// the calling sequence in batches, so that huge directories neither block the
+// caller nor have to be held in memory twice. Symbolic links to directories
+// are not followed.
+class DirectoryEnumerator {
+ public:
+  struct Options {
+    Options();
+    Options(const Options&);
+    ~Options();
+
+    // Stop after this many files have been found, 0 means no limit.
+    size_t max_files = 0;
+    // Glob patterns matched against the name of every file and directory,
+    // matching files are skipped and matching directories are not entered.
+    std::vector<std::string> ignore_patterns;
+    // The maximum number of paths reported at once.
+    size_t batch_size = 1000;
+  };
+
+  using BatchCallback =
+      base::RepeatingCallback<void(std::vector<base::FilePath> paths)>;
+  // |truncated| is true when the enumeration stopped at |max_files|.
+  using DoneCallback = base::OnceCallback<void(bool truncated)>;
+
+  DirectoryEnumerator(const base::FilePath& root, const Options& options);
+  // Cancels the enumeration if it is still running.
+  ~DirectoryEnumerator();
+
+  // Starts listing files. |batch_callback| is run for every batch of files
+  // and |done_callback| once all files have been reported.
+  void Start(BatchCallback batch_callback, DoneCallback done_callback);
+
+  // Stops the enumeration, no callback is run after this returns.
+  void Cancel();
+
+ private:
+  using CancellationFlag = base::RefCountedData<base::AtomicFlag>;
+
+  static void EnumerateOnWorker(
+      const base::FilePath& root,
+      const Options& options,
+      scoped_refptr<CancellationFlag> canceled,
+      scoped_refptr<base::SequencedTaskRunner> reply_task_runner,
+      base::WeakPtr<DirectoryEnumerator> enumerator);
+
+  void OnBatch(std::vector<base::FilePath> paths);
+  void OnDone(bool truncated);
+
+  base::FilePath root_;
+  Options options_;
+  scoped_refptr<CancellationFlag> canceled_;
+
+  BatchCallback batch_callback_;
+  DoneCallback done_callback_;
+
+  base::WeakPtrFactory<DirectoryEnumerator> weak_factory_{this};
+
+  DISALLOW_COPY_AND_ASSIGN(DirectoryEnumerator);
+};
+
+}  // namespace electron
+
+#endif  // SHELL_BROWSER_DIRECTORY_ENUMERATOR_H_
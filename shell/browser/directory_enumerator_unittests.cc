@@ -0,0 +1,136 @@
+// Copyright (c) 2021 GitHub, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#include "shell/browser/directory_enumerator.h"
+
+#include <string>
+#include <vector>
+
+#include "base/bind.h"
+#include "base/files/file_util.h"
+#include "base/files/scoped_temp_dir.h"
+#include "base/run_loop.h"
+#include "base/strings/string_number_conversions.h"
+#include "base/test/task_environment.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace electron {
+
+namespace {
+
+class DirectoryEnumeratorTest : public testing::Test {
+ protected:
+  void SetUp() override { ASSERT_TRUE(temp_dir_.CreateUniqueTempDir()); }
+
+  // Creates |depth| nested directories with |files_per_dir| files each.
+  void CreateTree(const base::FilePath& root, int depth, int files_per_dir) {
+    base::FilePath dir = root;
+    for (int i = 0; i < depth; ++i) {
+      dir = dir.AppendASCII("dir" + base::NumberToString(i));
+      ASSERT_TRUE(base::CreateDirectory(dir));
+      for (int j = 0; j < files_per_dir; ++j)
+        ASSERT_TRUE(base::WriteFile(
+            dir.AppendASCII("file" + base::NumberToString(j) + ".txt"), "x"));
+    }
+  }
+
+  void Enumerate(const DirectoryEnumerator::Options& options) {
+    DirectoryEnumerator enumerator(temp_dir_.GetPath(), options);
+    base::RunLoop run_loop;
+    enumerator.Start(
+        base::BindRepeating(
+            [](DirectoryEnumeratorTest* self,
+               std::vector<base::FilePath> paths) {
+              self->batches_++;
+              for (auto& path : paths)
+                self->paths_.push_back(path);
+            },
+            base::Unretained(this)),
+        base::BindOnce(
+            [](DirectoryEnumeratorTest* self, base::OnceClosure quit,
+               bool truncated) {
+              self->truncated_ = truncated;
+              std::move(quit).Run();
+            },
+            base::Unretained(this), run_loop.QuitClosure()));
+    run_loop.Run();
+  }
+
+  base::test::TaskEnvironment task_environment_;
+  base::ScopedTempDir temp_dir_;
+
+  std::vector<base::FilePath> paths_;
+  int batches_ = 0;
+  bool truncated_ = false;
+};
+
+}  // namespace
+
+TEST_F(DirectoryEnumeratorTest, ListsDeepTreeInBatches) {
+  CreateTree(temp_dir_.GetPath(), 50, 20);
+
+  DirectoryEnumerator::Options options;
+  options.batch_size = 100;
+  Enumerate(options);
+
+  EXPECT_EQ(1000u, paths_.size());
+  EXPECT_EQ(10, batches_);
+  EXPECT_FALSE(truncated_);
+}
+
+TEST_F(DirectoryEnumeratorTest, StopsAtMaxFiles) {
+  CreateTree(temp_dir_.GetPath(), 10, 10);
+
+  DirectoryEnumerator::Options options;
+  options.max_files = 25;
+  Enumerate(options);
+
+  EXPECT_EQ(25u, paths_.size());
+  EXPECT_TRUE(truncated_);
+}
+
+TEST_F(DirectoryEnumeratorTest, NotTruncatedWhenExactlyMaxFiles) {
+  CreateTree(temp_dir_.GetPath(), 5, 5);
+
+  DirectoryEnumerator::Options options;
+  options.max_files = 25;
+  Enumerate(options);
+
+  EXPECT_EQ(25u, paths_.size());
+  EXPECT_FALSE(truncated_);
+}
+
+TEST_F(DirectoryEnumeratorTest, SkipsIgnoredFilesAndDirectories) {
+  CreateTree(temp_dir_.GetPath(), 3, 2);
+  CreateTree(temp_dir_.GetPath().AppendASCII("node_modules"), 3, 2);
+  ASSERT_TRUE(base::WriteFile(temp_dir_.GetPath().AppendASCII("a.log"), "x"));
+
+  DirectoryEnumerator::Options options;
+  options.ignore_patterns = {"node_modules", "*.log"};
+  Enumerate(options);
+
+  EXPECT_EQ(6u, paths_.size());
+  for (const auto& path : paths_) {
+    EXPECT_EQ(std::string::npos, path.AsUTF8Unsafe().find("node_modules"));
+    EXPECT_NE(FILE_PATH_LITERAL(".log"), path.Extension());
+  }
+}
+
+TEST_F(DirectoryEnumeratorTest, NoCallbacksAfterCancel) {
+  CreateTree(temp_dir_.GetPath(), 20, 20);
+
+  DirectoryEnumerator::Options options;
+  options.batch_size = 1;
+  DirectoryEnumerator enumerator(temp_dir_.GetPath(), options);
+  bool done = false;
+  enumerator.Start(
+      base::BindRepeating([](std::vector<base::FilePath>) {}),
+      base::BindOnce([](bool* done, bool) { *done = true; }, &done));
+  enumerator.Cancel();
+  task_environment_.RunUntilIdle();
+
+  EXPECT_FALSE(done);
+}
+
+}  // namespace electron
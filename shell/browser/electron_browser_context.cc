@@ -44,6 +44,7 @@
 #include "shell/browser/electron_download_manager_delegate.h"
 #include "shell/browser/electron_permission_manager.h"
 #include "shell/browser/net/resolve_proxy_helper.h"
+#include "shell/browser/net/traffic_shaper.h"
 #include "shell/browser/pref_store_delegate.h"
 #include "shell/browser/protocol_registry.h"
 #include "shell/browser/special_storage_policy.h"
@@ -107,6 +108,7 @@ ElectronBrowserContext::ElectronBrowserContext(const std::string& partition,
                                                base::DictionaryValue options)
     : storage_policy_(new SpecialStoragePolicy),
       protocol_registry_(new ProtocolRegistry),
+      traffic_shaper_(new TrafficShaper),
       in_memory_(in_memory),
       ssl_config_(network::mojom::SSLConfig::New()) {
   user_agent_ = ElectronBrowserClient::Get()->GetUserAgent();
@@ -47,6 +47,7 @@ class ResolveProxyHelper;
 class SpecialStoragePolicy;
 class WebViewManager;
 class ProtocolRegistry;
+class TrafficShaper;
 
 class ElectronBrowserContext
     : public content::BrowserContext,
@@ -140,6 +141,8 @@ class ElectronBrowserContext
     return protocol_registry_.get();
   }
 
+  TrafficShaper* traffic_shaper() const { return traffic_shaper_.get(); }
+
   void SetSSLConfig(network::mojom::SSLConfigPtr config);
   network::mojom::SSLConfigPtr GetSSLConfig();
   void SetSSLConfigClient(mojo::Remote<network::mojom::SSLConfigClient> client);
@@ -171,6 +174,7 @@ class ElectronBrowserContext
   scoped_refptr<storage::SpecialStoragePolicy> storage_policy_;
   std::unique_ptr<predictors::PreconnectManager> preconnect_manager_;
   std::unique_ptr<ProtocolRegistry> protocol_registry_;
+  std::unique_ptr<TrafficShaper> traffic_shaper_;
 
   std::string user_agent_;
   base::FilePath path_;
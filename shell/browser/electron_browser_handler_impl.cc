@@ -130,6 +130,15 @@ void ElectronBrowserHandlerImpl::DoGetZoomLevel(
   }
 }
 
+void ElectronBrowserHandlerImpl::OnNearHeapLimit(uint64_t heap_limit,
+                                                 uint64_t raised_heap_limit) {
+  api::WebContents* api_web_contents = api::WebContents::From(web_contents());
+  if (api_web_contents) {
+    api_web_contents->OnNearHeapLimit(heap_limit, raised_heap_limit,
+                                      GetRenderFrameHost());
+  }
+}
+
 content::RenderFrameHost* ElectronBrowserHandlerImpl::GetRenderFrameHost() {
   return content::RenderFrameHost::FromID(render_process_id_, render_frame_id_);
 }
@@ -54,6 +54,8 @@ class ElectronBrowserHandlerImpl : public mojom::ElectronBrowser,
       std::vector<mojom::DraggableRegionPtr> regions) override;
   void SetTemporaryZoomLevel(double level) override;
   void DoGetZoomLevel(DoGetZoomLevelCallback callback) override;
+  void OnNearHeapLimit(uint64_t heap_limit,
+                       uint64_t raised_heap_limit) override;
 
   base::WeakPtr<ElectronBrowserHandlerImpl> GetWeakPtr() {
     return weak_factory_.GetWeakPtr();
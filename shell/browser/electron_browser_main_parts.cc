@@ -61,6 +61,7 @@
 #include "base/environment.h"
 #include "base/nix/xdg_util.h"
 #include "base/threading/thread_task_runner_handle.h"
+#include "shell/browser/linux/headless_util.h"
 #include "ui/gtk/gtk_ui.h"
 #include "ui/gtk/gtk_ui_delegate.h"
 #include "ui/gtk/gtk_util.h"
@@ -290,7 +291,8 @@ int ElectronBrowserMainParts::PreCreateThreads() {
   display::Screen* screen = views::CreateDesktopScreen();
   display::Screen::SetScreenInstance(screen);
 #if defined(OS_LINUX)
-  views::LinuxUI::instance()->UpdateDeviceScaleFactor();
+  if (auto* linux_ui = views::LinuxUI::instance())
+    linux_ui->UpdateDeviceScaleFactor();
 #endif
 #endif
 
@@ -358,6 +360,9 @@ int ElectronBrowserMainParts::PreCreateThreads() {
 }
 
 void ElectronBrowserMainParts::PostCreateThreads() {
+  // The ThreadPool runs tasks from now on.
+  js_env_->UseThreadPoolForWorkerTasks();
+
   base::PostTask(
       FROM_HERE, {content::BrowserThread::IO},
       base::BindOnce(&tracing::TracingSamplerProfiler::CreateOnChildThread));
@@ -385,19 +390,23 @@ void ElectronBrowserMainParts::ToolkitInitialized() {
   }
 #endif
 #if defined(OS_LINUX)
-  views::LinuxUI* linux_ui = BuildGtkUi(ui::GtkUiDelegate::instance());
-  views::LinuxUI::SetInstance(linux_ui);
-  linux_ui->Initialize();
-
-  // Chromium does not respect GTK dark theme setting, but they may change
-  // in future and this code might be no longer needed. Check the Chromium
-  // issue to keep updated:
-  // https://bugs.chromium.org/p/chromium/issues/detail?id=998903
-  UpdateDarkThemeSetting();
-  // Update the native theme when GTK theme changes. The GetNativeTheme
-  // here returns a NativeThemeGtk, which monitors GTK settings.
-  dark_theme_observer_.reset(new DarkThemeObserver);
-  linux_ui->GetNativeTheme(nullptr)->AddObserver(dark_theme_observer_.get());
+  // GTK can not be initialized without a display, in headless mode there is
+  // no LinuxUI and the default native theme is used.
+  if (!IsHeadlessOzonePlatform()) {
+    views::LinuxUI* linux_ui = BuildGtkUi(ui::GtkUiDelegate::instance());
+    views::LinuxUI::SetInstance(linux_ui);
+    linux_ui->Initialize();
+
+    // Chromium does not respect GTK dark theme setting, but they may change
+    // in future and this code might be no longer needed. Check the Chromium
+    // issue to keep updated:
+    // https://bugs.chromium.org/p/chromium/issues/detail?id=998903
+    UpdateDarkThemeSetting();
+    // Update the native theme when GTK theme changes. The GetNativeTheme
+    // here returns a NativeThemeGtk, which monitors GTK settings.
+    dark_theme_observer_.reset(new DarkThemeObserver);
+    linux_ui->GetNativeTheme(nullptr)->AddObserver(dark_theme_observer_.get());
+  }
 #endif
 
 #if defined(USE_AURA)
@@ -16,6 +16,11 @@
 #include "net/base/features.h"
 #include "services/network/public/cpp/features.h"
 
+#if defined(OS_LINUX)
+#include "shell/browser/linux/headless_util.h"
+#include "ui/base/ui_base_features.h"
+#endif
+
 namespace electron {
 
 void InitializeFeatureList() {
@@ -44,6 +49,13 @@ void InitializeFeatureList() {
   // enabled, since Electron does not support origin trials.
   enable_features += std::string(",") + "WebComponentsV0Enabled";
 
+#if defined(OS_LINUX) && defined(USE_OZONE)
+  // --ozone-platform is ignored unless the Ozone platform is enabled, so turn
+  // it on implicitly when running headless.
+  if (IsHeadlessOzonePlatform())
+    enable_features += std::string(",") + features::kUseOzonePlatform.name;
+#endif
+
 #if !BUILDFLAG(ENABLE_PICTURE_IN_PICTURE)
   disable_features += std::string(",") + media::kPictureInPicture.name;
 #endif
@@ -16,6 +16,7 @@
 #include "base/strings/utf_string_conversions.h"
 #include "chrome/common/pref_names.h"
 #include "components/prefs/pref_service.h"
+#include "shell/browser/api/electron_api_web_contents.h"
 #include "shell/browser/electron_browser_context.h"
 #include "shell/browser/javascript_environment.h"
 #include "shell/browser/ui/file_dialog.h"
@@ -79,9 +80,7 @@ void FileSelectHelper::ShowSaveDialog(
   file_dialog::ShowSaveDialog(settings, std::move(promise));
 }
 
-// net::DirectoryLister::DirectoryListerDelegate
-void FileSelectHelper::OnListFile(
-    const net::DirectoryLister::DirectoryListerData& data) {
+void FileSelectHelper::OnListFiles(std::vector<base::FilePath> paths) {
   if (!render_frame_host_ || !web_contents_) {
     // If the frame or webcontents was destroyed under us. We
     // must notify |listener_| and release our reference to
@@ -89,11 +88,13 @@ void FileSelectHelper::OnListFile(
     RunFileChooserEnd();
     return;
   }
-  // We don't want to return directory paths, only file paths
-  if (data.info.IsDirectory())
-    return;
 
-  lister_paths_.push_back(data.path);
+  for (auto& path : paths)
+    lister_files_.push_back(FileChooserFileInfo::NewNativeFile(
+        NativeFileInfo::New(std::move(path), std::u16string())));
+
+  if (EmitEnumerationProgress(false, false))
+    RunFileChooserEnd();
 }
 
 void FileSelectHelper::RunFileChooserEnd() {
@@ -112,8 +113,7 @@ void FileSelectHelper::RunFileChooserEnd() {
   delete this;
 }
 
-// net::DirectoryLister::DirectoryListerDelegate
-void FileSelectHelper::OnListDone(int error) {
+void FileSelectHelper::OnListDone(bool truncated) {
   if (!render_frame_host_ || !web_contents_) {
     // If the frame or webcontents was destroyed under us. We
     // must notify |listener_| and release our reference to
@@ -122,12 +122,28 @@ void FileSelectHelper::OnListDone(int error) {
     return;
   }
 
-  std::vector<FileChooserFileInfoPtr> file_info;
-  for (const auto& path : lister_paths_)
-    file_info.push_back(FileChooserFileInfo::NewNativeFile(
-        NativeFileInfo::New(path, std::u16string())));
+  if (EmitEnumerationProgress(true, truncated)) {
+    RunFileChooserEnd();
+    return;
+  }
 
-  OnFilesSelected(std::move(file_info), lister_base_dir_);
+  OnFilesSelected(std::move(lister_files_), lister_base_dir_);
+}
+
+bool FileSelectHelper::EmitEnumerationProgress(bool done, bool truncated) {
+  auto* api_web_contents = electron::api::WebContents::From(web_contents_);
+  if (!api_web_contents)
+    return false;
+
+  v8::Isolate* isolate = electron::JavascriptEnvironment::GetIsolate();
+  v8::HandleScope scope(isolate);
+  gin_helper::Dictionary details = gin::Dictionary::CreateEmpty(isolate);
+  details.Set("path", lister_base_dir_);
+  details.Set("fileCount", static_cast<int>(lister_files_.size()));
+  details.Set("done", done);
+  details.Set("truncated", truncated);
+  // Calling preventDefault() on the event cancels the upload.
+  return api_web_contents->Emit("directory-enumeration-progress", details);
 }
 
 void FileSelectHelper::DeleteTemporaryFiles() {
@@ -142,11 +158,20 @@ void FileSelectHelper::EnumerateDirectory() {
   // Ensure that this fn is only called once
   DCHECK(!lister_);
   DCHECK(!lister_base_dir_.empty());
-  DCHECK(lister_paths_.empty());
-
-  lister_ = std::make_unique<net::DirectoryLister>(
-      lister_base_dir_, net::DirectoryLister::NO_SORT_RECURSIVE, this);
-  lister_->Start();
+  DCHECK(lister_files_.empty());
+
+  electron::DirectoryEnumerator::Options options;
+  if (auto* api_web_contents = electron::api::WebContents::From(web_contents_))
+    options = api_web_contents->directory_enumeration_options();
+
+  // Files are reported in batches from a worker sequence so that large
+  // folders neither block the UI thread nor get copied once more at the end.
+  lister_ = std::make_unique<electron::DirectoryEnumerator>(lister_base_dir_,
+                                                            options);
+  lister_->Start(base::BindRepeating(&FileSelectHelper::OnListFiles,
+                                     base::Unretained(this)),
+                 base::BindOnce(&FileSelectHelper::OnListDone,
+                                base::Unretained(this)));
 }
 
 void FileSelectHelper::OnOpenDialogDone(gin_helper::Dictionary result) {
@@ -22,7 +22,7 @@
 #include "content/public/browser/web_contents.h"
 #include "content/public/browser/web_contents_observer.h"
 #include "gin/dictionary.h"
-#include "net/base/directory_lister.h"
+#include "shell/browser/directory_enumerator.h"
 #include "shell/browser/electron_browser_context.h"
 #include "shell/browser/ui/file_dialog.h"
 #include "shell/common/gin_helper/dictionary.h"
@@ -31,8 +31,7 @@
 using blink::mojom::FileChooserParams;
 
 class FileSelectHelper : public content::WebContentsObserver,
-                         public content::RenderWidgetHostObserver,
-                         public net::DirectoryLister::DirectoryListerDelegate {
+                         public content::RenderWidgetHostObserver {
  public:
   FileSelectHelper(content::RenderFrameHost* render_frame_host,
                    scoped_refptr<content::FileSelectListener> listener,
@@ -46,10 +45,13 @@ class FileSelectHelper : public content::WebContentsObserver,
   void ShowSaveDialog(const file_dialog::DialogSettings& settings);
 
  private:
-  // net::DirectoryLister::DirectoryListerDelegate overrides.
-  void OnListFile(
-      const net::DirectoryLister::DirectoryListerData& data) override;
-  void OnListDone(int error) override;
+  // electron::DirectoryEnumerator callbacks.
+  void OnListFiles(std::vector<base::FilePath> paths);
+  void OnListDone(bool truncated);
+
+  // Emits "directory-enumeration-progress" on the WebContents, returns true
+  // if the enumeration should be canceled.
+  bool EmitEnumerationProgress(bool done, bool truncated);
 
   void DeleteTemporaryFiles();
 
@@ -107,10 +109,10 @@ class FileSelectHelper : public content::WebContentsObserver,
   // these files when they are no longer needed.
   std::vector<base::FilePath> temporary_files_;
 
-  // DirectoryLister-specific members
-  std::unique_ptr<net::DirectoryLister> lister_;
+  // DirectoryEnumerator-specific members
+  std::unique_ptr<electron::DirectoryEnumerator> lister_;
   base::FilePath lister_base_dir_;
-  std::vector<base::FilePath> lister_paths_;
+  std::vector<blink::mojom::FileChooserFileInfoPtr> lister_files_;
 
   base::WeakPtrFactory<FileSelectHelper> weak_ptr_factory_{this};
 };
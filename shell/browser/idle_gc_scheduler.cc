@@ -0,0 +1,106 @@
+// Copyright (c) 2021 GitHub, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#include "shell/browser/idle_gc_scheduler.h"
+
+#include <algorithm>
+#include <utility>
+
+#include "base/bind.h"
+#include "base/threading/thread_task_runner_handle.h"
+#include "base/trace_event/trace_event.h"
+
+namespace electron {
+
+IdleGCScheduler::IdleGCScheduler(v8::Isolate* isolate,
+                                 v8::Platform* platform,
+                                 uv_loop_t* event_loop)
+    : isolate_(isolate), platform_(platform), event_loop_(event_loop) {
+  ScheduleIdleCheck(kQuietPeriod);
+}
+
+IdleGCScheduler::~IdleGCScheduler() = default;
+
+void IdleGCScheduler::PostIdleTask(std::unique_ptr<v8::IdleTask> task) {
+  base::AutoLock auto_lock(lock_);
+  idle_tasks_.push(std::move(task));
+}
+
+void IdleGCScheduler::WillProcessTask(const base::PendingTask& pending_task,
+                                      bool was_blocked_or_low_priority) {}
+
+void IdleGCScheduler::DidProcessTask(const base::PendingTask& pending_task) {
+  // The idle check must not count as activity, or it would keep waking up
+  // the idle thread.
+  if (in_idle_check_) {
+    in_idle_check_ = false;
+    return;
+  }
+
+  ++tasks_since_idle_check_;
+  if (!idle_check_pending_)
+    ScheduleIdleCheck(kQuietPeriod);
+}
+
+void IdleGCScheduler::ScheduleIdleCheck(base::TimeDelta delay) {
+  idle_check_pending_ = true;
+  tasks_since_idle_check_ = 0;
+  base::ThreadTaskRunnerHandle::Get()->PostDelayedTask(
+      FROM_HERE,
+      base::BindOnce(&IdleGCScheduler::OnIdleCheck, weak_factory_.GetWeakPtr()),
+      delay);
+}
+
+void IdleGCScheduler::OnIdleCheck() {
+  idle_check_pending_ = false;
+  in_idle_check_ = true;
+
+  if (tasks_since_idle_check_ > 0) {
+    ScheduleIdleCheck(kQuietPeriod);
+    return;
+  }
+
+  // Pending libuv work or a timer that is due shortly will arrive as a task
+  // soon, which schedules the next check.
+  base::TimeDelta idle_period = kMaxIdlePeriod;
+  int uv_timeout = uv_backend_timeout(event_loop_);
+  if (uv_timeout >= 0) {
+    idle_period = std::min(idle_period,
+                           base::TimeDelta::FromMilliseconds(uv_timeout));
+  }
+  if (idle_period.is_zero())
+    return;
+
+  // Once V8 is done it is only given idle time again after some real work
+  // happened, so an idle app does not wake up for nothing.
+  if (!RunIdlePeriod(idle_period))
+    ScheduleIdleCheck(base::TimeDelta());
+}
+
+bool IdleGCScheduler::RunIdlePeriod(base::TimeDelta idle_period) {
+  TRACE_EVENT1("electron", "IdleGCScheduler::RunIdlePeriod", "idle_period_ms",
+               idle_period.InMillisecondsF());
+  double deadline_in_seconds =
+      platform_->MonotonicallyIncreasingTime() + idle_period.InSecondsF();
+
+  v8::HandleScope handle_scope(isolate_);
+  bool has_idle_tasks = true;
+  while (platform_->MonotonicallyIncreasingTime() < deadline_in_seconds) {
+    std::unique_ptr<v8::IdleTask> task;
+    {
+      base::AutoLock auto_lock(lock_);
+      has_idle_tasks = !idle_tasks_.empty();
+      if (!has_idle_tasks)
+        break;
+      task = std::move(idle_tasks_.front());
+      idle_tasks_.pop();
+    }
+    task->Run(deadline_in_seconds);
+  }
+
+  bool gc_done = isolate_->IdleNotificationDeadline(deadline_in_seconds);
+  return gc_done && !has_idle_tasks;
+}
+
+}  // namespace electron
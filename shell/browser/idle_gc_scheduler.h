@@ -0,0 +1,76 @@
+// Copyright (c) 2021 GitHub, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#ifndef SHELL_BROWSER_IDLE_GC_SCHEDULER_H_
+#define SHELL_BROWSER_IDLE_GC_SCHEDULER_H_
+
+#include <memory>
+
+#include "base/containers/queue.h"
+#include "base/macros.h"
+#include "base/memory/weak_ptr.h"
+#include "base/synchronization/lock.h"
+#include "base/task/task_observer.h"
+#include "base/time/time.h"
+#include "uv.h"  // NOLINT(build/include_directory)
+#include "v8/include/v8-platform.h"
+#include "v8/include/v8.h"
+
+namespace electron {
+
+// V8 only collects garbage when allocations force it to, which makes major
+// collections land in the middle of whatever the main process is doing.
+// This class finds the periods in which the UI thread is idle, meaning no
+// task ran for kQuietPeriod and libuv has nothing due, and hands them to V8
+// in bounded slices to run its idle tasks and garbage collection work.
+class IdleGCScheduler : public base::TaskObserver {
+ public:
+  // How long the UI thread has to be quiet to be considered idle.
+  static constexpr base::TimeDelta kQuietPeriod =
+      base::TimeDelta::FromMilliseconds(100);
+  // The longest slice of idle time given to V8 at once, which bounds how long
+  // a task arriving in the meantime has to wait.
+  static constexpr base::TimeDelta kMaxIdlePeriod =
+      base::TimeDelta::FromMilliseconds(10);
+
+  IdleGCScheduler(v8::Isolate* isolate,
+                  v8::Platform* platform,
+                  uv_loop_t* event_loop);
+  ~IdleGCScheduler() override;
+
+  // Queues a V8 idle task until the next idle period, can be called from any
+  // thread.
+  void PostIdleTask(std::unique_ptr<v8::IdleTask> task);
+
+  // base::TaskObserver:
+  void WillProcessTask(const base::PendingTask& pending_task,
+                       bool was_blocked_or_low_priority) override;
+  void DidProcessTask(const base::PendingTask& pending_task) override;
+
+ private:
+  void ScheduleIdleCheck(base::TimeDelta delay);
+  void OnIdleCheck();
+  // Returns whether V8 has no idle work left.
+  bool RunIdlePeriod(base::TimeDelta idle_period);
+
+  v8::Isolate* isolate_;
+  v8::Platform* platform_;
+  uv_loop_t* event_loop_;
+
+  bool idle_check_pending_ = false;
+  bool in_idle_check_ = false;
+  // Tasks that ran on the UI thread since the idle check was posted.
+  int tasks_since_idle_check_ = 0;
+
+  base::Lock lock_;
+  base::queue<std::unique_ptr<v8::IdleTask>> idle_tasks_;
+
+  base::WeakPtrFactory<IdleGCScheduler> weak_factory_{this};
+
+  DISALLOW_COPY_AND_ASSIGN(IdleGCScheduler);
+};
+
+}  // namespace electron
+
+#endif  // SHELL_BROWSER_IDLE_GC_SCHEDULER_H_
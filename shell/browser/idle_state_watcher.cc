@@ -0,0 +1,86 @@
+// Copyright (c) 2021 GitHub, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#include "shell/browser/idle_state_watcher.h"
+
+#include <algorithm>
+#include <utility>
+
+#include "base/bind.h"
+
+namespace electron {
+
+namespace {
+
+class SystemIdleTimeProvider : public IdleStateWatcher::IdleTimeProvider {
+ public:
+  SystemIdleTimeProvider() = default;
+  ~SystemIdleTimeProvider() override = default;
+
+  // IdleStateWatcher::IdleTimeProvider:
+  base::TimeDelta CalculateIdleTime() override {
+    return base::TimeDelta::FromSeconds(ui::CalculateIdleTime());
+  }
+  bool CheckIdleStateIsLocked() override {
+    return ui::CheckIdleStateIsLocked();
+  }
+
+ private:
+  DISALLOW_COPY_AND_ASSIGN(SystemIdleTimeProvider);
+};
+
+}  // namespace
+
+constexpr base::TimeDelta IdleStateWatcher::kMaxPollInterval;
+constexpr base::TimeDelta IdleStateWatcher::kIdlePollInterval;
+
+IdleStateWatcher::IdleStateWatcher(base::TimeDelta threshold,
+                                   Callback callback,
+                                   std::unique_ptr<IdleTimeProvider> provider)
+    : threshold_(threshold),
+      callback_(std::move(callback)),
+      provider_(provider ? std::move(provider)
+                         : std::make_unique<SystemIdleTimeProvider>()) {
+  Poll();
+}
+
+IdleStateWatcher::~IdleStateWatcher() = default;
+
+void IdleStateWatcher::SetThreshold(base::TimeDelta threshold) {
+  if (threshold == threshold_)
+    return;
+  threshold_ = threshold;
+  Poll();
+}
+
+void IdleStateWatcher::Poll() {
+  base::TimeDelta idle_time = provider_->CalculateIdleTime();
+  ui::IdleState state;
+  if (provider_->CheckIdleStateIsLocked())
+    state = ui::IDLE_STATE_LOCKED;
+  else if (idle_time >= threshold_)
+    state = ui::IDLE_STATE_IDLE;
+  else
+    state = ui::IDLE_STATE_ACTIVE;
+
+  bool initial_poll = state_ == ui::IDLE_STATE_UNKNOWN;
+  bool changed = state != state_;
+  state_ = state;
+
+  // The idle time grows by at most one second per second, so while active
+  // nothing can change before the threshold is reached, except a screen lock.
+  base::TimeDelta delay = kIdlePollInterval;
+  if (state == ui::IDLE_STATE_ACTIVE) {
+    delay = std::max(std::min(threshold_ - idle_time, kMaxPollInterval),
+                     kIdlePollInterval);
+  }
+  timer_.Start(FROM_HERE, delay,
+               base::BindOnce(&IdleStateWatcher::Poll, base::Unretained(this)));
+
+  // Run the callback last, it may destroy this watcher.
+  if (changed && !initial_poll)
+    callback_.Run(state, idle_time);
+}
+
+}  // namespace electron
@@ -0,0 +1,70 @@
+// Copyright (c) 2021 GitHub, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#ifndef SHELL_BROWSER_IDLE_STATE_WATCHER_H_
+#define SHELL_BROWSER_IDLE_STATE_WATCHER_H_
+
+#include <memory>
+
+#include "base/callback.h"
+#include "base/macros.h"
+#include "base/time/time.h"
+#include "base/timer/timer.h"
+#include "ui/base/idle/idle.h"
+
+namespace electron {
+
+// Reports changes of the system idle state for a given threshold. The idle
+// time is polled with a single timer whose delay adapts to the state: while
+// active, the next poll happens when the threshold could be reached at the
+// earliest, while idle, the idle time is polled often enough to notice the
+// user coming back quickly.
+class IdleStateWatcher {
+ public:
+  // Abstracts the platform idle queries so tests can provide their own.
+  class IdleTimeProvider {
+   public:
+    virtual ~IdleTimeProvider() = default;
+    virtual base::TimeDelta CalculateIdleTime() = 0;
+    virtual bool CheckIdleStateIsLocked() = 0;
+  };
+
+  using Callback = base::RepeatingCallback<void(ui::IdleState state,
+                                                base::TimeDelta idle_time)>;
+
+  // The longest time between two polls, which bounds how late a screen lock
+  // is noticed while the user is active.
+  static constexpr base::TimeDelta kMaxPollInterval =
+      base::TimeDelta::FromSeconds(10);
+  // The time between two polls while the system is idle or locked.
+  static constexpr base::TimeDelta kIdlePollInterval =
+      base::TimeDelta::FromSeconds(1);
+
+  // |callback| is run every time the state changes, the state found by the
+  // first poll is not reported. |provider| defaults to the ui::Calculate*
+  // functions.
+  IdleStateWatcher(base::TimeDelta threshold,
+                   Callback callback,
+                   std::unique_ptr<IdleTimeProvider> provider = nullptr);
+  ~IdleStateWatcher();
+
+  void SetThreshold(base::TimeDelta threshold);
+
+  ui::IdleState state() const { return state_; }
+
+ private:
+  void Poll();
+
+  base::TimeDelta threshold_;
+  Callback callback_;
+  std::unique_ptr<IdleTimeProvider> provider_;
+  ui::IdleState state_ = ui::IDLE_STATE_UNKNOWN;
+  base::OneShotTimer timer_;
+
+  DISALLOW_COPY_AND_ASSIGN(IdleStateWatcher);
+};
+
+}  // namespace electron
+
+#endif  // SHELL_BROWSER_IDLE_STATE_WATCHER_H_
@@ -0,0 +1,121 @@
+// Copyright (c) 2021 GitHub, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#include "shell/browser/idle_state_watcher.h"
+
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "base/bind.h"
+#include "base/test/task_environment.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace electron {
+
+namespace {
+
+// Reports an idle time that grows with the mock clock since the last
+// simulated user activity.
+class FakeIdleTimeProvider : public IdleStateWatcher::IdleTimeProvider {
+ public:
+  explicit FakeIdleTimeProvider(const base::TickClock* clock)
+      : clock_(clock), last_activity_(clock->NowTicks()) {}
+
+  void SimulateActivity() { last_activity_ = clock_->NowTicks(); }
+  void set_locked(bool locked) { locked_ = locked; }
+  int poll_count() const { return poll_count_; }
+
+  // IdleStateWatcher::IdleTimeProvider:
+  base::TimeDelta CalculateIdleTime() override {
+    ++poll_count_;
+    return clock_->NowTicks() - last_activity_;
+  }
+  bool CheckIdleStateIsLocked() override { return locked_; }
+
+ private:
+  const base::TickClock* clock_;
+  base::TimeTicks last_activity_;
+  bool locked_ = false;
+  int poll_count_ = 0;
+};
+
+class IdleStateWatcherTest : public testing::Test {
+ protected:
+  void CreateWatcher(base::TimeDelta threshold) {
+    auto provider = std::make_unique<FakeIdleTimeProvider>(
+        task_environment_.GetMockTickClock());
+    provider_ = provider.get();
+    watcher_ = std::make_unique<IdleStateWatcher>(
+        threshold,
+        base::BindRepeating(
+            [](std::vector<ui::IdleState>* states, ui::IdleState state,
+               base::TimeDelta idle_time) { states->push_back(state); },
+            &states_),
+        std::move(provider));
+  }
+
+  base::test::TaskEnvironment task_environment_{
+      base::test::TaskEnvironment::TimeSource::MOCK_TIME};
+  FakeIdleTimeProvider* provider_ = nullptr;
+  std::unique_ptr<IdleStateWatcher> watcher_;
+  std::vector<ui::IdleState> states_;
+};
+
+}  // namespace
+
+TEST_F(IdleStateWatcherTest, ReportsIdleAfterThreshold) {
+  CreateWatcher(base::TimeDelta::FromSeconds(60));
+  EXPECT_EQ(ui::IDLE_STATE_ACTIVE, watcher_->state());
+
+  task_environment_.FastForwardBy(base::TimeDelta::FromSeconds(59));
+  EXPECT_TRUE(states_.empty());
+
+  task_environment_.FastForwardBy(base::TimeDelta::FromSeconds(2));
+  ASSERT_EQ(1u, states_.size());
+  EXPECT_EQ(ui::IDLE_STATE_IDLE, states_[0]);
+}
+
+TEST_F(IdleStateWatcherTest, ReportsActivityWhileIdle) {
+  CreateWatcher(base::TimeDelta::FromSeconds(5));
+  task_environment_.FastForwardBy(base::TimeDelta::FromSeconds(10));
+  ASSERT_EQ(1u, states_.size());
+
+  provider_->SimulateActivity();
+  task_environment_.FastForwardBy(IdleStateWatcher::kIdlePollInterval);
+  ASSERT_EQ(2u, states_.size());
+  EXPECT_EQ(ui::IDLE_STATE_ACTIVE, states_[1]);
+}
+
+TEST_F(IdleStateWatcherTest, ReportsLock) {
+  CreateWatcher(base::TimeDelta::FromSeconds(600));
+  provider_->set_locked(true);
+  task_environment_.FastForwardBy(IdleStateWatcher::kMaxPollInterval);
+  ASSERT_EQ(1u, states_.size());
+  EXPECT_EQ(ui::IDLE_STATE_LOCKED, states_[0]);
+}
+
+TEST_F(IdleStateWatcherTest, PollsRarelyWhileActive) {
+  CreateWatcher(base::TimeDelta::FromSeconds(300));
+  // Keep the user active, the watcher should only wake up every
+  // kMaxPollInterval rather than every second.
+  for (int i = 0; i < 6; ++i) {
+    task_environment_.FastForwardBy(base::TimeDelta::FromSeconds(10));
+    provider_->SimulateActivity();
+  }
+  EXPECT_TRUE(states_.empty());
+  EXPECT_LE(provider_->poll_count(), 7);
+}
+
+TEST_F(IdleStateWatcherTest, SetThresholdRepolls) {
+  CreateWatcher(base::TimeDelta::FromSeconds(60));
+  task_environment_.FastForwardBy(base::TimeDelta::FromSeconds(5));
+  EXPECT_TRUE(states_.empty());
+
+  watcher_->SetThreshold(base::TimeDelta::FromSeconds(3));
+  ASSERT_EQ(1u, states_.size());
+  EXPECT_EQ(ui::IDLE_STATE_IDLE, states_[0]);
+}
+
+}  // namespace electron
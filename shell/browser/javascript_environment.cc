@@ -4,6 +4,8 @@
 
 #include "shell/browser/javascript_environment.h"
 
+#include <atomic>
+#include <map>
 #include <memory>
 #include <string>
 #include <unordered_set>
@@ -11,20 +13,36 @@
 
 #include "base/allocator/partition_allocator/partition_alloc.h"
 #include "base/command_line.h"
+#include "base/feature_list.h"
+#include "base/synchronization/lock.h"
 #include "base/task/current_thread.h"
-#include "base/task/thread_pool/initialization_util.h"
 #include "base/threading/thread_task_runner_handle.h"
 #include "base/trace_event/trace_event.h"
 #include "content/public/common/content_switches.h"
 #include "gin/array_buffer.h"
+#include "gin/per_isolate_data.h"
+#include "gin/public/v8_platform.h"
 #include "gin/v8_initializer.h"
+#include "shell/browser/idle_gc_scheduler.h"
 #include "shell/browser/microtasks_runner.h"
 #include "shell/common/gin_helper/cleaned_up_at_exit.h"
 #include "shell/common/node_includes.h"
 #include "tracing/trace_event.h"
+#include "v8/include/libplatform/libplatform.h"
+
+namespace features {
+
+const base::Feature kIdleTimeGarbageCollection{
+    "IdleTimeGarbageCollection", base::FEATURE_ENABLED_BY_DEFAULT};
+}
 
 namespace {
 v8::Isolate* g_isolate;
+ThreadPoolPlatform* g_platform;
+
+// Worker threads of Node's platform, which runs V8 background tasks until
+// Chromium's ThreadPool takes over.
+constexpr int kStartupWorkerThreads = 2;
 }
 
 namespace gin {
@@ -144,7 +162,8 @@ class ArrayBufferAllocator : public v8::ArrayBuffer::Allocator {
 base::NoDestructor<base::PartitionAllocator> ArrayBufferAllocator::allocator_{};
 
 JavascriptEnvironment::JavascriptEnvironment(uv_loop_t* event_loop)
-    : isolate_(Initialize(event_loop)),
+    : event_loop_(event_loop),
+      isolate_(Initialize(event_loop)),
       isolate_holder_(base::ThreadTaskRunnerHandle::Get(),
                       gin::IsolateHolder::kSingleThread,
                       gin::IsolateHolder::kAllowAtomicsWait,
@@ -315,6 +334,326 @@ class TracingControllerImpl : public node::tracing::TracingController {
   DISALLOW_COPY_AND_ASSIGN(TracingControllerImpl);
 };
 
+class IdleTaskRunner;
+
+// Counts the worker tasks forwarded to gin's platform until they are done,
+// so that they can be waited on like the tasks of Node's own workers. It
+// uses libuv's primitives, as Node does, since the threads that drain tasks
+// are not allowed to wait on Chromium's.
+class PendingTaskCounter {
+ public:
+  PendingTaskCounter() {
+    CHECK_EQ(0, uv_mutex_init(&mutex_));
+    CHECK_EQ(0, uv_cond_init(&done_));
+  }
+  ~PendingTaskCounter() {
+    uv_cond_destroy(&done_);
+    uv_mutex_destroy(&mutex_);
+  }
+
+  void Increment() {
+    uv_mutex_lock(&mutex_);
+    ++count_;
+    uv_mutex_unlock(&mutex_);
+  }
+
+  void Decrement() {
+    uv_mutex_lock(&mutex_);
+    DCHECK_GT(count_, 0u);
+    if (--count_ == 0)
+      uv_cond_broadcast(&done_);
+    uv_mutex_unlock(&mutex_);
+  }
+
+  bool HasPendingTasks() {
+    uv_mutex_lock(&mutex_);
+    bool pending = count_ > 0;
+    uv_mutex_unlock(&mutex_);
+    return pending;
+  }
+
+  void Wait() {
+    uv_mutex_lock(&mutex_);
+    while (count_ > 0)
+      uv_cond_wait(&done_, &mutex_);
+    uv_mutex_unlock(&mutex_);
+  }
+
+ private:
+  uv_mutex_t mutex_;
+  uv_cond_t done_;
+  size_t count_ = 0;
+
+  DISALLOW_COPY_AND_ASSIGN(PendingTaskCounter);
+};
+
+// A task is done once it is destroyed, whether it ran or was dropped.
+class CountedTask : public v8::Task {
+ public:
+  CountedTask(std::unique_ptr<v8::Task> task, PendingTaskCounter* counter)
+      : task_(std::move(task)), counter_(counter) {
+    counter_->Increment();
+  }
+  ~CountedTask() override {
+    task_.reset();
+    counter_->Decrement();
+  }
+
+  // v8::Task:
+  void Run() override { task_->Run(); }
+
+ private:
+  std::unique_ptr<v8::Task> task_;
+  PendingTaskCounter* counter_;
+
+  DISALLOW_COPY_AND_ASSIGN(CountedTask);
+};
+
+// Node's platform runs V8 background tasks on its own worker threads, which
+// is needed while Chromium's ThreadPool does not run tasks yet. Afterwards
+// the worker tasks, including the workers of jobs, are forwarded to gin's
+// platform, so they share the ThreadPool with Chromium and are scheduled
+// with its priorities.
+// Foreground tasks and the isolate bookkeeping always stay with Node, except
+// for the idle tasks of the main isolate, which Node does not support.
+// Forwarded tasks are counted, so that DrainTasks() still waits for them,
+// except for low priority ones: the ThreadPool may not run BEST_EFFORT tasks
+// for a long time, and V8 cancels them itself when it tears an isolate down.
+// The isolates of worker threads can also get gin's per-isolate data, so the
+// Electron modules that are available in workers can be used there.
+class ThreadPoolPlatform : public node::MultiIsolatePlatform {
+ public:
+  explicit ThreadPoolPlatform(node::MultiIsolatePlatform* node_platform)
+      : node_platform_(node_platform) {}
+  ~ThreadPoolPlatform() override = default;
+
+  void UseThreadPool() { use_thread_pool_ = true; }
+
+  // Routes the idle tasks of |isolate| to the scheduler passed to
+  // SetIdleGCScheduler(), must be called before V8 initializes |isolate|.
+  void SetUpIdleTasks(v8::Isolate* isolate);
+
+  void SetIdleGCScheduler(IdleGCScheduler* scheduler) {
+    base::AutoLock auto_lock(idle_lock_);
+    idle_gc_scheduler_ = scheduler;
+  }
+
+  void PostIdleTask(std::unique_ptr<v8::IdleTask> task) {
+    base::AutoLock auto_lock(idle_lock_);
+    // V8 only posts idle tasks while they are enabled.
+    if (idle_gc_scheduler_)
+      idle_gc_scheduler_->PostIdleTask(std::move(task));
+  }
+
+  // The task runner of the main thread is only stored in the gin data of
+  // worker isolates, as their foreground tasks are run by Node.
+  void SetUpWorkerIsolates(
+      scoped_refptr<base::SingleThreadTaskRunner> task_runner) {
+    base::AutoLock auto_lock(worker_lock_);
+    worker_gin_task_runner_ = std::move(task_runner);
+  }
+
+  // Must be called on the thread of the worker |isolate|, its gin data lives
+  // until the isolate is unregistered.
+  void SetUpWorkerIsolate(v8::Isolate* isolate) {
+    if (gin::PerIsolateData::From(isolate))
+      return;
+    base::AutoLock auto_lock(worker_lock_);
+    DCHECK(worker_gin_task_runner_);
+    worker_gin_data_[isolate] = std::make_unique<gin::PerIsolateData>(
+        isolate, gin::ArrayBufferAllocator::SharedInstance(),
+        gin::IsolateHolder::kSingleThread, worker_gin_task_runner_);
+  }
+
+  // node::MultiIsolatePlatform:
+  bool FlushForegroundTasks(v8::Isolate* isolate) override {
+    return node_platform_->FlushForegroundTasks(isolate);
+  }
+  void DrainTasks(v8::Isolate* isolate) override {
+    // Node's DrainTasks() runs foreground tasks, which can post more worker
+    // tasks.
+    do {
+      pending_tasks_.Wait();
+      node_platform_->DrainTasks(isolate);
+    } while (pending_tasks_.HasPendingTasks());
+  }
+  void CancelPendingDelayedTasks(v8::Isolate* isolate) override {
+    node_platform_->CancelPendingDelayedTasks(isolate);
+  }
+  void RegisterIsolate(v8::Isolate* isolate, uv_loop_t* loop) override {
+    node_platform_->RegisterIsolate(isolate, loop);
+  }
+  void RegisterIsolate(v8::Isolate* isolate,
+                       node::IsolatePlatformDelegate* delegate) override {
+    node_platform_->RegisterIsolate(isolate, delegate);
+  }
+  void UnregisterIsolate(v8::Isolate* isolate) override {
+    {
+      // Node unregisters worker isolates on their thread before disposing
+      // them.
+      base::AutoLock auto_lock(worker_lock_);
+      worker_gin_data_.erase(isolate);
+    }
+    node_platform_->UnregisterIsolate(isolate);
+  }
+  void AddIsolateFinishedCallback(v8::Isolate* isolate,
+                                  void (*callback)(void*),
+                                  void* data) override {
+    node_platform_->AddIsolateFinishedCallback(isolate, callback, data);
+  }
+
+  // v8::Platform:
+  v8::PageAllocator* GetPageAllocator() override {
+    return node_platform_->GetPageAllocator();
+  }
+  int NumberOfWorkerThreads() override {
+    return worker_platform()->NumberOfWorkerThreads();
+  }
+  std::shared_ptr<v8::TaskRunner> GetForegroundTaskRunner(
+      v8::Isolate* isolate) override;
+  void CallOnWorkerThread(std::unique_ptr<v8::Task> task) override {
+    if (use_thread_pool_) {
+      gin::V8Platform::Get()->CallOnWorkerThread(
+          std::make_unique<CountedTask>(std::move(task), &pending_tasks_));
+    } else {
+      node_platform_->CallOnWorkerThread(std::move(task));
+    }
+  }
+  void CallBlockingTaskOnWorkerThread(std::unique_ptr<v8::Task> task) override {
+    if (use_thread_pool_) {
+      gin::V8Platform::Get()->CallBlockingTaskOnWorkerThread(
+          std::make_unique<CountedTask>(std::move(task), &pending_tasks_));
+    } else {
+      node_platform_->CallBlockingTaskOnWorkerThread(std::move(task));
+    }
+  }
+  void CallLowPriorityTaskOnWorkerThread(
+      std::unique_ptr<v8::Task> task) override {
+    if (use_thread_pool_) {
+      gin::V8Platform::Get()->CallLowPriorityTaskOnWorkerThread(
+          std::move(task));
+    } else {
+      node_platform_->CallLowPriorityTaskOnWorkerThread(std::move(task));
+    }
+  }
+  // Like Node's platform, delayed tasks are not waited on until they are due.
+  void CallDelayedOnWorkerThread(std::unique_ptr<v8::Task> task,
+                                 double delay_in_seconds) override {
+    worker_platform()->CallDelayedOnWorkerThread(std::move(task),
+                                                 delay_in_seconds);
+  }
+  std::unique_ptr<v8::JobHandle> PostJob(
+      v8::TaskPriority priority,
+      std::unique_ptr<v8::JobTask> job_task) override {
+    // The job posts its workers through the methods above, so they run with
+    // the priority of the job and are counted unless it is kBestEffort. The
+    // handle joins or cancels them itself.
+    return v8::platform::NewDefaultJobHandle(
+        this, priority, std::move(job_task), NumberOfWorkerThreads());
+  }
+  bool IdleTasksEnabled(v8::Isolate* isolate) override {
+    if (isolate == idle_isolate_) {
+      base::AutoLock auto_lock(idle_lock_);
+      return idle_gc_scheduler_ != nullptr;
+    }
+    return node_platform_->IdleTasksEnabled(isolate);
+  }
+  double MonotonicallyIncreasingTime() override {
+    return node_platform_->MonotonicallyIncreasingTime();
+  }
+  double CurrentClockTimeMillis() override {
+    return node_platform_->CurrentClockTimeMillis();
+  }
+  StackTracePrinter GetStackTracePrinter() override {
+    return node_platform_->GetStackTracePrinter();
+  }
+  v8::TracingController* GetTracingController() override {
+    return node_platform_->GetTracingController();
+  }
+
+ private:
+  v8::Platform* worker_platform() {
+    if (use_thread_pool_)
+      return gin::V8Platform::Get();
+    return node_platform_;
+  }
+
+  // Leaked on exit, like this platform.
+  node::MultiIsolatePlatform* node_platform_;
+  std::atomic<bool> use_thread_pool_{false};
+  PendingTaskCounter pending_tasks_;
+
+  // Both are only set once before V8 uses them from other threads.
+  v8::Isolate* idle_isolate_ = nullptr;
+  std::shared_ptr<IdleTaskRunner> idle_task_runner_;
+
+  base::Lock idle_lock_;
+  IdleGCScheduler* idle_gc_scheduler_ = nullptr;
+
+  base::Lock worker_lock_;
+  scoped_refptr<base::SingleThreadTaskRunner> worker_gin_task_runner_;
+  std::map<v8::Isolate*, std::unique_ptr<gin::PerIsolateData>>
+      worker_gin_data_;
+
+  DISALLOW_COPY_AND_ASSIGN(ThreadPoolPlatform);
+};
+
+// Runs the foreground tasks of an isolate on Node's task runner, and hands
+// its idle tasks to the platform.
+class IdleTaskRunner : public v8::TaskRunner {
+ public:
+  IdleTaskRunner(std::shared_ptr<v8::TaskRunner> task_runner,
+                 ThreadPoolPlatform* platform)
+      : task_runner_(std::move(task_runner)), platform_(platform) {}
+  ~IdleTaskRunner() override = default;
+
+  // v8::TaskRunner:
+  void PostTask(std::unique_ptr<v8::Task> task) override {
+    task_runner_->PostTask(std::move(task));
+  }
+  void PostNonNestableTask(std::unique_ptr<v8::Task> task) override {
+    task_runner_->PostNonNestableTask(std::move(task));
+  }
+  void PostDelayedTask(std::unique_ptr<v8::Task> task,
+                       double delay_in_seconds) override {
+    task_runner_->PostDelayedTask(std::move(task), delay_in_seconds);
+  }
+  void PostNonNestableDelayedTask(std::unique_ptr<v8::Task> task,
+                                  double delay_in_seconds) override {
+    task_runner_->PostNonNestableDelayedTask(std::move(task),
+                                             delay_in_seconds);
+  }
+  void PostIdleTask(std::unique_ptr<v8::IdleTask> task) override {
+    platform_->PostIdleTask(std::move(task));
+  }
+  bool IdleTasksEnabled() override { return true; }
+  bool NonNestableTasksEnabled() const override {
+    return task_runner_->NonNestableTasksEnabled();
+  }
+  bool NonNestableDelayedTasksEnabled() const override {
+    return task_runner_->NonNestableDelayedTasksEnabled();
+  }
+
+ private:
+  std::shared_ptr<v8::TaskRunner> task_runner_;
+  ThreadPoolPlatform* platform_;
+
+  DISALLOW_COPY_AND_ASSIGN(IdleTaskRunner);
+};
+
+void ThreadPoolPlatform::SetUpIdleTasks(v8::Isolate* isolate) {
+  idle_isolate_ = isolate;
+  idle_task_runner_ = std::make_shared<IdleTaskRunner>(
+      node_platform_->GetForegroundTaskRunner(isolate), this);
+}
+
+std::shared_ptr<v8::TaskRunner> ThreadPoolPlatform::GetForegroundTaskRunner(
+    v8::Isolate* isolate) {
+  if (isolate == idle_isolate_)
+    return idle_task_runner_;
+  return node_platform_->GetForegroundTaskRunner(isolate);
+}
+
 v8::Isolate* JavascriptEnvironment::Initialize(uv_loop_t* event_loop) {
   auto* cmd = base::CommandLine::ForCurrentProcess();
 
@@ -324,13 +663,15 @@ v8::Isolate* JavascriptEnvironment::Initialize(uv_loop_t* event_loop) {
     v8::V8::SetFlagsFromString(js_flags.c_str(), js_flags.size());
 
   // The V8Platform of gin relies on Chromium's task schedule, which has not
-  // been started at this point, so we have to rely on Node's V8Platform.
+  // been started at this point, so we have to rely on Node's V8Platform
+  // until UseThreadPoolForWorkerTasks() is called. Its workers only cover
+  // that startup window, so keep them few.
   auto* tracing_agent = node::CreateAgent();
   auto* tracing_controller = new TracingControllerImpl();
   node::tracing::TraceEventHelper::SetAgent(tracing_agent);
-  platform_ = node::CreatePlatform(
-      base::RecommendedMaxNumberOfThreadsInThreadGroup(3, 8, 0.1, 0),
-      tracing_controller, gin::V8Platform::PageAllocator());
+  platform_ = new ThreadPoolPlatform(node::CreatePlatform(
+      kStartupWorkerThreads, tracing_controller,
+      gin::V8Platform::PageAllocator()));
 
   v8::V8::InitializePlatform(platform_);
   gin::IsolateHolder::Initialize(
@@ -339,21 +680,45 @@ v8::Isolate* JavascriptEnvironment::Initialize(uv_loop_t* event_loop) {
 
   v8::Isolate* isolate = v8::Isolate::Allocate();
   platform_->RegisterIsolate(isolate, event_loop);
+  platform_->SetUpIdleTasks(isolate);
+  platform_->SetUpWorkerIsolates(base::ThreadTaskRunnerHandle::Get());
   g_isolate = isolate;
+  g_platform = platform_;
 
   return isolate;
 }
 
+node::MultiIsolatePlatform* JavascriptEnvironment::platform() const {
+  return platform_;
+}
+
+void JavascriptEnvironment::UseThreadPoolForWorkerTasks() {
+  platform_->UseThreadPool();
+}
+
 // static
 v8::Isolate* JavascriptEnvironment::GetIsolate() {
   CHECK(g_isolate);
   return g_isolate;
 }
 
+// static
+void JavascriptEnvironment::SetUpWorkerIsolate(v8::Isolate* isolate) {
+  CHECK(g_platform);
+  g_platform->SetUpWorkerIsolate(isolate);
+}
+
 void JavascriptEnvironment::OnMessageLoopCreated() {
   DCHECK(!microtasks_runner_);
   microtasks_runner_ = std::make_unique<MicrotasksRunner>(isolate());
   base::CurrentThread::Get()->AddTaskObserver(microtasks_runner_.get());
+
+  if (base::FeatureList::IsEnabled(features::kIdleTimeGarbageCollection)) {
+    idle_gc_scheduler_ =
+        std::make_unique<IdleGCScheduler>(isolate(), platform_, event_loop_);
+    platform_->SetIdleGCScheduler(idle_gc_scheduler_.get());
+    base::CurrentThread::Get()->AddTaskObserver(idle_gc_scheduler_.get());
+  }
 }
 
 void JavascriptEnvironment::OnMessageLoopDestroying() {
@@ -364,6 +729,12 @@ void JavascriptEnvironment::OnMessageLoopDestroying() {
     gin_helper::CleanedUpAtExit::DoCleanup();
   }
   base::CurrentThread::Get()->RemoveTaskObserver(microtasks_runner_.get());
+
+  if (idle_gc_scheduler_) {
+    base::CurrentThread::Get()->RemoveTaskObserver(idle_gc_scheduler_.get());
+    platform_->SetIdleGCScheduler(nullptr);
+    idle_gc_scheduler_.reset();
+  }
 }
 
 NodeEnvironment::NodeEnvironment(node::Environment* env) : env_(env) {}
@@ -18,7 +18,10 @@ class MultiIsolatePlatform;
 
 namespace electron {
 
+class IdleGCScheduler;
 class MicrotasksRunner;
+class ThreadPoolPlatform;
+
 // Manage the V8 isolate and context automatically.
 class JavascriptEnvironment {
  public:
@@ -28,7 +31,11 @@ class JavascriptEnvironment {
   void OnMessageLoopCreated();
   void OnMessageLoopDestroying();
 
-  node::MultiIsolatePlatform* platform() const { return platform_; }
+  // Moves V8 background tasks from Node's worker threads to Chromium's
+  // ThreadPool, must only be called once the ThreadPool runs tasks.
+  void UseThreadPoolForWorkerTasks();
+
+  node::MultiIsolatePlatform* platform() const;
   v8::Isolate* isolate() const { return isolate_; }
   v8::Local<v8::Context> context() const {
     return v8::Local<v8::Context>::New(isolate_, context_);
@@ -36,10 +43,15 @@ class JavascriptEnvironment {
 
   static v8::Isolate* GetIsolate();
 
+  // Sets up gin for the isolate of a worker thread of the main process, only
+  // the workers that load Electron's modules need it.
+  static void SetUpWorkerIsolate(v8::Isolate* isolate);
+
  private:
   v8::Isolate* Initialize(uv_loop_t* event_loop);
   // Leaked on exit.
-  node::MultiIsolatePlatform* platform_;
+  ThreadPoolPlatform* platform_;
+  uv_loop_t* event_loop_;
 
   v8::Isolate* isolate_;
   gin::IsolateHolder isolate_holder_;
@@ -47,6 +59,7 @@ class JavascriptEnvironment {
   v8::Global<v8::Context> context_;
 
   std::unique_ptr<MicrotasksRunner> microtasks_runner_;
+  std::unique_ptr<IdleGCScheduler> idle_gc_scheduler_;
 
   DISALLOW_COPY_AND_ASSIGN(JavascriptEnvironment);
 };
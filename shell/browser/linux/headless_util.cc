@@ -0,0 +1,24 @@
+// Copyright (c) 2021 GitHub, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#include "shell/browser/linux/headless_util.h"
+
+#include "base/command_line.h"
+
+#if defined(USE_OZONE)
+#include "ui/ozone/public/ozone_switches.h"
+#endif
+
+namespace electron {
+
+bool IsHeadlessOzonePlatform() {
+#if defined(USE_OZONE)
+  return base::CommandLine::ForCurrentProcess()->GetSwitchValueASCII(
+             switches::kOzonePlatform) == "headless";
+#else
+  return false;
+#endif
+}
+
+}  // namespace electron
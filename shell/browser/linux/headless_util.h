@@ -0,0 +1,17 @@
+// Copyright (c) 2021 GitHub, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#ifndef SHELL_BROWSER_LINUX_HEADLESS_UTIL_H_
+#define SHELL_BROWSER_LINUX_HEADLESS_UTIL_H_
+
+namespace electron {
+
+// Returns whether the app was started with --ozone-platform=headless, in which
+// case there is no connection to a display server and only offscreen windows
+// can be created.
+bool IsHeadlessOzonePlatform();
+
+}  // namespace electron
+
+#endif  // SHELL_BROWSER_LINUX_HEADLESS_UTIL_H_
@@ -0,0 +1,104 @@
+// Copyright (c) 2021 GitHub, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#include "shell/browser/net/asar/asar_file_validator.h"
+
+#include <algorithm>
+#include <utility>
+
+#include "base/logging.h"
+#include "base/strings/string_piece.h"
+#include "shell/common/asar/asar_util.h"
+
+namespace asar {
+
+AsarFileValidator::AsarFileValidator(
+    std::shared_ptr<const IntegrityPayload> integrity,
+    const base::FilePath& archive_path,
+    uint64_t file_offset,
+    uint32_t file_size,
+    uint64_t position,
+    uint64_t end)
+    : integrity_(std::move(integrity)),
+      archive_path_(archive_path),
+      file_offset_(file_offset),
+      file_size_(file_size),
+      position_(position),
+      end_(end) {}
+
+AsarFileValidator::~AsarFileValidator() = default;
+
+bool AsarFileValidator::Validate(base::span<const char> buffer) {
+  if (failed_)
+    return false;
+
+  size_t consumed = 0;
+  while (consumed < buffer.size()) {
+    if (!in_block_ && !StartBlock())
+      return false;
+    const size_t length = std::min<uint64_t>(buffer.size() - consumed,
+                                             block_end_ - position_);
+    // The file may have changed since the block was verified.
+    if (block_.compare(position_ - block_start_, length,
+                       buffer.data() + consumed, length) != 0) {
+      LOG(ERROR) << "The file at offset " << file_offset_ << " in "
+                 << archive_path_.value() << " changed while it was read";
+      failed_ = true;
+      return false;
+    }
+    consumed += length;
+    position_ += length;
+    if (position_ == block_end_) {
+      in_block_ = false;
+      block_.clear();
+    }
+  }
+  return true;
+}
+
+void AsarFileValidator::OnRead(base::span<char> buffer,
+                               mojo::FileDataSource::ReadResult* result) {
+  if (result->result != MOJO_RESULT_OK)
+    return;
+  if (!Validate(buffer.first(result->bytes_read))) {
+    // Every byte that was let through before belongs to a verified block,
+    // and these are dropped.
+    result->bytes_read = 0;
+    result->result = MOJO_RESULT_DATA_LOSS;
+  }
+}
+
+void AsarFileValidator::OnDone() {}
+
+bool AsarFileValidator::StartBlock() {
+  if (integrity_->block_size == 0) {
+    failed_ = true;
+    return false;
+  }
+  const size_t block_index = position_ / integrity_->block_size;
+  block_start_ = static_cast<uint64_t>(block_index) * integrity_->block_size;
+  block_end_ =
+      std::min<uint64_t>(block_start_ + integrity_->block_size, file_size_);
+  in_block_ = true;
+
+  if (!file_.IsValid()) {
+    file_.Initialize(archive_path_,
+                     base::File::FLAG_OPEN | base::File::FLAG_READ);
+  }
+  const uint64_t length = block_end_ - block_start_;
+  block_.resize(length);
+  if (!file_.IsValid() ||
+      file_.Read(file_offset_ + block_start_, &block_[0], length) !=
+          static_cast<int>(length) ||
+      !ValidateIntegrityBlock(*integrity_, block_index, block_)) {
+    LOG(ERROR) << "Integrity check failed for block " << block_index
+               << " of the file at offset " << file_offset_ << " in "
+               << archive_path_.value();
+    failed_ = true;
+    return false;
+  }
+  return true;
+}
+
+}  // namespace asar
@@ -0,0 +1,73 @@
+// Copyright (c) 2021 GitHub, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#ifndef SHELL_BROWSER_NET_ASAR_ASAR_FILE_VALIDATOR_H_
+#define SHELL_BROWSER_NET_ASAR_ASAR_FILE_VALIDATOR_H_
+
+#include <memory>
+#include <string>
+
+#include "base/containers/span.h"
+#include "base/files/file.h"
+#include "base/files/file_path.h"
+#include "mojo/public/cpp/system/file_data_source.h"
+#include "mojo/public/cpp/system/filtered_data_source.h"
+#include "shell/common/asar/archive.h"
+
+namespace asar {
+
+// Verifies the blocks of a file in an asar archive as they are read
+// sequentially, so that only the blocks that are actually sent are hashed.
+// Each block is read whole from the archive and checked before any of its
+// bytes are let through, and the bytes that are then sent are compared with
+// the checked ones.
+class AsarFileValidator : public mojo::FilteredDataSource::Filter {
+ public:
+  // Validates the bytes of the file in [|position|, |end|). The file starts at
+  // |file_offset| in the archive at |archive_path|.
+  AsarFileValidator(std::shared_ptr<const IntegrityPayload> integrity,
+                    const base::FilePath& archive_path,
+                    uint64_t file_offset,
+                    uint32_t file_size,
+                    uint64_t position,
+                    uint64_t end);
+  ~AsarFileValidator() override;
+
+  // Validates the next bytes of the range, returns false if they do not
+  // match the integrity of the file. The bytes can be sent once it returns
+  // true.
+  bool Validate(base::span<const char> buffer);
+
+  // mojo::FilteredDataSource::Filter:
+  void OnRead(base::span<char> buffer,
+              mojo::FileDataSource::ReadResult* result) override;
+  void OnDone() override;
+
+ private:
+  bool StartBlock();
+
+  const std::shared_ptr<const IntegrityPayload> integrity_;
+  const base::FilePath archive_path_;
+  const uint64_t file_offset_;
+  const uint32_t file_size_;
+  uint64_t position_;
+  const uint64_t end_;
+
+  // Opened with the first block.
+  base::File file_;
+
+  // The verified bytes of the block being sent.
+  bool in_block_ = false;
+  uint64_t block_start_ = 0;
+  uint64_t block_end_ = 0;
+  std::string block_;
+
+  bool failed_ = false;
+
+  DISALLOW_COPY_AND_ASSIGN(AsarFileValidator);
+};
+
+}  // namespace asar
+
+#endif  // SHELL_BROWSER_NET_ASAR_ASAR_FILE_VALIDATOR_H_
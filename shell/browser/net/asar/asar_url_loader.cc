@@ -17,12 +17,14 @@
 #include "mojo/public/cpp/bindings/remote.h"
 #include "mojo/public/cpp/system/data_pipe_producer.h"
 #include "mojo/public/cpp/system/file_data_source.h"
+#include "mojo/public/cpp/system/filtered_data_source.h"
 #include "net/base/filename_util.h"
 #include "net/base/mime_sniffer.h"
 #include "net/base/mime_util.h"
 #include "net/http/http_byte_range.h"
 #include "net/http/http_util.h"
 #include "services/network/public/mojom/url_response_head.mojom.h"
+#include "shell/browser/net/asar/asar_file_validator.h"
 #include "shell/common/asar/archive.h"
 #include "shell/common/asar/asar_util.h"
 
@@ -42,6 +44,9 @@ net::Error ConvertMojoResultToNetError(MojoResult result) {
       return net::ERR_INSUFFICIENT_RESOURCES;
     case MOJO_RESULT_ABORTED:
       return net::ERR_ABORTED;
+    case MOJO_RESULT_DATA_LOSS:
+      // The file failed its integrity check.
+      return net::ERR_INVALID_RESPONSE;
     default:
       return net::ERR_FAILED;
   }
@@ -195,6 +200,14 @@ class AsarURLLoader : public network::mojom::URLLoader {
 
     head->content_length = base::saturated_cast<int64_t>(total_bytes_to_send);
 
+    // Files with an integrity are verified as they are sent.
+    std::unique_ptr<AsarFileValidator> file_validator;
+    if (info.integrity) {
+      file_validator = std::make_unique<AsarFileValidator>(
+          info.integrity, archive->path(), info.offset, info.size,
+          first_byte_to_send, first_byte_to_send + total_bytes_to_send);
+    }
+
     if (first_byte_to_send < read_result.bytes_read) {
       // Write any data we read for MIME sniffing, constraining by range where
       // applicable. This will always fit in the pipe (see assertion near
@@ -203,6 +216,12 @@ class AsarURLLoader : public network::mojom::URLLoader {
           static_cast<uint32_t>(read_result.bytes_read - first_byte_to_send),
           static_cast<uint32_t>(total_bytes_to_send));
       const uint32_t expected_write_size = write_size;
+      if (file_validator &&
+          !file_validator->Validate(base::make_span(
+              &initial_read_buffer[first_byte_to_send], write_size))) {
+        OnClientComplete(ConvertMojoResultToNetError(MOJO_RESULT_DATA_LOSS));
+        return;
+      }
       MojoResult result =
           producer_handle->WriteData(&initial_read_buffer[first_byte_to_send],
                                      &write_size, MOJO_WRITE_DATA_FLAG_NONE);
@@ -247,10 +266,17 @@ class AsarURLLoader : public network::mojom::URLLoader {
         first_byte_to_send + info.offset,
         first_byte_to_send + info.offset + total_bytes_to_send);
 
+    std::unique_ptr<mojo::DataPipeProducer::DataSource> data_source_to_write =
+        std::move(file_data_source);
+    if (file_validator) {
+      data_source_to_write = std::make_unique<mojo::FilteredDataSource>(
+          std::move(data_source_to_write), std::move(file_validator));
+    }
+
     data_producer_ =
         std::make_unique<mojo::DataPipeProducer>(std::move(producer_handle));
     data_producer_->Write(
-        std::move(file_data_source),
+        std::move(data_source_to_write),
         base::BindOnce(&AsarURLLoader::OnFileWritten, base::Unretained(this)));
   }
 
@@ -281,6 +307,9 @@ class AsarURLLoader : public network::mojom::URLLoader {
       status.encoded_body_length = total_bytes_written_;
       status.decoded_body_length = total_bytes_written_;
       client_->OnComplete(status);
+    } else if (result == MOJO_RESULT_DATA_LOSS) {
+      client_->OnComplete(network::URLLoaderCompletionStatus(
+          ConvertMojoResultToNetError(result)));
     } else {
       client_->OnComplete(network::URLLoaderCompletionStatus(net::ERR_FAILED));
     }
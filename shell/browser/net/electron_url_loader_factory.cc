@@ -4,18 +4,24 @@
 
 #include "shell/browser/net/electron_url_loader_factory.h"
 
+#include <algorithm>
 #include <memory>
 #include <string>
 #include <utility>
+#include <vector>
 
 #include "base/guid.h"
 #include "base/strings/string_number_conversions.h"
+#include "base/strings/stringprintf.h"
 #include "content/public/browser/browser_thread.h"
 #include "content/public/browser/storage_partition.h"
 #include "mojo/public/cpp/system/data_pipe_producer.h"
 #include "mojo/public/cpp/system/string_data_source.h"
 #include "net/base/filename_util.h"
+#include "net/base/mime_util.h"
+#include "net/http/http_byte_range.h"
 #include "net/http/http_status_code.h"
+#include "net/http/http_util.h"
 #include "net/url_request/redirect_util.h"
 #include "services/network/public/cpp/url_loader_completion_status.h"
 #include "services/network/public/mojom/url_loader_factory.mojom.h"
@@ -146,6 +152,148 @@ network::mojom::URLResponseHeadPtr ToResponseHead(
   return head;
 }
 
+void SetStatusCode(net::HttpResponseHeaders* headers,
+                   net::HttpStatusCode status_code) {
+  headers->ReplaceStatusLine(base::StringPrintf(
+      "HTTP/1.1 %d %s", status_code, net::GetHttpReasonPhrase(status_code)));
+}
+
+void SetContentLength(network::mojom::URLResponseHead* head, int64_t length) {
+  head->content_length = length;
+  head->headers->SetHeader(net::HttpRequestHeaders::kContentLength,
+                           base::NumberToString(length));
+}
+
+std::string GetContentRange(const net::HttpByteRange& range, int64_t size) {
+  return base::StringPrintf("bytes %" PRId64 "-%" PRId64 "/%" PRId64,
+                            range.first_byte_position(),
+                            range.last_byte_position(), size);
+}
+
+void SetRangeNotSatisfiable(network::mojom::URLResponseHead* head,
+                            int64_t size) {
+  SetStatusCode(head->headers.get(), net::HTTP_REQUESTED_RANGE_NOT_SATISFIABLE);
+  head->headers->SetHeader("Content-Range",
+                           base::StringPrintf("bytes */%" PRId64, size));
+  SetContentLength(head, 0);
+}
+
+// Returns the byte ranges requested by |request|, or an empty list when the
+// full response should be sent. Only plain successful responses are turned
+// into partial ones, the handler is in charge of any other status.
+std::vector<net::HttpByteRange> GetRequestedRanges(
+    const network::ResourceRequest& request,
+    const network::mojom::URLResponseHead& head) {
+  std::string range_header;
+  std::vector<net::HttpByteRange> ranges;
+  if (request.method != net::HttpRequestHeaders::kGetMethod ||
+      head.headers->response_code() != net::HTTP_OK ||
+      !request.headers.GetHeader(net::HttpRequestHeaders::kRange,
+                                 &range_header) ||
+      !net::HttpUtil::ParseRangeHeader(range_header, &ranges)) {
+    return {};
+  }
+  return ranges;
+}
+
+// Clients asking for more ranges than this get the full response, as do the
+// ones whose ranges add up to more than the full response.
+constexpr size_t kMaxRanges = 16;
+
+// Returns |ranges|, whose bounds must have been computed, sorted and with the
+// ones that overlap or touch merged, so that no byte is sent twice.
+std::vector<net::HttpByteRange> MergeRanges(
+    std::vector<net::HttpByteRange> ranges) {
+  std::sort(ranges.begin(), ranges.end(),
+            [](const net::HttpByteRange& a, const net::HttpByteRange& b) {
+              return a.first_byte_position() < b.first_byte_position();
+            });
+  std::vector<net::HttpByteRange> merged;
+  for (const auto& range : ranges) {
+    if (!merged.empty() && range.first_byte_position() <=
+                               merged.back().last_byte_position() + 1) {
+      if (range.last_byte_position() > merged.back().last_byte_position()) {
+        merged.back() = net::HttpByteRange::Bounded(
+            merged.back().first_byte_position(), range.last_byte_position());
+      }
+      continue;
+    }
+    merged.push_back(range);
+  }
+  return merged;
+}
+
+// Turns a response whose body is |data| into the response for the ranges
+// requested by |request|, and returns the body to send. Returns nullopt when
+// the whole of |data| should be sent, so that callers only copy the bytes
+// they send.
+base::Optional<std::string> ApplyRequestedRanges(
+    const network::ResourceRequest& request,
+    network::mojom::URLResponseHead* head,
+    base::StringPiece data) {
+  std::vector<net::HttpByteRange> ranges = GetRequestedRanges(request, *head);
+  if (head->headers->response_code() == net::HTTP_OK)
+    head->headers->SetHeader("Accept-Ranges", "bytes");
+  if (ranges.empty() || ranges.size() > kMaxRanges)
+    return base::nullopt;
+
+  const int64_t size = data.size();
+  std::vector<net::HttpByteRange> satisfiable_ranges;
+  int64_t requested_size = 0;
+  for (auto& range : ranges) {
+    if (range.ComputeBounds(size)) {
+      requested_size +=
+          range.last_byte_position() - range.first_byte_position() + 1;
+      satisfiable_ranges.push_back(range);
+    }
+  }
+
+  if (satisfiable_ranges.empty()) {
+    SetRangeNotSatisfiable(head, size);
+    return std::string();
+  }
+  if (requested_size > size)
+    return base::nullopt;
+  satisfiable_ranges = MergeRanges(std::move(satisfiable_ranges));
+
+  SetStatusCode(head->headers.get(), net::HTTP_PARTIAL_CONTENT);
+  std::string body;
+  if (satisfiable_ranges.size() == 1) {
+    const net::HttpByteRange& range = satisfiable_ranges[0];
+    head->headers->SetHeader("Content-Range", GetContentRange(range, size));
+    body = std::string(data.substr(
+        range.first_byte_position(),
+        range.last_byte_position() - range.first_byte_position() + 1));
+  } else {
+    // Multiple ranges are sent as a multipart/byteranges body, with each part
+    // keeping the content type of the full response.
+    const std::string boundary = net::GenerateMimeMultipartBoundary();
+    std::string part_content_type = head->mime_type;
+    if (!head->charset.empty())
+      part_content_type += "; charset=" + head->charset;
+    for (const auto& range : satisfiable_ranges) {
+      base::StringAppendF(&body,
+                          "--%s\r\nContent-Type: %s\r\n"
+                          "Content-Range: %s\r\n\r\n",
+                          boundary.c_str(), part_content_type.c_str(),
+                          GetContentRange(range, size).c_str());
+      base::StringPiece part = data.substr(
+          range.first_byte_position(),
+          range.last_byte_position() - range.first_byte_position() + 1);
+      body.append(part.data(), part.size());
+      body += "\r\n";
+    }
+    base::StringAppendF(&body, "--%s--\r\n", boundary.c_str());
+
+    head->mime_type = "multipart/byteranges";
+    head->charset.clear();
+    head->headers->SetHeader(net::HttpRequestHeaders::kContentType,
+                             "multipart/byteranges; boundary=" + boundary);
+  }
+  SetContentLength(head, body.size());
+  return body;
+}
+
 // Helper to write string to pipe.
 struct WriteData {
   mojo::Remote<network::mojom::URLLoaderClient> client;
@@ -331,10 +479,10 @@ void ElectronURLLoaderFactory::StartLoading(
 
   switch (type) {
     case ProtocolType::kBuffer:
-      StartLoadingBuffer(std::move(client), std::move(head), dict);
+      StartLoadingBuffer(request, std::move(client), std::move(head), dict);
       break;
     case ProtocolType::kString:
-      StartLoadingString(std::move(client), std::move(head), dict,
+      StartLoadingString(request, std::move(client), std::move(head), dict,
                          args->isolate(), response);
       break;
     case ProtocolType::kFile:
@@ -346,8 +494,8 @@ void ElectronURLLoaderFactory::StartLoading(
                        traffic_annotation, dict);
       break;
     case ProtocolType::kStream:
-      StartLoadingStream(std::move(loader), std::move(client), std::move(head),
-                         dict);
+      StartLoadingStream(std::move(loader), request, std::move(client),
+                         std::move(head), dict);
       break;
     case ProtocolType::kFree:
       ProtocolType type;
@@ -365,6 +513,7 @@ void ElectronURLLoaderFactory::StartLoading(
 
 // static
 void ElectronURLLoaderFactory::StartLoadingBuffer(
+    const network::ResourceRequest& request,
     mojo::PendingRemote<network::mojom::URLLoaderClient> client,
     network::mojom::URLResponseHeadPtr head,
     const gin_helper::Dictionary& dict) {
@@ -378,13 +527,18 @@ void ElectronURLLoaderFactory::StartLoadingBuffer(
     return;
   }
 
-  SendContents(
-      std::move(client), std::move(head),
-      std::string(node::Buffer::Data(buffer), node::Buffer::Length(buffer)));
+  base::StringPiece data(node::Buffer::Data(buffer),
+                         node::Buffer::Length(buffer));
+  base::Optional<std::string> ranges_body =
+      ApplyRequestedRanges(request, head.get(), data);
+  std::string contents =
+      ranges_body ? std::move(*ranges_body) : std::string(data);
+  SendContents(std::move(client), std::move(head), std::move(contents));
 }
 
 // static
 void ElectronURLLoaderFactory::StartLoadingString(
+    const network::ResourceRequest& request,
     mojo::PendingRemote<network::mojom::URLLoaderClient> client,
     network::mojom::URLResponseHeadPtr head,
     const gin_helper::Dictionary& dict,
@@ -403,6 +557,10 @@ void ElectronURLLoaderFactory::StartLoadingString(
     return;
   }
 
+  base::Optional<std::string> ranges_body =
+      ApplyRequestedRanges(request, head.get(), contents);
+  if (ranges_body)
+    contents = std::move(*ranges_body);
   SendContents(std::move(client), std::move(head), std::move(contents));
 }
 
@@ -483,6 +641,7 @@ void ElectronURLLoaderFactory::StartLoadingHttp(
 // static
 void ElectronURLLoaderFactory::StartLoadingStream(
     mojo::PendingReceiver<network::mojom::URLLoader> loader,
+    const network::ResourceRequest& request,
     mojo::PendingRemote<network::mojom::URLLoaderClient> client,
     network::mojom::URLResponseHeadPtr head,
     const gin_helper::Dictionary& dict) {
@@ -529,6 +688,28 @@ void ElectronURLLoaderFactory::StartLoadingStream(
     return;
   }
 
+  // When the handler tells the full length of the resource, the stream is
+  // expected to only contain the single range requested, if any.
+  int64_t total_length;
+  if (dict.Get("totalLength", &total_length) && total_length >= 0 &&
+      head->headers->response_code() == net::HTTP_OK) {
+    std::vector<net::HttpByteRange> ranges = GetRequestedRanges(request, *head);
+    head->headers->SetHeader("Accept-Ranges", "bytes");
+    if (ranges.size() != 1) {
+      SetContentLength(head.get(), total_length);
+    } else if (ranges[0].ComputeBounds(total_length)) {
+      SetStatusCode(head->headers.get(), net::HTTP_PARTIAL_CONTENT);
+      head->headers->SetHeader("Content-Range",
+                               GetContentRange(ranges[0], total_length));
+      SetContentLength(head.get(), ranges[0].last_byte_position() -
+                                       ranges[0].first_byte_position() + 1);
+    } else {
+      SetRangeNotSatisfiable(head.get(), total_length);
+      SendContents(std::move(client), std::move(head), std::string());
+      return;
+    }
+  }
+
   new NodeStreamLoader(std::move(head), std::move(loader), std::move(client),
                        data.isolate(), data.GetHandle());
 }
@@ -81,10 +81,12 @@ class ElectronURLLoaderFactory : public network::SelfDeletingURLLoaderFactory {
       int32_t request_id,
       const network::URLLoaderCompletionStatus& status);
   static void StartLoadingBuffer(
+      const network::ResourceRequest& request,
       mojo::PendingRemote<network::mojom::URLLoaderClient> client,
       network::mojom::URLResponseHeadPtr head,
       const gin_helper::Dictionary& dict);
   static void StartLoadingString(
+      const network::ResourceRequest& request,
       mojo::PendingRemote<network::mojom::URLLoaderClient> client,
       network::mojom::URLResponseHeadPtr head,
       const gin_helper::Dictionary& dict,
@@ -106,6 +108,7 @@ class ElectronURLLoaderFactory : public network::SelfDeletingURLLoaderFactory {
       const gin_helper::Dictionary& dict);
   static void StartLoadingStream(
       mojo::PendingReceiver<network::mojom::URLLoader> loader,
+      const network::ResourceRequest& request,
       mojo::PendingRemote<network::mojom::URLLoaderClient> client,
       network::mojom::URLResponseHeadPtr head,
       const gin_helper::Dictionary& dict);
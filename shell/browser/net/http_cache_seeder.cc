@@ -0,0 +1,196 @@
+// Copyright (c) 2021 GitHub, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#include "shell/browser/net/http_cache_seeder.h"
+
+#include <utility>
+
+#include "base/bind.h"
+#include "base/strings/string_number_conversions.h"
+#include "base/task/thread_pool.h"
+#include "content/public/browser/browser_context.h"
+#include "content/public/browser/storage_partition.h"
+#include "mojo/public/cpp/bindings/callback_helpers.h"
+#include "mojo/public/cpp/system/data_pipe_producer.h"
+#include "mojo/public/cpp/system/file_data_source.h"
+#include "net/base/net_errors.h"
+#include "net/http/http_status_code.h"
+#include "services/network/public/mojom/network_context.mojom.h"
+#include "shell/browser/electron_browser_context.h"
+#include "shell/common/asar/asar_util.h"
+#include "url/url_constants.h"
+
+namespace electron {
+
+namespace {
+
+constexpr uint32_t kDataPipeCapacity = 512 * 1024;
+
+}  // namespace
+
+HttpCacheSeeder::Entry::Entry() = default;
+HttpCacheSeeder::Entry::Entry(Entry&&) = default;
+HttpCacheSeeder::Entry::~Entry() = default;
+HttpCacheSeeder::Entry& HttpCacheSeeder::Entry::operator=(Entry&&) = default;
+
+// static
+bool HttpCacheSeeder::ValidateEntry(const Entry& entry, std::string* error) {
+  // Cached https responses carry the certificate of the connection they
+  // were received on, which an imported response does not have.
+  if (!entry.url.is_valid() || !entry.url.SchemeIs(url::kHttpScheme)) {
+    *error = "url must be a valid http URL";
+    return false;
+  }
+  if (entry.top_frame_origin && entry.top_frame_origin->opaque()) {
+    *error = "topFrameOrigin must be a valid origin";
+    return false;
+  }
+  if (!entry.path.IsAbsolute()) {
+    *error = "path must be absolute";
+    return false;
+  }
+  // The body is read from the file system with mojo::FileDataSource, which
+  // can not see inside asar archives.
+  base::FilePath asar_path, relative_path;
+  if (asar::GetAsarArchivePath(entry.path, &asar_path, &relative_path)) {
+    *error = "path must not be inside an asar archive";
+    return false;
+  }
+  if (!entry.headers || entry.headers->response_code() != net::HTTP_OK) {
+    *error = "Only 200 responses can be imported";
+    return false;
+  }
+  if (entry.headers->HasHeaderValue("cache-control", "no-store")) {
+    *error = "Responses with Cache-Control: no-store can not be cached";
+    return false;
+  }
+  if (entry.headers->HasHeaderValue("vary", "*")) {
+    *error = "Responses with Vary: * can not be cached";
+    return false;
+  }
+  // The cache only uses the entry for requests with the same values of the
+  // headers named by Vary, an entry seeded without them would never match.
+  size_t iter = 0;
+  std::string vary_header;
+  while (entry.headers->EnumerateHeader(&iter, "vary", &vary_header)) {
+    if (!entry.request_headers.HasHeader(vary_header)) {
+      *error = "requestHeaders must have the " + vary_header +
+               " header named by Vary";
+      return false;
+    }
+  }
+  return true;
+}
+
+// static
+void HttpCacheSeeder::Start(ElectronBrowserContext* browser_context,
+                            std::vector<Entry> entries,
+                            CompletionCallback callback) {
+  auto* seeder = new HttpCacheSeeder(browser_context, std::move(entries),
+                                     std::move(callback));
+  seeder->WriteNextEntry();
+}
+
+HttpCacheSeeder::HttpCacheSeeder(ElectronBrowserContext* browser_context,
+                                 std::vector<Entry> entries,
+                                 CompletionCallback callback)
+    : browser_context_(browser_context->GetWeakPtr()),
+      callback_(std::move(callback)) {
+  for (auto& entry : entries)
+    entries_.push(std::move(entry));
+}
+
+HttpCacheSeeder::~HttpCacheSeeder() = default;
+
+// static
+HttpCacheSeeder::BodyFile HttpCacheSeeder::OpenBodyFile(
+    const base::FilePath& path) {
+  BodyFile body_file;
+  body_file.file.Initialize(path,
+                            base::File::FLAG_OPEN | base::File::FLAG_READ);
+  if (body_file.file.IsValid())
+    body_file.length = body_file.file.GetLength();
+  return body_file;
+}
+
+void HttpCacheSeeder::WriteNextEntry() {
+  if (entries_.empty()) {
+    Finish(net::OK);
+    return;
+  }
+
+  current_entry_ = std::move(entries_.front());
+  entries_.pop();
+  base::ThreadPool::PostTaskAndReplyWithResult(
+      FROM_HERE, {base::MayBlock(), base::TaskPriority::BEST_EFFORT},
+      base::BindOnce(&HttpCacheSeeder::OpenBodyFile, current_entry_.path),
+      base::BindOnce(&HttpCacheSeeder::OnBodyFileOpened,
+                     weak_factory_.GetWeakPtr()));
+}
+
+void HttpCacheSeeder::OnBodyFileOpened(BodyFile body_file) {
+  if (!body_file.file.IsValid()) {
+    Finish(net::FileErrorToNetError(body_file.file.error_details()));
+    return;
+  }
+  if (body_file.length < 0) {
+    Finish(net::ERR_FAILED);
+    return;
+  }
+  if (!browser_context_) {
+    Finish(net::ERR_ABORTED);
+    return;
+  }
+
+  mojo::ScopedDataPipeProducerHandle producer_handle;
+  mojo::ScopedDataPipeConsumerHandle consumer_handle;
+  if (mojo::CreateDataPipe(kDataPipeCapacity, producer_handle,
+                           consumer_handle) != MOJO_RESULT_OK) {
+    Finish(net::ERR_INSUFFICIENT_RESOURCES);
+    return;
+  }
+
+  // The producer reads the file on its own sequence and lives until the
+  // whole body has been written into the pipe.
+  auto producer =
+      std::make_unique<mojo::DataPipeProducer>(std::move(producer_handle));
+  auto* raw_producer = producer.get();
+  raw_producer->Write(
+      std::make_unique<mojo::FileDataSource>(std::move(body_file.file)),
+      base::BindOnce([](std::unique_ptr<mojo::DataPipeProducer>,
+                        MojoResult) {},
+                     std::move(producer)));
+
+  // Announce the real size so that a truncated read is not kept.
+  current_entry_.headers->SetHeader("Content-Length",
+                                    base::NumberToString(body_file.length));
+
+  content::BrowserContext::GetDefaultStoragePartition(browser_context_.get())
+      ->GetNetworkContext()
+      ->WriteHttpCacheEntry(
+          current_entry_.url, current_entry_.top_frame_origin,
+          current_entry_.request_headers.ToString(),
+          current_entry_.headers->raw_headers(),
+          std::move(consumer_handle),
+          mojo::WrapCallbackWithDefaultInvokeIfNotRun(
+              base::BindOnce(&HttpCacheSeeder::OnEntryWritten,
+                             weak_factory_.GetWeakPtr()),
+              net::ERR_ABORTED));
+}
+
+void HttpCacheSeeder::OnEntryWritten(int result) {
+  if (result != net::OK) {
+    Finish(result);
+    return;
+  }
+  WriteNextEntry();
+}
+
+void HttpCacheSeeder::Finish(int result) {
+  std::move(callback_).Run(result, result == net::OK ? GURL()
+                                                     : current_entry_.url);
+  delete this;
+}
+
+}  // namespace electron
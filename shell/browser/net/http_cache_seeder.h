@@ -0,0 +1,97 @@
+// Copyright (c) 2021 GitHub, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#ifndef SHELL_BROWSER_NET_HTTP_CACHE_SEEDER_H_
+#define SHELL_BROWSER_NET_HTTP_CACHE_SEEDER_H_
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "base/callback.h"
+#include "base/containers/queue.h"
+#include "base/files/file.h"
+#include "base/files/file_path.h"
+#include "base/macros.h"
+#include "base/memory/scoped_refptr.h"
+#include "base/memory/weak_ptr.h"
+#include "base/optional.h"
+#include "net/http/http_request_headers.h"
+#include "net/http/http_response_headers.h"
+#include "url/gurl.h"
+#include "url/origin.h"
+
+namespace electron {
+
+class ElectronBrowserContext;
+
+// Imports responses shipped with the app into the HTTP cache of a browser
+// context, so that they are served from the cache like any response that
+// was fetched from the network. The bodies are read from files on a worker
+// and streamed into the network service, one entry at a time.
+class HttpCacheSeeder {
+ public:
+  struct Entry {
+    Entry();
+    Entry(Entry&&);
+    ~Entry();
+    Entry& operator=(Entry&&);
+
+    GURL url;
+    // The top-level frame the entry is cached for, the site of |url| when
+    // not set. Pages of other sites do not see the entry.
+    base::Optional<url::Origin> top_frame_origin;
+    // The headers of the requests the entry is used for, only the ones named
+    // by the Vary header of the response are kept.
+    net::HttpRequestHeaders request_headers;
+    // Describes a 200 response, Content-Length is set from the file.
+    scoped_refptr<net::HttpResponseHeaders> headers;
+    base::FilePath path;
+  };
+
+  // Called with net::OK once every entry is written, or with the error of
+  // the first entry that could not be written.
+  using CompletionCallback =
+      base::OnceCallback<void(int net_error, const GURL& failed_url)>;
+
+  // Checks that |entry| can be cached like a network response, otherwise
+  // returns false and sets |error|.
+  static bool ValidateEntry(const Entry& entry, std::string* error);
+
+  // The seeder deletes itself once |callback| has run.
+  static void Start(ElectronBrowserContext* browser_context,
+                    std::vector<Entry> entries,
+                    CompletionCallback callback);
+
+ private:
+  struct BodyFile {
+    base::File file;
+    int64_t length = -1;
+  };
+
+  HttpCacheSeeder(ElectronBrowserContext* browser_context,
+                  std::vector<Entry> entries,
+                  CompletionCallback callback);
+  ~HttpCacheSeeder();
+
+  static BodyFile OpenBodyFile(const base::FilePath& path);
+
+  void WriteNextEntry();
+  void OnBodyFileOpened(BodyFile body_file);
+  void OnEntryWritten(int result);
+  void Finish(int result);
+
+  base::WeakPtr<ElectronBrowserContext> browser_context_;
+  base::queue<Entry> entries_;
+  Entry current_entry_;
+  CompletionCallback callback_;
+
+  base::WeakPtrFactory<HttpCacheSeeder> weak_factory_{this};
+
+  DISALLOW_COPY_AND_ASSIGN(HttpCacheSeeder);
+};
+
+}  // namespace electron
+
+#endif  // SHELL_BROWSER_NET_HTTP_CACHE_SEEDER_H_
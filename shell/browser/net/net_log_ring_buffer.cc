@@ -0,0 +1,197 @@
+// Copyright (c) 2021 GitHub, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#include "shell/browser/net/net_log_ring_buffer.h"
+
+#include <set>
+#include <string>
+#include <utility>
+
+#include "base/files/file_util.h"
+#include "base/json/json_reader.h"
+#include "base/strings/string_piece.h"
+#include "base/strings/string_split.h"
+#include "base/strings/string_util.h"
+#include "base/threading/scoped_blocking_call.h"
+
+namespace electron {
+
+namespace {
+
+// The net log exporter writes the constants and then one event per line.
+constexpr char kConstantsPrefix[] = "{\"constants\":";
+
+std::map<int, std::string> GetNamesByValue(const base::Value* dict) {
+  std::map<int, std::string> names;
+  if (!dict || !dict->is_dict())
+    return names;
+  for (const auto& item : dict->DictItems()) {
+    if (item.second.is_int())
+      names[item.second.GetInt()] = item.first;
+  }
+  return names;
+}
+
+// Replaces the integer at |key| in |dict| with its name, if it is known.
+void ReplaceWithName(base::Value* dict,
+                     base::StringPiece key,
+                     const std::map<int, std::string>& names) {
+  const base::Value* value = dict->FindKey(key);
+  if (!value || !value->is_int())
+    return;
+  auto it = names.find(value->GetInt());
+  if (it != names.end())
+    dict->SetStringKey(key, it->second);
+}
+
+bool MatchesFilter(const base::Value& dict,
+                   base::StringPiece key,
+                   const std::set<std::string>& filter) {
+  if (filter.empty())
+    return true;
+  const std::string* name = dict.FindStringKey(key);
+  return name && filter.count(*name);
+}
+
+}  // namespace
+
+NetLogRingBuffer::Options::Options() = default;
+NetLogRingBuffer::Options::Options(const Options&) = default;
+NetLogRingBuffer::Options::~Options() = default;
+
+NetLogRingBuffer::NetLogRingBuffer(
+    scoped_refptr<base::SequencedTaskRunner> task_runner,
+    const Options& options)
+    : base::RefCountedDeleteOnSequence<NetLogRingBuffer>(
+          std::move(task_runner)),
+      options_(options) {}
+
+NetLogRingBuffer::~NetLogRingBuffer() {
+  base::ScopedBlockingCall scoped_blocking_call(FROM_HERE,
+                                                base::BlockingType::MAY_BLOCK);
+  for (const auto& path : segments_)
+    base::DeleteFile(path);
+}
+
+base::File NetLogRingBuffer::OpenSegment() {
+  DCHECK(owning_task_runner()->RunsTasksInCurrentSequence());
+  base::ScopedBlockingCall scoped_blocking_call(FROM_HERE,
+                                                base::BlockingType::MAY_BLOCK);
+  base::FilePath path;
+  if (!base::CreateTemporaryFile(&path))
+    return base::File(base::File::GetLastFileError());
+
+  base::File output(path,
+                    base::File::FLAG_CREATE_ALWAYS | base::File::FLAG_WRITE);
+  if (!output.IsValid()) {
+    base::DeleteFile(path);
+    return output;
+  }
+
+  segments_.push_back(path);
+  return output;
+}
+
+void NetLogRingBuffer::DiscardNewestSegment() {
+  DCHECK(owning_task_runner()->RunsTasksInCurrentSequence());
+  if (segments_.empty())
+    return;
+  base::ScopedBlockingCall scoped_blocking_call(FROM_HERE,
+                                                base::BlockingType::MAY_BLOCK);
+  base::DeleteFile(segments_.back());
+  segments_.pop_back();
+}
+
+void NetLogRingBuffer::ReadSegment() {
+  DCHECK(owning_task_runner()->RunsTasksInCurrentSequence());
+  if (segments_.empty())
+    return;
+  base::ScopedBlockingCall scoped_blocking_call(FROM_HERE,
+                                                base::BlockingType::MAY_BLOCK);
+  base::FilePath path = segments_.front();
+  segments_.pop_front();
+  std::string contents;
+  if (base::ReadFileToString(path, &contents))
+    ParseSegment(contents);
+  base::DeleteFile(path);
+}
+
+base::Value NetLogRingBuffer::GetEvents() const {
+  DCHECK(owning_task_runner()->RunsTasksInCurrentSequence());
+  base::Value events(base::Value::Type::LIST);
+  for (const auto& entry : events_)
+    events.Append(entry.event.Clone());
+  return events;
+}
+
+void NetLogRingBuffer::ParseSegment(base::StringPiece contents) {
+  std::set<EventKey> keys;
+  for (base::StringPiece line : base::SplitStringPiece(
+           contents, "\n", base::TRIM_WHITESPACE, base::SPLIT_WANT_NONEMPTY)) {
+    if (base::StartsWith(line, kConstantsPrefix)) {
+      // Every segment starts with the same constants.
+      if (!has_constants_)
+        ParseConstants(line.substr(sizeof(kConstantsPrefix) - 1));
+      continue;
+    }
+    // Skip everything that is not an event, e.g. the trailing data written
+    // when the log is stopped.
+    if (!has_constants_ || !base::StartsWith(line, "{"))
+      continue;
+    if (base::EndsWith(line, ","))
+      line.remove_suffix(1);
+
+    base::Optional<base::Value> event = base::JSONReader::Read(line);
+    if (!event || !event->is_dict())
+      continue;
+    base::Value* source = event->FindDictKey("source");
+    const std::string* time = event->FindStringKey("time");
+    EventKey key(time ? *time : std::string(),
+                 source ? source->FindIntKey("id").value_or(-1) : -1,
+                 event->FindIntKey("type").value_or(-1),
+                 event->FindIntKey("phase").value_or(-1));
+
+    ReplaceWithName(&*event, "type", event_type_names_);
+    ReplaceWithName(&*event, "phase", phase_names_);
+    if (source)
+      ReplaceWithName(source, "type", source_type_names_);
+
+    if (!MatchesFilter(*event, "type", options_.event_types))
+      continue;
+    if (!options_.source_types.empty() &&
+        (!source || !MatchesFilter(*source, "type", options_.source_types))) {
+      continue;
+    }
+
+    keys.insert(key);
+    if (previous_keys_.count(key))
+      continue;
+    AddEvent(std::move(*event), line.size());
+  }
+  previous_keys_ = std::move(keys);
+}
+
+void NetLogRingBuffer::ParseConstants(base::StringPiece json) {
+  if (base::EndsWith(json, ","))
+    json.remove_suffix(1);
+  base::Optional<base::Value> constants = base::JSONReader::Read(json);
+  if (!constants || !constants->is_dict())
+    return;
+
+  event_type_names_ = GetNamesByValue(constants->FindKey("logEventTypes"));
+  source_type_names_ = GetNamesByValue(constants->FindKey("logSourceType"));
+  phase_names_ = GetNamesByValue(constants->FindKey("logEventPhase"));
+  has_constants_ = true;
+}
+
+void NetLogRingBuffer::AddEvent(base::Value event, size_t size) {
+  events_.push_back({std::move(event), size});
+  size_ += size;
+  while (size_ > options_.max_size && !events_.empty()) {
+    size_ -= events_.front().size;
+    events_.pop_front();
+  }
+}
+
+}  // namespace electron
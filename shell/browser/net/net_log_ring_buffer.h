@@ -0,0 +1,105 @@
+// Copyright (c) 2021 GitHub, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#ifndef SHELL_BROWSER_NET_NET_LOG_RING_BUFFER_H_
+#define SHELL_BROWSER_NET_NET_LOG_RING_BUFFER_H_
+
+#include <deque>
+#include <map>
+#include <set>
+#include <string>
+#include <tuple>
+
+#include "base/files/file.h"
+#include "base/files/file_path.h"
+#include "base/memory/ref_counted_delete_on_sequence.h"
+#include "base/sequenced_task_runner.h"
+#include "base/strings/string_piece.h"
+#include "base/values.h"
+
+namespace electron {
+
+// Keeps the most recent events of a net log in memory.
+//
+// The network service runs out of process and can only export its net log to
+// files, so the log is written to a sequence of temporary files, or segments.
+// A new segment is started before the previous one is stopped, and once the
+// net log has finished writing a segment the events that pass the filters
+// are read into a buffer bounded by |max_size| bytes and the file is deleted.
+// All methods other than the constructor must be called on |task_runner|,
+// which must allow blocking.
+class NetLogRingBuffer
+    : public base::RefCountedDeleteOnSequence<NetLogRingBuffer> {
+ public:
+  struct Options {
+    Options();
+    Options(const Options&);
+    ~Options();
+
+    // The size of the JSON of the events kept in memory.
+    size_t max_size = 0;
+    // Names of the event and source types to keep, empty sets keep all.
+    std::set<std::string> event_types;
+    std::set<std::string> source_types;
+  };
+
+  NetLogRingBuffer(scoped_refptr<base::SequencedTaskRunner> task_runner,
+                   const Options& options);
+
+  // Creates the temporary file of a new segment and returns the handle the
+  // net log should be written to. Returns an invalid file on failure.
+  base::File OpenSegment();
+
+  // Deletes the file of the newest segment, which the net log failed to
+  // start writing to.
+  void DiscardNewestSegment();
+
+  // Reads the events of the oldest segment, which the net log must have
+  // stopped writing, into the buffer and deletes its file.
+  void ReadSegment();
+
+  // Returns the buffered events, oldest first, with their type, source type
+  // and phase replaced by their names.
+  base::Value GetEvents() const;
+
+ private:
+  friend class base::RefCountedDeleteOnSequence<NetLogRingBuffer>;
+  friend class base::DeleteHelper<NetLogRingBuffer>;
+
+  ~NetLogRingBuffer();
+
+  void ParseSegment(base::StringPiece contents);
+  void ParseConstants(base::StringPiece json);
+  void AddEvent(base::Value event, size_t size);
+
+  // Identifies an event by its time, source ID, type and phase.
+  using EventKey = std::tuple<std::string, int, int, int>;
+
+  const Options options_;
+
+  std::deque<base::FilePath> segments_;
+
+  // The events kept from the last segment that was read. A segment starts
+  // with the events that were logged while the previous one was being
+  // stopped, which are skipped.
+  std::set<EventKey> previous_keys_;
+
+  std::map<int, std::string> event_type_names_;
+  std::map<int, std::string> source_type_names_;
+  std::map<int, std::string> phase_names_;
+  bool has_constants_ = false;
+
+  struct Entry {
+    base::Value event;
+    size_t size;
+  };
+  std::deque<Entry> events_;
+  size_t size_ = 0;
+
+  DISALLOW_COPY_AND_ASSIGN(NetLogRingBuffer);
+};
+
+}  // namespace electron
+
+#endif  // SHELL_BROWSER_NET_NET_LOG_RING_BUFFER_H_
@@ -4,14 +4,54 @@
 
 #include "shell/browser/net/node_stream_loader.h"
 
+#include <algorithm>
 #include <utility>
 
+#include "base/files/file.h"
+#include "base/no_destructor.h"
+#include "base/task/thread_pool.h"
+#include "mojo/public/cpp/system/file_data_source.h"
 #include "mojo/public/cpp/system/string_data_source.h"
+#include "shell/common/asar/asar_util.h"
 #include "shell/common/gin_converters/callback_converter.h"
+#include "shell/common/gin_converters/file_path_converter.h"
+#include "shell/common/gin_helper/dictionary.h"
 #include "shell/common/node_includes.h"
 
 namespace electron {
 
+namespace {
+
+// The capacity of the data pipe, larger than the default so that a single
+// chunk of a high-bitrate stream rarely has to wait for the pipe to drain.
+constexpr uint32_t kDataPipeCapacity = 512 * 1024;
+
+// How many bytes are read from the stream ahead of what has been written.
+constexpr size_t kMaxBufferedBytes = 1024 * 1024;
+
+std::unique_ptr<mojo::DataPipeProducer::DataSource> OpenFileRange(
+    const base::FilePath& path,
+    uint64_t start,
+    uint64_t end) {
+  base::File file(path, base::File::FLAG_OPEN | base::File::FLAG_READ);
+  if (!file.IsValid())
+    return nullptr;
+  int64_t length = file.GetLength();
+  if (length < 0)
+    return nullptr;
+  end = std::min(end, static_cast<uint64_t>(length));
+  auto data_source = std::make_unique<mojo::FileDataSource>(std::move(file));
+  data_source->SetRange(std::min(start, end), end);
+  return data_source;
+}
+
+v8::Global<v8::Function>* GetFileReadStreamCheckerReference() {
+  static base::NoDestructor<v8::Global<v8::Function>> checker;
+  return checker.get();
+}
+
+}  // namespace
+
 NodeStreamLoader::NodeStreamLoader(
     network::mojom::URLResponseHeadPtr head,
     mojo::PendingReceiver<network::mojom::URLLoader> loader,
@@ -49,10 +89,73 @@ NodeStreamLoader::~NodeStreamLoader() {
   }
 }
 
+// static
+void NodeStreamLoader::SetFileReadStreamChecker(
+    v8::Isolate* isolate,
+    v8::Local<v8::Function> checker) {
+  GetFileReadStreamCheckerReference()->Reset(isolate, checker);
+}
+
+// static
+bool NodeStreamLoader::GetUnreadFileRange(v8::Isolate* isolate,
+                                          v8::Local<v8::Object> emitter,
+                                          FileRange* range) {
+  // Subclasses and streams that read through another fs implementation may
+  // produce other data than the file holds, they are read through the stream.
+  auto* checker = GetFileReadStreamCheckerReference();
+  if (checker->IsEmpty())
+    return false;
+  v8::TryCatch try_catch(isolate);
+  v8::Local<v8::Context> context = isolate->GetCurrentContext();
+  v8::Local<v8::Value> args[] = {emitter};
+  v8::Local<v8::Value> is_file_read_stream;
+  if (!checker->Get(isolate)
+           ->Call(context, v8::Undefined(isolate), node::arraysize(args), args)
+           .ToLocal(&is_file_read_stream) ||
+      !is_file_read_stream->IsTrue())
+    return false;
+
+  gin_helper::Dictionary stream(isolate, emitter);
+  // The stream has not started reading while |bytesRead| is 0 and nothing is
+  // buffered.
+  int64_t bytes_read = -1;
+  double readable_length = -1;
+  v8::Local<v8::Value> pending;
+  if (!stream.Get("path", &range->path) ||
+      !stream.Get("bytesRead", &bytes_read) || bytes_read != 0 ||
+      !stream.Get("readableLength", &readable_length) || readable_length != 0 ||
+      !stream.Get("pending", &pending) || !pending->IsBoolean())
+    return false;
+
+  // A stream with an encoding emits strings, which are not supported.
+  v8::Local<v8::Value> encoding;
+  if (stream.Get("readableEncoding", &encoding) && !encoding->IsNull())
+    return false;
+
+  // Files in asar archives are only readable through the patched fs module.
+  base::FilePath asar_path, relative_path;
+  if (asar::GetAsarArchivePath(range->path, &asar_path, &relative_path))
+    return false;
+
+  double start = 0;
+  if (stream.Get("start", &start)) {
+    if (start < 0)
+      return false;
+    range->start = static_cast<uint64_t>(start);
+  }
+  double end = 0;
+  if (stream.Get("end", &end) && end < std::numeric_limits<uint64_t>::max()) {
+    if (end < 0)
+      return false;
+    range->end = static_cast<uint64_t>(end) + 1;
+  }
+  return true;
+}
+
 void NodeStreamLoader::Start(network::mojom::URLResponseHeadPtr head) {
   mojo::ScopedDataPipeProducerHandle producer;
   mojo::ScopedDataPipeConsumerHandle consumer;
-  MojoResult rv = mojo::CreateDataPipe(nullptr, producer, consumer);
+  MojoResult rv = mojo::CreateDataPipe(kDataPipeCapacity, producer, consumer);
   if (rv != MOJO_RESULT_OK) {
     NotifyComplete(net::ERR_INSUFFICIENT_RESOURCES);
     return;
@@ -63,24 +166,73 @@ void NodeStreamLoader::Start(network::mojom::URLResponseHeadPtr head) {
   client_->OnStartLoadingResponseBody(std::move(consumer));
 
   auto weak = weak_factory_.GetWeakPtr();
-  On("end",
-     base::BindRepeating(&NodeStreamLoader::NotifyComplete, weak, net::OK));
   On("error", base::BindRepeating(&NodeStreamLoader::NotifyComplete, weak,
                                   net::ERR_FAILED));
+  if (!weak)
+    return;
+
+  FileRange range;
+  {
+    v8::HandleScope handle_scope(isolate_);
+    if (!GetUnreadFileRange(isolate_, emitter_.Get(isolate_), &range)) {
+      StartReadingStream();
+      return;
+    }
+  }
+
+  // The stream is left paused, it is destroyed together with this loader.
+  is_writing_ = true;
+  base::ThreadPool::PostTaskAndReplyWithResult(
+      FROM_HERE, {base::MayBlock(), base::TaskPriority::USER_BLOCKING},
+      base::BindOnce(&OpenFileRange, range.path, range.start, range.end),
+      base::BindOnce(&NodeStreamLoader::OnFileOpened, weak));
+}
+
+void NodeStreamLoader::StartReadingStream() {
+  auto weak = weak_factory_.GetWeakPtr();
+  On("end",
+     base::BindRepeating(&NodeStreamLoader::NotifyComplete, weak, net::OK));
+  if (!weak)
+    return;
   On("readable", base::BindRepeating(&NodeStreamLoader::NotifyReadable, weak));
 }
 
+void NodeStreamLoader::OnFileOpened(
+    std::unique_ptr<mojo::DataPipeProducer::DataSource> data_source) {
+  is_writing_ = false;
+  if (ended_) {
+    NotifyComplete(result_);
+    return;
+  }
+
+  // Let the stream itself report why the file can not be read.
+  if (!data_source) {
+    StartReadingStream();
+    return;
+  }
+
+  is_writing_ = true;
+  producer_->Write(std::move(data_source),
+                   base::BindOnce(&NodeStreamLoader::DidWriteFile,
+                                  weak_factory_.GetWeakPtr()));
+}
+
 void NodeStreamLoader::NotifyReadable() {
-  if (!readable_)
-    ReadMore();
-  else if (is_reading_)
-    has_read_waiting_ = true;
   readable_ = true;
+  if (is_reading_)
+    has_read_waiting_ = true;
+  else
+    ReadMore();
 }
 
 void NodeStreamLoader::NotifyComplete(int result) {
-  // Wait until write finishes or fails.
-  if (is_reading_ || is_writing_) {
+  // Nothing more is written after a failure.
+  if (result != net::OK) {
+    queued_buffers_ = base::queue<v8::Global<v8::Value>>();
+  }
+
+  // Wait until write finishes or fails, and queued buffers are written.
+  if (is_reading_ || is_writing_ || !queued_buffers_.empty()) {
     ended_ = true;
     result_ = result;
     return;
@@ -100,56 +252,90 @@ void NodeStreamLoader::ReadMore() {
   is_reading_ = true;
   auto weak = weak_factory_.GetWeakPtr();
   v8::HandleScope scope(isolate_);
-  // buffer = emitter.read()
-  v8::MaybeLocal<v8::Value> ret = node::MakeCallback(
-      isolate_, emitter_.Get(isolate_), "read", 0, nullptr, {0, 0});
-  DCHECK(weak) << "We shouldn't have been destroyed when calling read()";
-
-  // If there is no buffer read, wait until |readable| is emitted again.
-  v8::Local<v8::Value> buffer;
-  if (!ret.ToLocal(&buffer) || !node::Buffer::HasInstance(buffer)) {
-    is_reading_ = false;
-
-    // If 'readable' was called after 'read()', try again
-    if (has_read_waiting_) {
-      has_read_waiting_ = false;
-      ReadMore();
-      return;
-    }
+  // Keep reading while earlier buffers are being written, so that the stream
+  // and the pipe work in parallel.
+  while (!ended_ && buffered_bytes_ < kMaxBufferedBytes) {
+    // buffer = emitter.read()
+    v8::MaybeLocal<v8::Value> ret = node::MakeCallback(
+        isolate_, emitter_.Get(isolate_), "read", 0, nullptr, {0, 0});
+    DCHECK(weak) << "We shouldn't have been destroyed when calling read()";
 
-    readable_ = false;
-    if (ended_) {
-      NotifyComplete(result_);
+    // If there is no buffer read, wait until |readable| is emitted again.
+    v8::Local<v8::Value> buffer;
+    if (!ret.ToLocal(&buffer) || !node::Buffer::HasInstance(buffer)) {
+      // If 'readable' was called after 'read()', try again
+      if (has_read_waiting_) {
+        has_read_waiting_ = false;
+        continue;
+      }
+      readable_ = false;
+      break;
     }
-    return;
+
+    buffered_bytes_ += node::Buffer::Length(buffer);
+    queued_buffers_.emplace(isolate_, buffer);
   }
+  is_reading_ = false;
+
+  if (is_writing_)
+    return;
+  if (!queued_buffers_.empty())
+    WriteNext();
+  else if (ended_)
+    NotifyComplete(result_);
+}
+
+void NodeStreamLoader::WriteNext() {
+  DCHECK(!is_writing_);
+  DCHECK(!queued_buffers_.empty());
 
   // Hold the buffer until the write is done.
-  buffer_.Reset(isolate_, buffer);
+  buffer_ = std::move(queued_buffers_.front());
+  queued_buffers_.pop();
+
+  v8::HandleScope scope(isolate_);
+  v8::Local<v8::Value> buffer = buffer_.Get(isolate_);
 
   // Write buffer to mojo pipe asynchronously.
-  is_reading_ = false;
   is_writing_ = true;
   producer_->Write(std::make_unique<mojo::StringDataSource>(
                        base::StringPiece(node::Buffer::Data(buffer),
                                          node::Buffer::Length(buffer)),
                        mojo::StringDataSource::AsyncWritingMode::
                            STRING_STAYS_VALID_UNTIL_COMPLETION),
-                   base::BindOnce(&NodeStreamLoader::DidWrite, weak));
+                   base::BindOnce(&NodeStreamLoader::DidWrite,
+                                  weak_factory_.GetWeakPtr()));
 }
 
 void NodeStreamLoader::DidWrite(MojoResult result) {
   is_writing_ = false;
-  // We were told to end streaming.
-  if (ended_) {
+  {
+    v8::HandleScope scope(isolate_);
+    buffered_bytes_ -= node::Buffer::Length(buffer_.Get(isolate_));
+  }
+  buffer_.Reset();
+
+  if (result != MOJO_RESULT_OK) {
+    NotifyComplete(net::ERR_FAILED);
+    return;
+  }
+
+  if (!queued_buffers_.empty()) {
+    WriteNext();
+  } else if (ended_) {
+    // We were told to end streaming.
     NotifyComplete(result_);
     return;
   }
 
-  if (result == MOJO_RESULT_OK && readable_)
+  if (readable_)
     ReadMore();
-  else
-    NotifyComplete(net::ERR_FAILED);
+}
+
+void NodeStreamLoader::DidWriteFile(MojoResult result) {
+  is_writing_ = false;
+  // Keep the error the stream may have reported while the file was written.
+  NotifyComplete(result == MOJO_RESULT_OK ? result_ : net::ERR_FAILED);
 }
 
 void NodeStreamLoader::On(const char* event, EventCallback callback) {
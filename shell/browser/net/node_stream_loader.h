@@ -5,11 +5,14 @@
 #ifndef SHELL_BROWSER_NET_NODE_STREAM_LOADER_H_
 #define SHELL_BROWSER_NET_NODE_STREAM_LOADER_H_
 
+#include <limits>
 #include <map>
 #include <memory>
 #include <string>
 #include <vector>
 
+#include "base/containers/queue.h"
+#include "base/files/file_path.h"
 #include "mojo/public/cpp/bindings/pending_remote.h"
 #include "mojo/public/cpp/bindings/remote.h"
 #include "mojo/public/cpp/system/data_pipe_producer.h"
@@ -26,7 +29,11 @@ namespace electron {
 //
 // We use |paused mode| to read data from |Readable| stream, so we don't need to
 // copy data from buffer and hold it in memory, and we only need to make sure
-// the passed |Buffer| is alive while writing data to pipe.
+// the passed |Buffer| is alive while writing data to pipe. Reading continues
+// while a buffer is being written, until |kMaxBufferedBytes| are held.
+//
+// A fs.ReadStream that has not been read from yet is not read through
+// JavaScript at all, its file is streamed into the pipe directly instead.
 class NodeStreamLoader : public network::mojom::URLLoader {
  public:
   NodeStreamLoader(network::mojom::URLResponseHeadPtr head,
@@ -35,16 +42,41 @@ class NodeStreamLoader : public network::mojom::URLLoader {
                    v8::Isolate* isolate,
                    v8::Local<v8::Object> emitter);
 
+  // Sets the function that tells whether a stream is a plain fs.ReadStream
+  // that reads its file with the fs module.
+  static void SetFileReadStreamChecker(v8::Isolate* isolate,
+                                       v8::Local<v8::Function> checker);
+
  private:
   ~NodeStreamLoader() override;
 
   using EventCallback = base::RepeatingCallback<void()>;
 
+  // The part of a file that a fs.ReadStream would read.
+  struct FileRange {
+    base::FilePath path;
+    uint64_t start = 0;
+    // Exclusive, unlike the |end| option of fs.createReadStream().
+    uint64_t end = std::numeric_limits<uint64_t>::max();
+  };
+
+  // Returns true if |emitter| is a fs.ReadStream whose data can be read from
+  // its file directly, as told by the function passed to
+  // SetFileReadStreamChecker().
+  static bool GetUnreadFileRange(v8::Isolate* isolate,
+                                 v8::Local<v8::Object> emitter,
+                                 FileRange* range);
+
   void Start(network::mojom::URLResponseHeadPtr head);
+  void StartReadingStream();
+  void OnFileOpened(
+      std::unique_ptr<mojo::DataPipeProducer::DataSource> data_source);
   void NotifyReadable();
   void NotifyComplete(int result);
   void ReadMore();
+  void WriteNext();
   void DidWrite(MojoResult result);
+  void DidWriteFile(MojoResult result);
 
   // Subscribe to events of |emitter|.
   void On(const char* event, EventCallback callback);
@@ -65,7 +97,12 @@ class NodeStreamLoader : public network::mojom::URLLoader {
 
   v8::Isolate* isolate_;
   v8::Global<v8::Object> emitter_;
+
+  // The buffer being written to the pipe, and the buffers read after it.
   v8::Global<v8::Value> buffer_;
+  base::queue<v8::Global<v8::Value>> queued_buffers_;
+  // The size of all the buffers above.
+  size_t buffered_bytes_ = 0;
 
   // Mojo data pipe where the data that is being read is written to.
   std::unique_ptr<mojo::DataPipeProducer> producer_;
@@ -81,9 +118,9 @@ class NodeStreamLoader : public network::mojom::URLLoader {
   bool ended_ = false;
   int result_ = net::OK;
 
-  // When the stream emits the readable event, we only want to start reading
-  // data if the stream was not readable before, so we store the state in a
-  // flag.
+  // Whether the stream may have data to read, it is set by the readable event
+  // and cleared once read() returns nothing. Reading stops while too much
+  // data is buffered and resumes when a write finishes.
   bool readable_ = false;
 
   // It's possible for reads to be queued using nextTick() during read()
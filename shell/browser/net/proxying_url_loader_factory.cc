@@ -17,6 +17,7 @@
 #include "services/metrics/public/cpp/ukm_source_id.h"
 #include "services/network/public/cpp/features.h"
 #include "shell/browser/net/asar/asar_url_loader.h"
+#include "shell/browser/net/traffic_shaper.h"
 #include "shell/common/options_switches.h"
 
 namespace electron {
@@ -512,10 +513,13 @@ void ProxyingURLLoaderFactory::InProgressRequest::ContinueToStartRequest(
     // might, so we need to set the option on the loader.
     if (has_any_extra_headers_listeners_)
       options |= network::mojom::kURLLoadOptionUseHeaderClient;
+    // Only the requests that webRequest let through are shaped and counted.
+    mojo::PendingRemote<network::mojom::URLLoaderClient> client =
+        proxied_client_receiver_.BindNewPipeAndPassRemote();
+    factory_->traffic_shaper_->ShapeRequest(&request_, &client);
     factory_->target_factory_->CreateLoaderAndStart(
         mojo::MakeRequest(&target_loader_), routing_id_,
-        network_service_request_id_, options, request_,
-        proxied_client_receiver_.BindNewPipeAndPassRemote(),
+        network_service_request_id_, options, request_, std::move(client),
         traffic_annotation_);
   }
 
@@ -744,6 +748,7 @@ void ProxyingURLLoaderFactory::InProgressRequest::OnRequestError(
 ProxyingURLLoaderFactory::ProxyingURLLoaderFactory(
     WebRequestAPI* web_request_api,
     const HandlersMap& intercepted_handlers,
+    TrafficShaper* traffic_shaper,
     int render_process_id,
     uint64_t* request_id_generator,
     std::unique_ptr<extensions::ExtensionNavigationUIData> navigation_ui_data,
@@ -755,6 +760,7 @@ ProxyingURLLoaderFactory::ProxyingURLLoaderFactory(
     content::ContentBrowserClient::URLLoaderFactoryType loader_factory_type)
     : web_request_api_(web_request_api),
       intercepted_handlers_(intercepted_handlers),
+      traffic_shaper_(traffic_shaper),
       render_process_id_(render_process_id),
       request_id_generator_(request_id_generator),
       navigation_ui_data_(std::move(navigation_ui_data)),
@@ -831,6 +837,10 @@ void ProxyingURLLoaderFactory::CreateLoaderAndStart(
   }
 
   if (!web_request_api()->HasListener()) {
+    // Apply the session's traffic classes to requests hitting the network,
+    // the ones that go through webRequest are shaped once it lets them
+    // through.
+    traffic_shaper_->ShapeRequest(&request, &client);
     // Pass-through to the original factory.
     target_factory_->CreateLoaderAndStart(
         std::move(loader), routing_id, request_id, options, request,
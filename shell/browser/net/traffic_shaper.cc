@@ -0,0 +1,483 @@
+// Copyright (c) 2021 GitHub, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#include "shell/browser/net/traffic_shaper.h"
+
+#include <limits>
+#include <memory>
+#include <numeric>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "base/bind.h"
+#include "base/check_op.h"
+#include "base/files/file_util.h"
+#include "base/memory/ptr_util.h"
+#include "base/memory/ref_counted.h"
+#include "base/task/thread_pool.h"
+#include "extensions/browser/api/web_request/web_request_resource_type.h"
+#include "mojo/public/cpp/bindings/receiver.h"
+#include "mojo/public/cpp/bindings/remote.h"
+#include "mojo/public/cpp/bindings/self_owned_receiver.h"
+#include "net/base/net_errors.h"
+#include "net/url_request/redirect_info.h"
+#include "services/network/public/cpp/data_element.h"
+#include "services/network/public/cpp/resource_request.h"
+#include "services/network/public/cpp/resource_request_body.h"
+#include "services/network/public/cpp/url_loader_completion_status.h"
+#include "services/network/public/mojom/chunked_data_pipe_getter.mojom.h"
+#include "services/network/public/mojom/data_pipe_getter.mojom.h"
+#include "services/network/public/mojom/url_loader.mojom.h"
+#include "services/network/public/mojom/url_response_head.mojom.h"
+#include "shell/browser/electron_browser_context.h"
+#include "shell/common/gin_converters/net_converter.h"
+
+namespace electron {
+
+namespace {
+
+// The size of a request body. The sizes of data pipe elements are filled in
+// once the network service has read them, and the sizes of files sent to
+// their end once they have been looked up.
+class UploadSize : public base::RefCounted<UploadSize> {
+ public:
+  explicit UploadSize(size_t element_count) : sizes_(element_count) {}
+
+  void set_element_size(size_t index, uint64_t size) { sizes_[index] = size; }
+
+  // Marks the size of an element as being looked up. The callbacks passed to
+  // RunWhenResolved() wait for it.
+  void AddPendingElement() { ++pending_count_; }
+  void ResolveElementSize(size_t index, uint64_t size) {
+    set_element_size(index, size);
+    DCHECK_GT(pending_count_, 0u);
+    if (--pending_count_ > 0)
+      return;
+    for (auto& callback : resolved_callbacks_)
+      std::move(callback).Run();
+    resolved_callbacks_.clear();
+  }
+
+  // Runs |callback| once the sizes of all the elements are known.
+  void RunWhenResolved(base::OnceClosure callback) {
+    if (pending_count_ == 0)
+      std::move(callback).Run();
+    else
+      resolved_callbacks_.push_back(std::move(callback));
+  }
+
+  uint64_t total() const {
+    return std::accumulate(sizes_.begin(), sizes_.end(), uint64_t{0});
+  }
+
+ private:
+  friend class base::RefCounted<UploadSize>;
+  ~UploadSize() = default;
+
+  std::vector<uint64_t> sizes_;
+  size_t pending_count_ = 0;
+  std::vector<base::OnceClosure> resolved_callbacks_;
+
+  DISALLOW_COPY_AND_ASSIGN(UploadSize);
+};
+
+using SizeCallback = base::OnceCallback<void(int32_t status, uint64_t size)>;
+
+void RecordElementSize(scoped_refptr<UploadSize> upload_size,
+                       size_t index,
+                       SizeCallback callback,
+                       int32_t status,
+                       uint64_t size) {
+  if (status == net::OK)
+    upload_size->set_element_size(index, size);
+  std::move(callback).Run(status, size);
+}
+
+// Forwards to the data pipe getter of a body element, and records the size
+// of the data it provides.
+class SizeRecordingDataPipeGetter : public network::mojom::DataPipeGetter {
+ public:
+  static void Create(
+      mojo::PendingRemote<network::mojom::DataPipeGetter> target,
+      scoped_refptr<UploadSize> upload_size,
+      size_t index,
+      mojo::PendingReceiver<network::mojom::DataPipeGetter> receiver) {
+    mojo::MakeSelfOwnedReceiver(
+        base::WrapUnique(new SizeRecordingDataPipeGetter(
+            std::move(target), std::move(upload_size), index)),
+        std::move(receiver));
+  }
+  ~SizeRecordingDataPipeGetter() override = default;
+
+  // network::mojom::DataPipeGetter:
+  void Read(mojo::ScopedDataPipeProducerHandle pipe,
+            ReadCallback callback) override {
+    target_->Read(std::move(pipe),
+                  base::BindOnce(&RecordElementSize, upload_size_, index_,
+                                 std::move(callback)));
+  }
+  void Clone(
+      mojo::PendingReceiver<network::mojom::DataPipeGetter> receiver) override {
+    mojo::PendingRemote<network::mojom::DataPipeGetter> target;
+    target_->Clone(target.InitWithNewPipeAndPassReceiver());
+    Create(std::move(target), upload_size_, index_, std::move(receiver));
+  }
+
+ private:
+  SizeRecordingDataPipeGetter(
+      mojo::PendingRemote<network::mojom::DataPipeGetter> target,
+      scoped_refptr<UploadSize> upload_size,
+      size_t index)
+      : target_(std::move(target)),
+        upload_size_(std::move(upload_size)),
+        index_(index) {}
+
+  mojo::Remote<network::mojom::DataPipeGetter> target_;
+  scoped_refptr<UploadSize> upload_size_;
+  const size_t index_;
+
+  DISALLOW_COPY_AND_ASSIGN(SizeRecordingDataPipeGetter);
+};
+
+// Forwards to the chunked data pipe getter of a body, and records the size it
+// reports once all of its data has been written.
+class SizeRecordingChunkedDataPipeGetter
+    : public network::mojom::ChunkedDataPipeGetter {
+ public:
+  static void Create(
+      mojo::PendingRemote<network::mojom::ChunkedDataPipeGetter> target,
+      scoped_refptr<UploadSize> upload_size,
+      size_t index,
+      mojo::PendingReceiver<network::mojom::ChunkedDataPipeGetter> receiver) {
+    mojo::MakeSelfOwnedReceiver(
+        base::WrapUnique(new SizeRecordingChunkedDataPipeGetter(
+            std::move(target), std::move(upload_size), index)),
+        std::move(receiver));
+  }
+  ~SizeRecordingChunkedDataPipeGetter() override = default;
+
+  // network::mojom::ChunkedDataPipeGetter:
+  void GetSize(GetSizeCallback callback) override {
+    target_->GetSize(base::BindOnce(&RecordElementSize, upload_size_, index_,
+                                    std::move(callback)));
+  }
+  void StartReading(mojo::ScopedDataPipeProducerHandle pipe) override {
+    target_->StartReading(std::move(pipe));
+  }
+
+ private:
+  SizeRecordingChunkedDataPipeGetter(
+      mojo::PendingRemote<network::mojom::ChunkedDataPipeGetter> target,
+      scoped_refptr<UploadSize> upload_size,
+      size_t index)
+      : target_(std::move(target)),
+        upload_size_(std::move(upload_size)),
+        index_(index) {}
+
+  mojo::Remote<network::mojom::ChunkedDataPipeGetter> target_;
+  scoped_refptr<UploadSize> upload_size_;
+  const size_t index_;
+
+  DISALLOW_COPY_AND_ASSIGN(SizeRecordingChunkedDataPipeGetter);
+};
+
+int64_t GetFileSizeOnBlockingThread(const base::FilePath& path) {
+  int64_t size = 0;
+  return base::GetFileSize(path, &size) ? size : 0;
+}
+
+void ResolveFileElementSize(scoped_refptr<UploadSize> upload_size,
+                            size_t index,
+                            uint64_t offset,
+                            int64_t file_size) {
+  uint64_t size = static_cast<uint64_t>(file_size);
+  upload_size->ResolveElementSize(index, size > offset ? size - offset : 0);
+}
+
+bool HasDataPipeElements(const network::ResourceRequestBody& body) {
+  for (const auto& element : *body.elements()) {
+    if (element.type() == network::mojom::DataElement::Tag::kDataPipe ||
+        element.type() == network::mojom::DataElement::Tag::kChunkedDataPipe)
+      return true;
+  }
+  return false;
+}
+
+// Returns the size of |*body|. The body is shared with the request that was
+// passed to the factory, so when it has data pipe elements it is replaced
+// with a copy whose data pipe getters record the size of their element when
+// the network service reads them.
+scoped_refptr<UploadSize> MeasureRequestBody(
+    scoped_refptr<network::ResourceRequestBody>* body) {
+  if (HasDataPipeElements(**body)) {
+    auto copy = base::MakeRefCounted<network::ResourceRequestBody>();
+    copy->set_identifier((*body)->identifier());
+    copy->set_contains_sensitive_info((*body)->contains_sensitive_info());
+    copy->SetAllowHTTP1ForStreamingUpload(
+        (*body)->AllowHTTP1ForStreamingUpload());
+    for (auto& element : *(*body)->elements_mutable()) {
+      // Chunked data pipe getters can not be cloned, and the body can only
+      // be streamed by the one loader that gets it, so it is moved instead.
+      if (element.type() ==
+          network::mojom::DataElement::Tag::kChunkedDataPipe) {
+        auto& chunked = element.As<network::DataElementChunkedDataPipe>();
+        copy->elements_mutable()->push_back(
+            network::DataElement(network::DataElementChunkedDataPipe(
+                chunked.ReleaseChunkedDataPipeGetter(),
+                chunked.read_only_once())));
+      } else {
+        copy->elements_mutable()->push_back(element.Clone());
+      }
+    }
+    *body = std::move(copy);
+  }
+
+  std::vector<network::DataElement>* elements = (*body)->elements_mutable();
+  auto upload_size = base::MakeRefCounted<UploadSize>(elements->size());
+  for (size_t i = 0; i < elements->size(); ++i) {
+    network::DataElement& element = (*elements)[i];
+    switch (element.type()) {
+      case network::mojom::DataElement::Tag::kBytes:
+        upload_size->set_element_size(
+            i, element.As<network::DataElementBytes>().bytes().size());
+        break;
+      case network::mojom::DataElement::Tag::kFile: {
+        const auto& file = element.As<network::DataElementFile>();
+        if (file.length() != std::numeric_limits<uint64_t>::max()) {
+          upload_size->set_element_size(i, file.length());
+          break;
+        }
+        // The upload is only counted once the size is known, so the lookup
+        // runs at the priority of the request it belongs to.
+        upload_size->AddPendingElement();
+        base::ThreadPool::PostTaskAndReplyWithResult(
+            FROM_HERE, {base::MayBlock(), base::TaskPriority::USER_VISIBLE},
+            base::BindOnce(&GetFileSizeOnBlockingThread, file.path()),
+            base::BindOnce(&ResolveFileElementSize, upload_size, i,
+                           file.offset()));
+        break;
+      }
+      case network::mojom::DataElement::Tag::kDataPipe: {
+        mojo::PendingRemote<network::mojom::DataPipeGetter> getter;
+        SizeRecordingDataPipeGetter::Create(
+            element.As<network::DataElementDataPipe>().ReleaseDataPipeGetter(),
+            upload_size, i, getter.InitWithNewPipeAndPassReceiver());
+        element = network::DataElement(
+            network::DataElementDataPipe(std::move(getter)));
+        break;
+      }
+      case network::mojom::DataElement::Tag::kChunkedDataPipe: {
+        auto& chunked = element.As<network::DataElementChunkedDataPipe>();
+        const auto read_only_once = chunked.read_only_once();
+        mojo::PendingRemote<network::mojom::ChunkedDataPipeGetter> getter;
+        SizeRecordingChunkedDataPipeGetter::Create(
+            chunked.ReleaseChunkedDataPipeGetter(), upload_size, i,
+            getter.InitWithNewPipeAndPassReceiver());
+        element = network::DataElement(network::DataElementChunkedDataPipe(
+            std::move(getter), read_only_once));
+        break;
+      }
+    }
+  }
+  return upload_size;
+}
+
+using CompleteCallback =
+    base::OnceCallback<void(uint64_t bytes_sent, uint64_t bytes_received)>;
+
+void RunCompleteCallback(CompleteCallback callback,
+                         scoped_refptr<UploadSize> upload_size,
+                         uint64_t upload_count,
+                         uint64_t bytes_received) {
+  uint64_t bytes_sent = upload_size ? upload_count * upload_size->total() : 0;
+  std::move(callback).Run(bytes_sent, bytes_received);
+}
+
+// Forwards everything to the original client, and reports the bytes sent
+// and received by the request once it completes and the size of its body is
+// known.
+//
+// A request body has been sent in full by the time a response or redirect
+// arrives for it, so the body is counted for each of them until a redirect
+// changes the method and drops the body.
+class CountingURLLoaderClient : public network::mojom::URLLoaderClient {
+ public:
+  CountingURLLoaderClient(
+      mojo::PendingRemote<network::mojom::URLLoaderClient> target,
+      const std::string& method,
+      scoped_refptr<UploadSize> upload_size,
+      CompleteCallback callback)
+      : target_(std::move(target)),
+        method_(method),
+        upload_size_(std::move(upload_size)),
+        callback_(std::move(callback)) {}
+  ~CountingURLLoaderClient() override = default;
+
+  // network::mojom::URLLoaderClient:
+  void OnReceiveEarlyHints(network::mojom::EarlyHintsPtr early_hints) override {
+    target_->OnReceiveEarlyHints(std::move(early_hints));
+  }
+  void OnReceiveResponse(network::mojom::URLResponseHeadPtr head) override {
+    CountUpload();
+    target_->OnReceiveResponse(std::move(head));
+  }
+  void OnReceiveRedirect(const net::RedirectInfo& redirect_info,
+                         network::mojom::URLResponseHeadPtr head) override {
+    CountUpload();
+    if (redirect_info.new_method != method_)
+      sends_body_ = false;
+    method_ = redirect_info.new_method;
+    target_->OnReceiveRedirect(redirect_info, std::move(head));
+  }
+  void OnUploadProgress(int64_t current_position,
+                        int64_t total_size,
+                        OnUploadProgressCallback callback) override {
+    target_->OnUploadProgress(current_position, total_size,
+                              std::move(callback));
+  }
+  void OnReceiveCachedMetadata(mojo_base::BigBuffer data) override {
+    target_->OnReceiveCachedMetadata(std::move(data));
+  }
+  void OnTransferSizeUpdated(int32_t transfer_size_diff) override {
+    target_->OnTransferSizeUpdated(transfer_size_diff);
+  }
+  void OnStartLoadingResponseBody(
+      mojo::ScopedDataPipeConsumerHandle body) override {
+    target_->OnStartLoadingResponseBody(std::move(body));
+  }
+  void OnComplete(const network::URLLoaderCompletionStatus& status) override {
+    target_->OnComplete(status);
+    if (!callback_)
+      return;
+    auto report =
+        base::BindOnce(&RunCompleteCallback, std::move(callback_),
+                       upload_size_, upload_count_, status.encoded_data_length);
+    if (upload_size_)
+      upload_size_->RunWhenResolved(std::move(report));
+    else
+      std::move(report).Run();
+  }
+
+ private:
+  void CountUpload() {
+    if (upload_size_ && sends_body_)
+      upload_count_++;
+  }
+
+  mojo::Remote<network::mojom::URLLoaderClient> target_;
+  std::string method_;
+  scoped_refptr<UploadSize> upload_size_;
+  CompleteCallback callback_;
+  bool sends_body_ = true;
+  uint64_t upload_count_ = 0;
+
+  DISALLOW_COPY_AND_ASSIGN(CountingURLLoaderClient);
+};
+
+bool MatchesTrafficClass(const TrafficShaper::TrafficClass& traffic_class,
+                         const network::ResourceRequest& request) {
+  if (!traffic_class.url_patterns.empty()) {
+    bool matches = false;
+    for (const auto& pattern : traffic_class.url_patterns) {
+      if (pattern.MatchesURL(request.url)) {
+        matches = true;
+        break;
+      }
+    }
+    if (!matches)
+      return false;
+  }
+
+  if (!traffic_class.resource_types.empty()) {
+    const char* type = WebRequestResourceTypeToName(
+        extensions::ToWebRequestResourceType(request, false));
+    if (!traffic_class.resource_types.count(type))
+      return false;
+  }
+
+  return true;
+}
+
+}  // namespace
+
+TrafficShaper::TrafficClass::TrafficClass() = default;
+TrafficShaper::TrafficClass::TrafficClass(TrafficClass&&) = default;
+TrafficShaper::TrafficClass::~TrafficClass() = default;
+TrafficShaper::TrafficClass& TrafficShaper::TrafficClass::operator=(
+    TrafficClass&&) = default;
+
+TrafficShaper::TrafficShaper() = default;
+
+TrafficShaper::~TrafficShaper() = default;
+
+// static
+TrafficShaper* TrafficShaper::FromBrowserContext(
+    content::BrowserContext* context) {
+  return static_cast<ElectronBrowserContext*>(context)->traffic_shaper();
+}
+
+void TrafficShaper::SetTrafficClasses(std::vector<TrafficClass> classes) {
+  classes_ = std::move(classes);
+  ++generation_;
+  stats_.clear();
+  for (const auto& traffic_class : classes_)
+    stats_[traffic_class.name] = Stats();
+}
+
+void TrafficShaper::ShapeRequest(
+    network::ResourceRequest* request,
+    mojo::PendingRemote<network::mojom::URLLoaderClient>* client) {
+  const TrafficClass* match = nullptr;
+  for (const auto& traffic_class : classes_) {
+    if (MatchesTrafficClass(traffic_class, *request)) {
+      match = &traffic_class;
+      break;
+    }
+  }
+
+  if (!match) {
+    if (default_throttling_profile_id_ && !request->throttling_profile_id)
+      request->throttling_profile_id = default_throttling_profile_id_;
+    return;
+  }
+
+  // Requests at MAXIMUM_PRIORITY, e.g. the ones that ignore the socket
+  // limits, must keep it.
+  if (match->priority && request->priority != net::MAXIMUM_PRIORITY)
+    request->priority = *match->priority;
+  if (match->throttling_profile_id)
+    request->throttling_profile_id = match->throttling_profile_id;
+
+  stats_[match->name].request_count++;
+
+  scoped_refptr<UploadSize> upload_size;
+  if (request->request_body)
+    upload_size = MeasureRequestBody(&request->request_body);
+
+  mojo::PendingRemote<network::mojom::URLLoaderClient> counting_client;
+  mojo::MakeSelfOwnedReceiver(
+      std::make_unique<CountingURLLoaderClient>(
+          std::move(*client), request->method, std::move(upload_size),
+          base::BindOnce(&TrafficShaper::OnRequestComplete,
+                         weak_factory_.GetWeakPtr(), generation_,
+                         match->name)),
+      counting_client.InitWithNewPipeAndPassReceiver());
+  *client = std::move(counting_client);
+}
+
+void TrafficShaper::OnRequestComplete(uint64_t generation,
+                                      const std::string& name,
+                                      uint64_t bytes_sent,
+                                      uint64_t bytes_received) {
+  if (generation != generation_)
+    return;
+  auto it = stats_.find(name);
+  if (it == stats_.end())
+    return;
+  it->second.bytes_sent += bytes_sent;
+  it->second.bytes_received += bytes_received;
+}
+
+}  // namespace electron
@@ -0,0 +1,106 @@
+// Copyright (c) 2021 GitHub, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#ifndef SHELL_BROWSER_NET_TRAFFIC_SHAPER_H_
+#define SHELL_BROWSER_NET_TRAFFIC_SHAPER_H_
+
+#include <map>
+#include <set>
+#include <string>
+#include <vector>
+
+#include "base/memory/weak_ptr.h"
+#include "base/optional.h"
+#include "base/unguessable_token.h"
+#include "extensions/common/url_pattern.h"
+#include "mojo/public/cpp/bindings/pending_remote.h"
+#include "net/base/request_priority.h"
+#include "services/network/public/mojom/url_loader.mojom-forward.h"
+
+namespace content {
+class BrowserContext;
+}  // namespace content
+
+namespace network {
+struct ResourceRequest;
+}  // namespace network
+
+namespace electron {
+
+// Sorts the requests of a BrowserContext into traffic classes. A class can
+// override the priority of its requests and throttle them with its own
+// network service throttling profile, and counts their requests and bytes.
+class TrafficShaper {
+ public:
+  struct TrafficClass {
+    TrafficClass();
+    TrafficClass(TrafficClass&&);
+    ~TrafficClass();
+    TrafficClass& operator=(TrafficClass&&);
+
+    std::string name;
+    // Empty sets match every request.
+    std::set<URLPattern> url_patterns;
+    std::set<std::string> resource_types;
+    base::Optional<net::RequestPriority> priority;
+    base::Optional<base::UnguessableToken> throttling_profile_id;
+  };
+
+  struct Stats {
+    uint64_t request_count = 0;
+    uint64_t bytes_sent = 0;
+    uint64_t bytes_received = 0;
+  };
+
+  ~TrafficShaper();
+
+  static TrafficShaper* FromBrowserContext(content::BrowserContext*);
+
+  // Replaces the traffic classes and resets their counters. Requests are
+  // assigned to the first class that matches them.
+  void SetTrafficClasses(std::vector<TrafficClass> classes);
+  const std::vector<TrafficClass>& traffic_classes() const {
+    return classes_;
+  }
+
+  // Throttling profile applied to requests that match no traffic class.
+  void set_default_throttling_profile_id(
+      const base::Optional<base::UnguessableToken>& id) {
+    default_throttling_profile_id_ = id;
+  }
+
+  // Applies the matching traffic class to |request| and, when one matches,
+  // replaces |client| with one that updates the class counters.
+  void ShapeRequest(
+      network::ResourceRequest* request,
+      mojo::PendingRemote<network::mojom::URLLoaderClient>* client);
+
+  const std::map<std::string, Stats>& stats() const { return stats_; }
+
+ private:
+  friend class ElectronBrowserContext;
+
+  TrafficShaper();
+
+  void OnRequestComplete(uint64_t generation,
+                         const std::string& name,
+                         uint64_t bytes_sent,
+                         uint64_t bytes_received);
+
+  std::vector<TrafficClass> classes_;
+  std::map<std::string, Stats> stats_;
+  base::Optional<base::UnguessableToken> default_throttling_profile_id_;
+
+  // Bumped whenever the classes are replaced, so that requests started under
+  // the previous classes do not update the new counters.
+  uint64_t generation_ = 0;
+
+  base::WeakPtrFactory<TrafficShaper> weak_factory_{this};
+
+  DISALLOW_COPY_AND_ASSIGN(TrafficShaper);
+};
+
+}  // namespace electron
+
+#endif  // SHELL_BROWSER_NET_TRAFFIC_SHAPER_H_
@@ -8,6 +8,7 @@
 #include <gtk/gtk.h>
 
 #include <algorithm>
+#include <set>
 #include <string>
 #include <vector>
 
@@ -73,6 +74,9 @@ typedef void (*app_indicator_set_icon_theme_path_func)(
     AppIndicator* self,
     const gchar* icon_theme_path);
 
+// The number of written images kept on disk for reuse.
+const size_t kMaxCachedImages = 32;
+
 bool g_attempted_load = false;
 bool g_opened = false;
 
@@ -158,7 +162,7 @@ namespace gtkui {
 AppIndicatorIcon::AppIndicatorIcon(std::string id,
                                    const gfx::ImageSkia& image,
                                    const std::u16string& tool_tip)
-    : id_(id) {
+    : id_(id), image_cache_(kMaxCachedImages) {
   std::unique_ptr<base::Environment> env(base::Environment::Create());
   desktop_env_ = base::nix::GetDesktopEnvironment(env.get());
 
@@ -170,10 +174,16 @@ AppIndicatorIcon::~AppIndicatorIcon() {
   if (icon_) {
     app_indicator_set_status(icon_, APP_INDICATOR_STATUS_PASSIVE);
     g_object_unref(icon_);
+  }
+
+  std::set<base::FilePath> temp_dirs = {temp_dir_};
+  for (const auto& entry : image_cache_)
+    temp_dirs.insert(entry.second.parent_temp_dir);
+  for (const auto& dir : temp_dirs) {
     base::PostTask(
         FROM_HERE,
         {base::ThreadPool(), base::MayBlock(), base::TaskPriority::BEST_EFFORT},
-        base::BindOnce(&DeleteTempDirectory, temp_dir_));
+        base::BindOnce(&DeleteTempDirectory, dir));
   }
 }
 
@@ -189,6 +199,13 @@ void AppIndicatorIcon::SetIcon(const gfx::ImageSkia& image) {
 
   ++icon_change_count_;
 
+  const uint32_t cache_key = image.bitmap()->getGenerationID();
+  auto cached = image_cache_.Get(cache_key);
+  if (cached != image_cache_.end()) {
+    SetImageFromFile(cached->second);
+    return;
+  }
+
   // Copy the bitmap because it may be freed by the time it's accessed in
   // another thread.
   SkBitmap safe_bitmap = *image.bitmap();
@@ -203,15 +220,17 @@ void AppIndicatorIcon::SetIcon(const gfx::ImageSkia& image) {
         FROM_HERE, kTraits,
         base::BindOnce(AppIndicatorIcon::WriteKDE4TempImageOnWorkerThread,
                        safe_bitmap, temp_dir_),
-        base::BindOnce(&AppIndicatorIcon::SetImageFromFile,
-                       weak_factory_.GetWeakPtr()));
+        base::BindOnce(&AppIndicatorIcon::OnImageWritten,
+                       weak_factory_.GetWeakPtr(), cache_key,
+                       icon_change_count_));
   } else {
     base::PostTaskAndReplyWithResult(
         FROM_HERE, kTraits,
         base::BindOnce(AppIndicatorIcon::WriteUnityTempImageOnWorkerThread,
                        safe_bitmap, icon_change_count_, id_),
-        base::BindOnce(&AppIndicatorIcon::SetImageFromFile,
-                       weak_factory_.GetWeakPtr()));
+        base::BindOnce(&AppIndicatorIcon::OnImageWritten,
+                       weak_factory_.GetWeakPtr(), cache_key,
+                       icon_change_count_));
   }
 }
 
@@ -323,6 +342,31 @@ AppIndicatorIcon::WriteUnityTempImageOnWorkerThread(const SkBitmap& bitmap,
   return params;
 }
 
+void AppIndicatorIcon::OnImageWritten(uint32_t cache_key,
+                                      int icon_change_count,
+                                      const SetImageFromFileParams& params) {
+  if (params.icon_theme_path.empty())
+    return;
+
+  auto cached = image_cache_.Peek(cache_key);
+  if (cached != image_cache_.end()) {
+    // The same image was written twice while the first write was in flight.
+    DeleteTempDirectoryIfUnused(params.parent_temp_dir);
+  } else {
+    if (image_cache_.size() >= image_cache_.max_size()) {
+      auto oldest = image_cache_.rbegin();
+      base::FilePath oldest_dir = oldest->second.parent_temp_dir;
+      image_cache_.Erase(oldest);
+      DeleteTempDirectoryIfUnused(oldest_dir);
+    }
+    cached = image_cache_.Put(cache_key, params);
+  }
+
+  // Writes can finish out of order, only show the most recently set image.
+  if (icon_change_count == icon_change_count_)
+    SetImageFromFile(cached->second);
+}
+
 void AppIndicatorIcon::SetImageFromFile(const SetImageFromFileParams& params) {
   DCHECK_CURRENTLY_ON(content::BrowserThread::UI);
   if (params.icon_theme_path.empty())
@@ -341,12 +385,23 @@ void AppIndicatorIcon::SetImageFromFile(const SetImageFromFileParams& params) {
   }
 
   if (temp_dir_ != params.parent_temp_dir) {
-    base::PostTask(
-        FROM_HERE,
-        {base::ThreadPool(), base::MayBlock(), base::TaskPriority::BEST_EFFORT},
-        base::BindOnce(&DeleteTempDirectory, temp_dir_));
+    base::FilePath old_temp_dir = temp_dir_;
     temp_dir_ = params.parent_temp_dir;
+    DeleteTempDirectoryIfUnused(old_temp_dir);
+  }
+}
+
+void AppIndicatorIcon::DeleteTempDirectoryIfUnused(const base::FilePath& dir) {
+  if (dir.empty() || dir == temp_dir_)
+    return;
+  for (const auto& entry : image_cache_) {
+    if (entry.second.parent_temp_dir == dir)
+      return;
   }
+  base::PostTask(
+      FROM_HERE,
+      {base::ThreadPool(), base::MayBlock(), base::TaskPriority::BEST_EFFORT},
+      base::BindOnce(&DeleteTempDirectory, dir));
 }
 
 void AppIndicatorIcon::SetMenu() {
@@ -8,6 +8,7 @@
 #include <memory>
 #include <string>
 
+#include "base/containers/mru_cache.h"
 #include "base/files/file_path.h"
 #include "base/macros.h"
 #include "base/memory/weak_ptr.h"
@@ -78,7 +79,14 @@ class AppIndicatorIcon : public views::StatusIconLinux {
       int icon_change_count,
       const std::string& id);
 
+  // Caches the written image identified by |cache_key| and shows it, unless
+  // another image has been set since it was requested.
+  void OnImageWritten(uint32_t cache_key,
+                      int icon_change_count,
+                      const SetImageFromFileParams& params);
   void SetImageFromFile(const SetImageFromFileParams& params);
+  // Deletes |dir| unless it holds the current or a cached image.
+  void DeleteTempDirectoryIfUnused(const base::FilePath& dir);
   void SetMenu();
 
   // Sets a menu item at the top of the menu as a replacement for the status
@@ -104,6 +112,11 @@ class AppIndicatorIcon : public views::StatusIconLinux {
   base::FilePath temp_dir_;
   int icon_change_count_ = 0;
 
+  // Images that have already been written to disk, keyed by the generation ID
+  // of their bitmap. Showing one of them again, e.g. the next frame of an
+  // animated tray icon, only has to point libappindicator at its file.
+  base::MRUCache<uint32_t, SetImageFromFileParams> image_cache_;
+
   base::WeakPtrFactory<AppIndicatorIcon> weak_factory_{this};
 
   DISALLOW_COPY_AND_ASSIGN(AppIndicatorIcon);
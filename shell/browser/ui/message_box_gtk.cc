@@ -9,6 +9,7 @@
 #include "base/strings/string_util.h"
 #include "base/strings/utf_string_conversions.h"
 #include "shell/browser/browser.h"
+#include "shell/browser/linux/headless_util.h"
 #include "shell/browser/native_window_observer.h"
 #include "shell/browser/native_window_views.h"
 #include "shell/browser/unresponsive_suppressor.h"
@@ -221,7 +222,8 @@ void ShowMessageBox(const MessageBoxSettings& settings,
 }
 
 void ShowErrorBox(const std::u16string& title, const std::u16string& content) {
-  if (Browser::Get()->is_ready()) {
+  // Without a display server the error is printed, as before the app is ready.
+  if (Browser::Get()->is_ready() && !IsHeadlessOzonePlatform()) {
     electron::MessageBoxSettings settings;
     settings.type = electron::MessageBoxType::kError;
     settings.buttons = {};
@@ -55,6 +55,11 @@ class TrayIcon {
   virtual std::string GetTitle() = 0;
 #endif
 
+#if defined(OS_LINUX)
+  // Draws |count| over the status icon image, 0 removes the badge.
+  virtual void SetBadgeCount(int count) = 0;
+#endif
+
   enum class IconType { kNone, kInfo, kWarning, kError, kCustom };
 
   struct BalloonOptions {
@@ -4,17 +4,70 @@
 
 #include "shell/browser/ui/tray_icon_gtk.h"
 
+#include <algorithm>
+
+#include "base/strings/string_number_conversions.h"
 #include "base/strings/stringprintf.h"
 #include "base/strings/utf_string_conversions.h"
+#include "cc/paint/paint_flags.h"
 #include "shell/browser/browser.h"
 #include "shell/browser/ui/gtk/status_icon.h"
 #include "shell/common/application_info.h"
+#include "ui/gfx/canvas.h"
+#include "ui/gfx/font_list.h"
+#include "ui/gfx/image/canvas_image_source.h"
 #include "ui/gfx/image/image.h"
 #include "ui/gfx/image/image_skia_operations.h"
 
 namespace electron {
 
-TrayIconGtk::TrayIconGtk() = default;
+namespace {
+
+// The number of badged images kept around, enough for a badge over a typical
+// animation.
+const size_t kMaxBadgedImages = 32;
+
+const SkColor kBadgeColor = SkColorSetRGB(0xE5, 0x39, 0x35);
+
+// Draws a circle with |count| in the bottom right corner of |image|.
+class BadgeImageSource : public gfx::CanvasImageSource {
+ public:
+  BadgeImageSource(const gfx::ImageSkia& image, int count)
+      : gfx::CanvasImageSource(image.size()), image_(image), count_(count) {}
+
+  // gfx::CanvasImageSource:
+  void Draw(gfx::Canvas* canvas) override {
+    canvas->DrawImageInt(image_, 0, 0);
+
+    const int diameter =
+        std::max(std::min(size().width(), size().height()) * 3 / 5, 8);
+    const gfx::Rect bounds(size().width() - diameter,
+                           size().height() - diameter, diameter, diameter);
+    cc::PaintFlags flags;
+    flags.setAntiAlias(true);
+    flags.setColor(kBadgeColor);
+    canvas->DrawCircle(gfx::PointF(bounds.CenterPoint()), diameter / 2.0f,
+                       flags);
+
+    const std::u16string text =
+        count_ > 99 ? u"99+" : base::NumberToString16(count_);
+    const gfx::FontList font_list({"sans-serif"}, gfx::Font::NORMAL,
+                                  diameter * (text.size() > 1 ? 2 : 3) / 5,
+                                  gfx::Font::Weight::BOLD);
+    canvas->DrawStringRectWithFlags(text, font_list, SK_ColorWHITE, bounds,
+                                    gfx::Canvas::TEXT_ALIGN_CENTER);
+  }
+
+ private:
+  const gfx::ImageSkia image_;
+  const int count_;
+
+  DISALLOW_COPY_AND_ASSIGN(BadgeImageSource);
+};
+
+}  // namespace
+
+TrayIconGtk::TrayIconGtk() : badged_images_(kMaxBadgedImages) {}
 
 TrayIconGtk::~TrayIconGtk() = default;
 
@@ -22,17 +75,43 @@ void TrayIconGtk::SetImage(const gfx::Image& image) {
   image_ = image.AsImageSkia();
 
   if (icon_) {
-    icon_->SetIcon(image_);
+    icon_->SetIcon(GetDisplayedImage());
     return;
   }
 
   tool_tip_ = base::UTF8ToUTF16(GetApplicationName());
 
-  icon_ = gtkui::CreateLinuxStatusIcon(image_, tool_tip_,
+  icon_ = gtkui::CreateLinuxStatusIcon(GetDisplayedImage(), tool_tip_,
                                        Browser::Get()->GetName().c_str());
   icon_->SetDelegate(this);
 }
 
+void TrayIconGtk::SetBadgeCount(int count) {
+  count = std::max(count, 0);
+  if (count == badge_count_)
+    return;
+
+  badge_count_ = count;
+  if (icon_)
+    icon_->SetIcon(GetDisplayedImage());
+}
+
+gfx::ImageSkia TrayIconGtk::GetDisplayedImage() {
+  if (badge_count_ == 0 || image_.isNull())
+    return image_;
+
+  const auto key =
+      std::make_pair(image_.bitmap()->getGenerationID(), badge_count_);
+  auto it = badged_images_.Get(key);
+  if (it != badged_images_.end())
+    return it->second;
+
+  gfx::ImageSkia badged_image(
+      std::make_unique<BadgeImageSource>(image_, badge_count_), image_.size());
+  badged_images_.Put(key, badged_image);
+  return badged_image;
+}
+
 void TrayIconGtk::SetToolTip(const std::string& tool_tip) {
   tool_tip_ = base::UTF8ToUTF16(tool_tip);
   icon_->SetToolTip(tool_tip_);
@@ -7,7 +7,9 @@
 
 #include <memory>
 #include <string>
+#include <utility>
 
+#include "base/containers/mru_cache.h"
 #include "shell/browser/ui/tray_icon.h"
 #include "ui/views/linux_ui/status_icon_linux.h"
 
@@ -25,6 +27,7 @@ class TrayIconGtk : public TrayIcon, public views::StatusIconLinux::Delegate {
   // TrayIcon:
   void SetImage(const gfx::Image& image) override;
   void SetToolTip(const std::string& tool_tip) override;
+  void SetBadgeCount(int count) override;
   void SetContextMenu(ElectronMenuModel* menu_model) override;
 
   // views::StatusIconLinux::Delegate
@@ -38,8 +41,16 @@ class TrayIconGtk : public TrayIcon, public views::StatusIconLinux::Delegate {
   void OnImplInitializationFailed() override;
 
  private:
+  // Returns |image_| with the badge drawn over it, if there is one.
+  gfx::ImageSkia GetDisplayedImage();
+
   std::unique_ptr<views::StatusIconLinux> icon_;
   gfx::ImageSkia image_;
+  int badge_count_ = 0;
+  // Badged images keyed by the generation ID of the image they were drawn
+  // over and the count, so that a badged animation frame is only drawn, and
+  // written to disk by the status icon, once.
+  base::MRUCache<std::pair<uint32_t, int>, gfx::ImageSkia> badged_images_;
   std::u16string tool_tip_;
   ui::MenuModel* menu_model_;
 
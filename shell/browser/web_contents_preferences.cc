@@ -363,6 +363,13 @@ void WebContentsPreferences::AppendCommandLineSwitches(
   if (IsEnabled(options::kNodeIntegrationInWorker))
     command_line->AppendSwitch(switches::kNodeIntegrationInWorker);
 
+  int max_old_space_size;
+  if (GetAsInteger(&preference_, options::kMaxOldSpaceSize,
+                   &max_old_space_size) &&
+      max_old_space_size > 0)
+    command_line->AppendSwitchASCII(switches::kRendererMaxOldSpaceSize,
+                                    base::NumberToString(max_old_space_size));
+
   // We are appending args to a webContents so let's save the current state
   // of our preferences object so that during the lifetime of the WebContents
   // we can fetch the options used to initally configure the WebContents
@@ -38,7 +38,8 @@ class Archive : public gin::Wrappable<Archive> {
         .SetMethod("readdir", &Archive::Readdir)
         .SetMethod("realpath", &Archive::Realpath)
         .SetMethod("copyFileOut", &Archive::CopyFileOut)
-        .SetMethod("getFd", &Archive::GetFD);
+        .SetMethod("getFd", &Archive::GetFD)
+        .SetMethod("verifyRead", &Archive::VerifyRead);
   }
 
   const char* GetTypeName() override { return "Archive"; }
@@ -60,6 +61,7 @@ class Archive : public gin::Wrappable<Archive> {
     dict.Set("size", info.size);
     dict.Set("unpacked", info.unpacked);
     dict.Set("offset", info.offset);
+    dict.Set("hasIntegrity", !!info.integrity);
     return dict.GetHandle();
   }
 
@@ -104,6 +106,20 @@ class Archive : public gin::Wrappable<Archive> {
     return gin::ConvertToV8(isolate, new_path);
   }
 
+  // Verifies the |buffer| read at |position| of the file through the file
+  // descriptor against the file's integrity.
+  bool VerifyRead(const base::FilePath& path,
+                  v8::Local<v8::Value> buffer,
+                  uint64_t position) {
+    asar::Archive::FileInfo info;
+    if (!archive_ || !archive_->GetFileInfo(path, &info) ||
+        !node::Buffer::HasInstance(buffer)) {
+      return false;
+    }
+    return archive_->VerifyRead(info, position, node::Buffer::Data(buffer),
+                                node::Buffer::Length(buffer));
+  }
+
   // Return the file descriptor.
   int GetFD() const {
     if (!archive_)
@@ -4,9 +4,16 @@
 
 #include "shell/common/api/electron_api_clipboard.h"
 
+#include <memory>
+#include <utility>
+
+#include "base/bind.h"
 #include "base/strings/utf_string_conversions.h"
+#include "shell/common/clipboard_util.h"
 #include "shell/common/gin_converters/image_converter.h"
 #include "shell/common/gin_helper/dictionary.h"
+#include "shell/common/gin_helper/locker.h"
+#include "shell/common/gin_helper/promise.h"
 #include "shell/common/node_includes.h"
 #include "third_party/skia/include/core/SkBitmap.h"
 #include "third_party/skia/include/core/SkImageInfo.h"
@@ -18,6 +25,51 @@ namespace electron {
 
 namespace api {
 
+namespace {
+
+// Creates a Buffer that takes ownership of |data| instead of copying it.
+v8::Local<v8::Value> CreateBufferFromString(v8::Isolate* isolate,
+                                            std::unique_ptr<std::string> data) {
+  if (data->empty())
+    return node::Buffer::New(isolate, 0).ToLocalChecked();
+  char* bytes = &(*data)[0];
+  size_t length = data->size();
+  return node::Buffer::New(
+             isolate, bytes, length,
+             [](char* data, void* hint) {
+               delete static_cast<std::string*>(hint);
+             },
+             data.release())
+      .ToLocalChecked();
+}
+
+constexpr char kReadFailedMessage[] = "Failed to read the clipboard";
+
+void ResolveBuffer(gin_helper::Promise<v8::Local<v8::Value>> promise,
+                   base::Optional<std::string> data) {
+  if (!data) {
+    promise.RejectWithErrorMessage(kReadFailedMessage);
+    return;
+  }
+  v8::Isolate* isolate = promise.isolate();
+  gin_helper::Locker locker(isolate);
+  v8::HandleScope handle_scope(isolate);
+  v8::Context::Scope context_scope(promise.GetContext());
+  promise.Resolve(CreateBufferFromString(
+      isolate, std::make_unique<std::string>(std::move(*data))));
+}
+
+void ResolveImage(gin_helper::Promise<gfx::Image> promise,
+                  base::Optional<gfx::Image> image) {
+  if (!image) {
+    promise.RejectWithErrorMessage(kReadFailedMessage);
+    return;
+  }
+  promise.Resolve(*image);
+}
+
+}  // namespace
+
 ui::ClipboardBuffer Clipboard::GetClipboardBuffer(gin_helper::Arguments* args) {
   std::string type;
   if (args->GetNext(&type) && type == "selection")
@@ -56,9 +108,18 @@ std::string Clipboard::Read(const std::string& format_string) {
 
 v8::Local<v8::Value> Clipboard::ReadBuffer(const std::string& format_string,
                                            gin_helper::Arguments* args) {
-  std::string data = Read(format_string);
-  return node::Buffer::Copy(args->isolate(), data.data(), data.length())
-      .ToLocalChecked();
+  return CreateBufferFromString(
+      args->isolate(), std::make_unique<std::string>(Read(format_string)));
+}
+
+v8::Local<v8::Promise> Clipboard::ReadBufferAsync(
+    const std::string& format_string,
+    gin_helper::Arguments* args) {
+  gin_helper::Promise<v8::Local<v8::Value>> promise(args->isolate());
+  v8::Local<v8::Promise> handle = promise.GetHandle();
+  clipboard_util::ReadData(ui::ClipboardFormatType::GetType(format_string),
+                           base::BindOnce(&ResolveBuffer, std::move(promise)));
+  return handle;
 }
 
 void Clipboard::WriteBuffer(const std::string& format,
@@ -194,6 +255,14 @@ gfx::Image Clipboard::ReadImage(gin_helper::Arguments* args) {
   return image.value();
 }
 
+v8::Local<v8::Promise> Clipboard::ReadImageAsync(gin_helper::Arguments* args) {
+  gin_helper::Promise<gfx::Image> promise(args->isolate());
+  v8::Local<v8::Promise> handle = promise.GetHandle();
+  clipboard_util::ReadImage(GetClipboardBuffer(args),
+                            base::BindOnce(&ResolveImage, std::move(promise)));
+  return handle;
+}
+
 void Clipboard::WriteImage(const gfx::Image& image,
                            gin_helper::Arguments* args) {
   ui::ScopedClipboardWriter writer(GetClipboardBuffer(args));
@@ -242,10 +311,13 @@ void Initialize(v8::Local<v8::Object> exports,
   dict.SetMethod("readBookmark", &electron::api::Clipboard::ReadBookmark);
   dict.SetMethod("writeBookmark", &electron::api::Clipboard::WriteBookmark);
   dict.SetMethod("readImage", &electron::api::Clipboard::ReadImage);
+  dict.SetMethod("readImageAsync", &electron::api::Clipboard::ReadImageAsync);
   dict.SetMethod("writeImage", &electron::api::Clipboard::WriteImage);
   dict.SetMethod("readFindText", &electron::api::Clipboard::ReadFindText);
   dict.SetMethod("writeFindText", &electron::api::Clipboard::WriteFindText);
   dict.SetMethod("readBuffer", &electron::api::Clipboard::ReadBuffer);
+  dict.SetMethod("readBufferAsync",
+                 &electron::api::Clipboard::ReadBufferAsync);
   dict.SetMethod("writeBuffer", &electron::api::Clipboard::WriteBuffer);
   dict.SetMethod("clear", &electron::api::Clipboard::Clear);
 }
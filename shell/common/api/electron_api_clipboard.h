@@ -51,6 +51,7 @@ class Clipboard {
                             gin_helper::Arguments* args);
 
   static gfx::Image ReadImage(gin_helper::Arguments* args);
+  static v8::Local<v8::Promise> ReadImageAsync(gin_helper::Arguments* args);
   static void WriteImage(const gfx::Image& image, gin_helper::Arguments* args);
 
   static std::u16string ReadFindText();
@@ -58,6 +59,9 @@ class Clipboard {
 
   static v8::Local<v8::Value> ReadBuffer(const std::string& format_string,
                                          gin_helper::Arguments* args);
+  static v8::Local<v8::Promise> ReadBufferAsync(
+      const std::string& format_string,
+      gin_helper::Arguments* args);
   static void WriteBuffer(const std::string& format_string,
                           const v8::Local<v8::Value> buffer,
                           gin_helper::Arguments* args);
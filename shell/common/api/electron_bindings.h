@@ -49,9 +49,11 @@ class ElectronBindings {
 
   static void Crash();
 
+  // Same as process.getHeapStatistics(), sizes are in kilobytes.
+  static v8::Local<v8::Value> GetHeapStatistics(v8::Isolate* isolate);
+
  private:
   static void Hang();
-  static v8::Local<v8::Value> GetHeapStatistics(v8::Isolate* isolate);
   static v8::Local<v8::Value> GetCreationTime(v8::Isolate* isolate);
   static v8::Local<v8::Value> GetSystemMemoryInfo(v8::Isolate* isolate,
                                                   gin_helper::Arguments* args);
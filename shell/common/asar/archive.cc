@@ -4,6 +4,7 @@
 
 #include "shell/common/asar/archive.h"
 
+#include <algorithm>
 #include <string>
 #include <utility>
 #include <vector>
@@ -12,11 +13,13 @@
 #include "base/files/file_util.h"
 #include "base/json/json_reader.h"
 #include "base/logging.h"
+#include "base/optional.h"
 #include "base/pickle.h"
 #include "base/strings/string_number_conversions.h"
 #include "base/task/post_task.h"
 #include "base/threading/thread_restrictions.h"
 #include "base/values.h"
+#include "shell/common/asar/asar_util.h"
 #include "shell/common/asar/scoped_temporary_file.h"
 
 #if defined(OS_WIN)
@@ -92,6 +95,39 @@ bool GetNodeFromPath(std::string path,
   return GetChildNode(root, path, dir, out);
 }
 
+// Parses the "integrity" of a file node. A malformed integrity is returned
+// without blocks, so that reading the file fails verification instead of
+// silently skipping it.
+std::unique_ptr<IntegrityPayload> ParseIntegrity(
+    const base::Value& integrity,
+    uint32_t size) {
+  auto payload = std::make_unique<IntegrityPayload>();
+  const std::string* algorithm = integrity.FindStringKey("algorithm");
+  base::Optional<int> block_size = integrity.FindIntKey("blockSize");
+  const base::Value* blocks = integrity.FindListKey("blocks");
+  if (!algorithm || *algorithm != "SHA256" || !block_size ||
+      *block_size <= 0 || !blocks) {
+    return payload;
+  }
+
+  payload->block_size = static_cast<uint32_t>(*block_size);
+  const size_t block_count =
+      (static_cast<uint64_t>(size) + payload->block_size - 1) /
+      payload->block_size;
+  if (blocks->GetList().size() != block_count)
+    return payload;
+
+  payload->blocks.reserve(block_count);
+  for (const auto& block : blocks->GetList()) {
+    if (!block.is_string()) {
+      payload->blocks.clear();
+      return payload;
+    }
+    payload->blocks.push_back(block.GetString());
+  }
+  return payload;
+}
+
 bool FillFileInfoWithNode(Archive::FileInfo* info,
                           uint32_t header_size,
                           const base::DictionaryValue* node) {
@@ -117,6 +153,9 @@ bool FillFileInfoWithNode(Archive::FileInfo* info,
 
 }  // namespace
 
+IntegrityPayload::IntegrityPayload() = default;
+IntegrityPayload::~IntegrityPayload() = default;
+
 Archive::Archive(const base::FilePath& path)
     : path_(path), file_(base::File::FILE_OK) {
   base::ThreadRestrictions::ScopedAllowIO allow_io;
@@ -210,7 +249,10 @@ bool Archive::GetFileInfo(const base::FilePath& path, FileInfo* info) {
   if (node->GetString("link", &link))
     return GetFileInfo(base::FilePath::FromUTF8Unsafe(link), info);
 
-  return FillFileInfoWithNode(info, header_size_, node);
+  if (!FillFileInfoWithNode(info, header_size_, node))
+    return false;
+  info->integrity = GetIntegrity(node, *info);
+  return true;
 }
 
 bool Archive::Stat(const base::FilePath& path, Stats* stats) {
@@ -293,8 +335,12 @@ bool Archive::CopyFileOut(const base::FilePath& path, base::FilePath* out) {
 
   auto temp_file = std::make_unique<ScopedTemporaryFile>();
   base::FilePath::StringType ext = path.Extension();
-  if (!temp_file->InitFromFile(&file_, ext, info.offset, info.size))
+  if (!temp_file->InitFromFile(&file_, ext, info.offset, info.size,
+                               info.integrity.get())) {
+    LOG(ERROR) << "Failed to copy " << path.value() << " out of "
+               << path_.value();
     return false;
+  }
 
 #if defined(OS_POSIX)
   if (info.executable) {
@@ -308,6 +354,84 @@ bool Archive::CopyFileOut(const base::FilePath& path, base::FilePath* out) {
   return true;
 }
 
+bool Archive::VerifyRead(const FileInfo& info,
+                         uint64_t position,
+                         const char* data,
+                         size_t length) {
+  if (!info.integrity || length == 0)
+    return true;
+
+  const IntegrityPayload& integrity = *info.integrity;
+  const uint64_t end = position + length;
+  if (integrity.block_size == 0 || end > info.size)
+    return false;
+
+  std::vector<bool>& verified = verified_blocks_[info.offset];
+  verified.resize(integrity.blocks.size());
+
+  std::string block;
+  for (uint64_t index = position / integrity.block_size;
+       index * integrity.block_size < end; ++index) {
+    if (index >= verified.size())
+      return false;
+    if (verified[index])
+      continue;
+
+    const uint64_t block_start = index * integrity.block_size;
+    const uint64_t block_end =
+        std::min<uint64_t>(block_start + integrity.block_size, info.size);
+    base::StringPiece block_data;
+    if (block_start >= position && block_end <= end) {
+      block_data = base::StringPiece(data + (block_start - position),
+                                     block_end - block_start);
+    } else {
+      // Complete the block from the archive, and make sure the part that was
+      // read matches it.
+      block.resize(block_end - block_start);
+      int len;
+      {
+        base::ThreadRestrictions::ScopedAllowIO allow_io;
+        len = file_.Read(info.offset + block_start, &block[0], block.size());
+      }
+      if (len != static_cast<int>(block.size()))
+        return false;
+      const uint64_t overlap_start = std::max(block_start, position);
+      const uint64_t overlap_end = std::min(block_end, end);
+      if (block.compare(overlap_start - block_start,
+                        overlap_end - overlap_start,
+                        data + (overlap_start - position),
+                        overlap_end - overlap_start) != 0) {
+        return false;
+      }
+      block_data = block;
+    }
+
+    if (!ValidateIntegrityBlock(integrity, index, block_data))
+      return false;
+    verified[index] = true;
+  }
+  return true;
+}
+
+std::shared_ptr<const IntegrityPayload> Archive::GetIntegrity(
+    const base::DictionaryValue* node,
+    const FileInfo& info) {
+  if (info.unpacked)
+    return nullptr;
+
+  auto it = integrities_.find(info.offset);
+  if (it != integrities_.end())
+    return it->second;
+
+  const base::Value* integrity = node->FindDictKey("integrity");
+  if (!integrity)
+    return nullptr;
+  std::shared_ptr<const IntegrityPayload> payload =
+      ParseIntegrity(*integrity, info.size);
+  integrities_.emplace(info.offset, payload);
+  return payload;
+}
+
 int Archive::GetFD() const {
   return fd_;
 }
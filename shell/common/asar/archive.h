@@ -5,12 +5,15 @@
 #ifndef SHELL_COMMON_ASAR_ARCHIVE_H_
 #define SHELL_COMMON_ASAR_ARCHIVE_H_
 
+#include <map>
 #include <memory>
+#include <string>
 #include <unordered_map>
 #include <vector>
 
 #include "base/files/file.h"
 #include "base/files/file_path.h"
+#include "base/macros.h"
 
 namespace base {
 class DictionaryValue;
@@ -20,6 +23,21 @@ namespace asar {
 
 class ScopedTemporaryFile;
 
+// The optional "integrity" of a file in the archive header. The file is split
+// into blocks of |block_size| bytes, each with its own hash, so that the file
+// can be verified as it is read instead of all at once. The hash of the
+// whole file is not kept, the block hashes already cover every byte.
+struct IntegrityPayload {
+  IntegrityPayload();
+  ~IntegrityPayload();
+
+  // Hex encoded SHA256 hashes, only SHA256 is supported.
+  uint32_t block_size = 0;
+  std::vector<std::string> blocks;
+
+  DISALLOW_COPY_AND_ASSIGN(IntegrityPayload);
+};
+
 // This class represents an asar package, and provides methods to read
 // information from it.
 class Archive {
@@ -30,6 +48,8 @@ class Archive {
     bool executable;
     uint32_t size;
     uint64_t offset;
+    // Parsed once per Archive and shared by every FileInfo of the file.
+    std::shared_ptr<const IntegrityPayload> integrity;
   };
 
   struct Stats : public FileInfo {
@@ -61,6 +81,15 @@ class Archive {
   // For unpacked file, this method will return its real path.
   bool CopyFileOut(const base::FilePath& path, base::FilePath* out);
 
+  // Verifies the |length| bytes of |data|, read at |position| of the file
+  // described by |info|, against the file's integrity. Blocks only partially
+  // covered by |data| are completed from the archive. Each block is only
+  // verified once per Archive. Returns true for files without integrity.
+  bool VerifyRead(const FileInfo& info,
+                  uint64_t position,
+                  const char* data,
+                  size_t length);
+
   // Returns the file's fd.
   int GetFD() const;
 
@@ -74,6 +103,18 @@ class Archive {
   uint32_t header_size_ = 0;
   std::unique_ptr<base::DictionaryValue> header_;
 
+  // Returns the parsed integrity of the file node |node| described by |info|,
+  // or null if it has none.
+  std::shared_ptr<const IntegrityPayload> GetIntegrity(
+      const base::DictionaryValue* node,
+      const FileInfo& info);
+
+  // Parsed integrities, keyed by the offset of their file.
+  std::map<uint64_t, std::shared_ptr<const IntegrityPayload>> integrities_;
+
+  // Blocks that passed verification, keyed by the offset of their file.
+  std::map<uint64_t, std::vector<bool>> verified_blocks_;
+
   // Cached external temporary files.
   std::unordered_map<base::FilePath::StringType,
                      std::unique_ptr<ScopedTemporaryFile>>
@@ -10,9 +10,13 @@
 #include "base/files/file_path.h"
 #include "base/files/file_util.h"
 #include "base/lazy_instance.h"
+#include "base/logging.h"
 #include "base/stl_util.h"
+#include "base/strings/string_number_conversions.h"
+#include "base/strings/string_util.h"
 #include "base/threading/thread_local.h"
 #include "base/threading/thread_restrictions.h"
+#include "crypto/sha2.h"
 #include "shell/common/asar/archive.h"
 
 namespace asar {
@@ -114,9 +118,28 @@ bool ReadFileToString(const base::FilePath& path, std::string* contents) {
     return false;
 
   contents->resize(info.size);
-  return static_cast<int>(info.size) ==
-         src.Read(info.offset, const_cast<char*>(contents->data()),
-                  contents->size());
+  if (static_cast<int>(info.size) !=
+      src.Read(info.offset, const_cast<char*>(contents->data()),
+               contents->size())) {
+    return false;
+  }
+
+  if (!archive->VerifyRead(info, 0, contents->data(), contents->size())) {
+    LOG(ERROR) << "Integrity check failed for " << path.value();
+    contents->clear();
+    return false;
+  }
+  return true;
+}
+
+bool ValidateIntegrityBlock(const IntegrityPayload& integrity,
+                            size_t index,
+                            base::StringPiece data) {
+  if (index >= integrity.blocks.size())
+    return false;
+  const std::string hash = crypto::SHA256HashString(data);
+  return base::EqualsCaseInsensitiveASCII(
+      base::HexEncode(hash.data(), hash.size()), integrity.blocks[index]);
 }
 
 }  // namespace asar
@@ -8,6 +8,8 @@
 #include <memory>
 #include <string>
 
+#include "base/strings/string_piece.h"
+
 namespace base {
 class FilePath;
 }
@@ -15,6 +17,7 @@ class FilePath;
 namespace asar {
 
 class Archive;
+struct IntegrityPayload;
 
 // Gets or creates a new Archive from the path.
 std::shared_ptr<Archive> GetOrCreateAsarArchive(const base::FilePath& path);
@@ -31,6 +34,11 @@ bool GetAsarArchivePath(const base::FilePath& full_path,
 // Same with base::ReadFileToString but supports asar Archive.
 bool ReadFileToString(const base::FilePath& path, std::string* contents);
 
+// Returns whether |data| matches the hash of block |index| of |integrity|.
+bool ValidateIntegrityBlock(const IntegrityPayload& integrity,
+                            size_t index,
+                            base::StringPiece data);
+
 }  // namespace asar
 
 #endif  // SHELL_COMMON_ASAR_ASAR_UTIL_H_
@@ -4,10 +4,13 @@
 
 #include "shell/common/asar/scoped_temporary_file.h"
 
+#include <algorithm>
 #include <vector>
 
 #include "base/files/file_util.h"
+#include "base/strings/string_piece.h"
 #include "base/threading/thread_restrictions.h"
+#include "shell/common/asar/asar_util.h"
 
 namespace asar {
 
@@ -51,7 +54,8 @@ bool ScopedTemporaryFile::Init(const base::FilePath::StringType& ext) {
 bool ScopedTemporaryFile::InitFromFile(base::File* src,
                                        const base::FilePath::StringType& ext,
                                        uint64_t offset,
-                                       uint64_t size) {
+                                       uint64_t size,
+                                       const IntegrityPayload* integrity) {
   if (!src->IsValid())
     return false;
 
@@ -63,6 +67,19 @@ bool ScopedTemporaryFile::InitFromFile(base::File* src,
   if (len != static_cast<int>(size))
     return false;
 
+  if (integrity) {
+    if (integrity->block_size == 0)
+      return false;
+    for (uint64_t start = 0, index = 0; start < size;
+         start += integrity->block_size, ++index) {
+      base::StringPiece block(
+          buf.data() + start,
+          std::min<uint64_t>(integrity->block_size, size - start));
+      if (!ValidateIntegrityBlock(*integrity, index, block))
+        return false;
+    }
+  }
+
   base::File dest(path_, base::File::FLAG_OPEN | base::File::FLAG_WRITE);
   if (!dest.IsValid())
     return false;
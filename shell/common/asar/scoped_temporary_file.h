@@ -6,6 +6,7 @@
 #define SHELL_COMMON_ASAR_SCOPED_TEMPORARY_FILE_H_
 
 #include "base/files/file_path.h"
+#include "shell/common/asar/archive.h"
 
 namespace base {
 class File;
@@ -27,11 +28,13 @@ class ScopedTemporaryFile {
   // Init an empty temporary file with a certain extension.
   bool Init(const base::FilePath::StringType& ext);
 
-  // Init an temporary file and fill it with content of |path|.
+  // Init an temporary file and fill it with content of |path|, which is
+  // verified against |integrity| when it is set.
   bool InitFromFile(base::File* src,
                     const base::FilePath::StringType& ext,
                     uint64_t offset,
-                    uint64_t size);
+                    uint64_t size,
+                    const IntegrityPayload* integrity);
 
   base::FilePath path() const { return path_; }
 
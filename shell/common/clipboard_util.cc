@@ -0,0 +1,134 @@
+// Copyright (c) 2021 GitHub, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#include "shell/common/clipboard_util.h"
+
+#include <utility>
+
+#include "base/bind.h"
+#include "base/memory/ref_counted_memory.h"
+#include "base/notreached.h"
+#include "base/threading/sequenced_task_runner_handle.h"
+#include "build/build_config.h"
+#include "shell/common/clipboard_util_internal.h"
+#include "third_party/skia/include/core/SkBitmap.h"
+#include "ui/base/clipboard/clipboard.h"
+
+namespace clipboard_util {
+
+namespace {
+
+bool g_read_on_current_thread_for_testing = false;
+
+bool ShouldReadDataAsync(ui::ClipboardBuffer buffer) {
+  return !g_read_on_current_thread_for_testing &&
+         internal::CanReadDataAsync(buffer);
+}
+
+std::string ReadDataOnCurrentThread(const ui::ClipboardFormatType& format) {
+  std::string data;
+  ui::Clipboard::GetForCurrentThread()->ReadData(format,
+                                                 /* data_dst = */ nullptr,
+                                                 &data);
+  return data;
+}
+
+void ReadImageOnCurrentThread(ui::ClipboardBuffer buffer,
+                              ReadImageCallback callback) {
+  ui::Clipboard::GetForCurrentThread()->ReadImage(
+      buffer, /* data_dst = */ nullptr,
+      base::BindOnce(
+          [](ReadImageCallback callback, const SkBitmap& result) {
+            std::move(callback).Run(gfx::Image::CreateFrom1xBitmap(result));
+          },
+          std::move(callback)));
+}
+
+void OnPNGRead(ui::ClipboardBuffer buffer,
+               bool read_async,
+               ReadImageCallback callback,
+               base::Optional<std::string> png) {
+  if (!png) {
+    std::move(callback).Run(base::nullopt);
+    return;
+  }
+  // Wrapping the encoded bytes defers decoding until the pixels are needed,
+  // and toPNG() returns the original bytes without encoding them again.
+  if (!png->empty()) {
+    std::move(callback).Run(gfx::Image::CreateFrom1xPNGBytes(
+        base::RefCountedString::TakeString(&png.value())));
+    return;
+  }
+  if (read_async && !internal::HasNonPNGImages()) {
+    std::move(callback).Run(gfx::Image());
+    return;
+  }
+  ReadImageOnCurrentThread(buffer, std::move(callback));
+}
+
+}  // namespace
+
+void ReadData(const ui::ClipboardFormatType& format,
+              ReadDataCallback callback) {
+  if (ShouldReadDataAsync(ui::ClipboardBuffer::kCopyPaste)) {
+    internal::ReadDataAsync(ui::ClipboardBuffer::kCopyPaste, format,
+                            std::move(callback));
+    return;
+  }
+
+  base::SequencedTaskRunnerHandle::Get()->PostTask(
+      FROM_HERE, base::BindOnce(
+                     [](const ui::ClipboardFormatType& format,
+                        ReadDataCallback callback) {
+                       std::move(callback).Run(
+                           ReadDataOnCurrentThread(format));
+                     },
+                     format, std::move(callback)));
+}
+
+void ReadImage(ui::ClipboardBuffer buffer, ReadImageCallback callback) {
+  const auto& png_format = ui::ClipboardFormatType::GetPngType();
+  if (ShouldReadDataAsync(buffer)) {
+    internal::ReadDataAsync(
+        buffer, png_format,
+        base::BindOnce(&OnPNGRead, buffer, true, std::move(callback)));
+    return;
+  }
+  // Only the copy and paste clipboard carries PNG data that ui::Clipboard
+  // can read without decoding it.
+  if (buffer != ui::ClipboardBuffer::kCopyPaste) {
+    base::SequencedTaskRunnerHandle::Get()->PostTask(
+        FROM_HERE, base::BindOnce(&ReadImageOnCurrentThread, buffer,
+                                  std::move(callback)));
+    return;
+  }
+  ReadData(png_format,
+           base::BindOnce(&OnPNGRead, buffer, false, std::move(callback)));
+}
+
+void SetReadOnCurrentThreadForTesting(bool read_on_current_thread) {
+  g_read_on_current_thread_for_testing = read_on_current_thread;
+}
+
+#if !defined(OS_WIN) && !defined(USE_X11)
+namespace internal {
+
+bool CanReadDataAsync(ui::ClipboardBuffer buffer) {
+  return false;
+}
+
+void ReadDataAsync(ui::ClipboardBuffer buffer,
+                   const ui::ClipboardFormatType& format,
+                   ReadDataCallback callback) {
+  NOTREACHED();
+}
+
+bool HasNonPNGImages() {
+  return true;
+}
+
+}  // namespace internal
+#endif
+
+}  // namespace clipboard_util
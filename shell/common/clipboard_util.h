@@ -0,0 +1,43 @@
+// Copyright (c) 2021 GitHub, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#ifndef SHELL_COMMON_CLIPBOARD_UTIL_H_
+#define SHELL_COMMON_CLIPBOARD_UTIL_H_
+
+#include <string>
+
+#include "base/callback_forward.h"
+#include "base/optional.h"
+#include "ui/base/clipboard/clipboard_buffer.h"
+#include "ui/base/clipboard/clipboard_format_type.h"
+#include "ui/gfx/image/image.h"
+
+namespace clipboard_util {
+
+// The callbacks get base::nullopt when the clipboard could not be read.
+typedef base::OnceCallback<void(base::Optional<std::string>)> ReadDataCallback;
+typedef base::OnceCallback<void(base::Optional<gfx::Image>)> ReadImageCallback;
+
+// Reads the |format| data of the copy and paste clipboard and passes it to
+// |callback| on the calling sequence. On Windows the clipboard is read on a
+// background thread, and on X11 the selection is transferred through events
+// of the UI thread's X connection, so a source application that is slow to
+// provide its data does not block the caller's thread. Elsewhere the
+// clipboard can only be read synchronously on the UI thread, and the read
+// happens in a later task of that thread.
+void ReadData(const ui::ClipboardFormatType& format,
+              ReadDataCallback callback);
+
+// Reads the image in |buffer| and passes it to |callback| on the calling
+// sequence. PNG data is read like ReadData() and wrapped without decoding it,
+// other images are read from the UI thread's clipboard in a later task.
+void ReadImage(ui::ClipboardBuffer buffer, ReadImageCallback callback);
+
+// Makes the reads use the clipboard of the current thread, which can be a
+// ui::TestClipboard, on every platform.
+void SetReadOnCurrentThreadForTesting(bool read_on_current_thread);
+
+}  // namespace clipboard_util
+
+#endif  // SHELL_COMMON_CLIPBOARD_UTIL_H_
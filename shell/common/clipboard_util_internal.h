@@ -0,0 +1,32 @@
+// Copyright (c) 2021 GitHub, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#ifndef SHELL_COMMON_CLIPBOARD_UTIL_INTERNAL_H_
+#define SHELL_COMMON_CLIPBOARD_UTIL_INTERNAL_H_
+
+#include "shell/common/clipboard_util.h"
+#include "ui/base/clipboard/clipboard_buffer.h"
+#include "ui/base/clipboard/clipboard_format_type.h"
+
+namespace clipboard_util {
+namespace internal {
+
+// Whether |buffer| can be read without blocking the UI thread.
+bool CanReadDataAsync(ui::ClipboardBuffer buffer);
+
+// Reads the |format| data of |buffer| without blocking the UI thread, and
+// passes it, or base::nullopt if the clipboard could not be read, to
+// |callback| on the calling sequence.
+void ReadDataAsync(ui::ClipboardBuffer buffer,
+                   const ui::ClipboardFormatType& format,
+                   ReadDataCallback callback);
+
+// Whether the clipboard can hold images that are not PNG data, which then
+// have to be read through ui::Clipboard.
+bool HasNonPNGImages();
+
+}  // namespace internal
+}  // namespace clipboard_util
+
+#endif  // SHELL_COMMON_CLIPBOARD_UTIL_INTERNAL_H_
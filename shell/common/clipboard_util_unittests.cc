@@ -0,0 +1,139 @@
+// Copyright (c) 2021 GitHub, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#include "shell/common/clipboard_util.h"
+
+#include <string>
+#include <utility>
+
+#include "base/bind.h"
+#include "base/run_loop.h"
+#include "base/strings/utf_string_conversions.h"
+#include "base/test/task_environment.h"
+#include "mojo/public/cpp/base/big_buffer.h"
+#include "testing/gtest/include/gtest/gtest.h"
+#include "third_party/skia/include/core/SkBitmap.h"
+#include "ui/base/clipboard/clipboard.h"
+#include "ui/base/clipboard/scoped_clipboard_writer.h"
+#include "ui/base/clipboard/test/test_clipboard.h"
+
+namespace clipboard_util {
+
+namespace {
+
+const char kFormat[] = "electron/clipboard-util-test";
+
+class ClipboardUtilTest : public testing::Test {
+ protected:
+  void SetUp() override {
+    ui::TestClipboard::CreateForCurrentThread();
+    SetReadOnCurrentThreadForTesting(true);
+  }
+
+  void TearDown() override {
+    SetReadOnCurrentThreadForTesting(false);
+    ui::Clipboard::DestroyClipboardForCurrentThread();
+  }
+
+  void WriteData(const std::string& data) {
+    ui::ScopedClipboardWriter writer(ui::ClipboardBuffer::kCopyPaste);
+    writer.WriteData(
+        base::UTF8ToUTF16(kFormat),
+        mojo_base::BigBuffer(base::as_bytes(base::make_span(data))));
+  }
+
+  base::test::SingleThreadTaskEnvironment task_environment_{
+      base::test::SingleThreadTaskEnvironment::MainThreadType::UI};
+};
+
+}  // namespace
+
+TEST_F(ClipboardUtilTest, ReadDataInLaterTask) {
+  WriteData("clipboard data");
+
+  base::RunLoop run_loop;
+  bool called = false;
+  std::string result;
+  ReadData(ui::ClipboardFormatType::GetType(kFormat),
+           base::BindOnce(
+               [](bool* called, std::string* result, base::OnceClosure quit,
+                  base::Optional<std::string> data) {
+                 *called = true;
+                 EXPECT_TRUE(data);
+                 *result = std::move(data).value_or(std::string());
+                 std::move(quit).Run();
+               },
+               &called, &result, run_loop.QuitClosure()));
+  // The caller's task is not held up by the read.
+  EXPECT_FALSE(called);
+  run_loop.Run();
+  EXPECT_EQ("clipboard data", result);
+}
+
+TEST_F(ClipboardUtilTest, ReadDataOfMissingFormat) {
+  WriteData("clipboard data");
+
+  base::RunLoop run_loop;
+  std::string result = "not read";
+  ReadData(ui::ClipboardFormatType::GetType("electron/missing"),
+           base::BindOnce(
+               [](std::string* result, base::OnceClosure quit,
+                  base::Optional<std::string> data) {
+                 EXPECT_TRUE(data);
+                 *result = std::move(data).value_or(std::string());
+                 std::move(quit).Run();
+               },
+               &result, run_loop.QuitClosure()));
+  run_loop.Run();
+  EXPECT_TRUE(result.empty());
+}
+
+TEST_F(ClipboardUtilTest, ReadImage) {
+  SkBitmap bitmap;
+  bitmap.allocN32Pixels(3, 2);
+  bitmap.eraseColor(SK_ColorRED);
+  {
+    ui::ScopedClipboardWriter writer(ui::ClipboardBuffer::kCopyPaste);
+    writer.WriteImage(bitmap);
+  }
+
+  base::RunLoop run_loop;
+  gfx::Image result;
+  ReadImage(ui::ClipboardBuffer::kCopyPaste,
+            base::BindOnce(
+                [](gfx::Image* result, base::OnceClosure quit,
+                   base::Optional<gfx::Image> image) {
+                  EXPECT_TRUE(image);
+                  *result = std::move(image).value_or(gfx::Image());
+                  std::move(quit).Run();
+                },
+                &result, run_loop.QuitClosure()));
+  run_loop.Run();
+
+  ASSERT_FALSE(result.IsEmpty());
+  const SkBitmap* read = result.ToSkBitmap();
+  EXPECT_EQ(3, read->width());
+  EXPECT_EQ(2, read->height());
+  EXPECT_EQ(SK_ColorRED, read->getColor(1, 1));
+}
+
+TEST_F(ClipboardUtilTest, ReadImageWithoutImage) {
+  WriteData("not an image");
+
+  base::RunLoop run_loop;
+  gfx::Image result;
+  ReadImage(ui::ClipboardBuffer::kCopyPaste,
+            base::BindOnce(
+                [](gfx::Image* result, base::OnceClosure quit,
+                   base::Optional<gfx::Image> image) {
+                  EXPECT_TRUE(image);
+                  *result = std::move(image).value_or(gfx::Image());
+                  std::move(quit).Run();
+                },
+                &result, run_loop.QuitClosure()));
+  run_loop.Run();
+  EXPECT_TRUE(result.IsEmpty());
+}
+
+}  // namespace clipboard_util
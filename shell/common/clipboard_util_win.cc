@@ -0,0 +1,89 @@
+// Copyright (c) 2021 GitHub, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#include "shell/common/clipboard_util_internal.h"
+
+#include <windows.h>
+
+#include <string>
+#include <utility>
+
+#include "base/bind.h"
+#include "base/check_op.h"
+#include "base/task/thread_pool.h"
+#include "base/threading/platform_thread.h"
+#include "base/time/time.h"
+
+namespace clipboard_util {
+namespace internal {
+
+namespace {
+
+// Opens the clipboard for the calling thread, retrying for a short while as
+// ui::ClipboardWin does, since another application may hold it open.
+class ScopedThreadClipboard {
+ public:
+  ScopedThreadClipboard() {
+    for (int attempt = 0; attempt < 5; ++attempt) {
+      if (::OpenClipboard(nullptr)) {
+        opened_ = true;
+        return;
+      }
+      base::PlatformThread::Sleep(base::TimeDelta::FromMilliseconds(5));
+    }
+  }
+  ~ScopedThreadClipboard() {
+    if (opened_)
+      ::CloseClipboard();
+  }
+
+  bool opened() const { return opened_; }
+
+ private:
+  bool opened_ = false;
+};
+
+// Reads the clipboard on the calling thread pool thread. A clipboard owner
+// that renders its data lazily does so when the data is requested here, which
+// blocks this thread instead of the UI thread.
+base::Optional<std::string> ReadDataOffThread(UINT format) {
+  ScopedThreadClipboard clipboard;
+  if (!clipboard.opened())
+    return base::nullopt;
+
+  // No data in |format| is an empty result rather than a failure.
+  HANDLE data = ::GetClipboardData(format);
+  if (!data)
+    return std::string();
+
+  std::string result;
+  if (const char* bytes = static_cast<const char*>(::GlobalLock(data))) {
+    result.assign(bytes, ::GlobalSize(data));
+    ::GlobalUnlock(data);
+  }
+  return result;
+}
+
+}  // namespace
+
+bool CanReadDataAsync(ui::ClipboardBuffer buffer) {
+  return buffer == ui::ClipboardBuffer::kCopyPaste;
+}
+
+void ReadDataAsync(ui::ClipboardBuffer buffer,
+                   const ui::ClipboardFormatType& format,
+                   ReadDataCallback callback) {
+  DCHECK_EQ(ui::ClipboardBuffer::kCopyPaste, buffer);
+  base::ThreadPool::PostTaskAndReplyWithResult(
+      FROM_HERE, {base::MayBlock(), base::TaskPriority::USER_BLOCKING},
+      base::BindOnce(&ReadDataOffThread, format.ToFormatEtc().cfFormat),
+      std::move(callback));
+}
+
+bool HasNonPNGImages() {
+  return true;
+}
+
+}  // namespace internal
+}  // namespace clipboard_util
@@ -0,0 +1,210 @@
+// Copyright (c) 2021 GitHub, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#include "shell/common/clipboard_util_internal.h"
+
+#include <limits>
+#include <string>
+#include <utility>
+
+#include "base/bind.h"
+#include "base/macros.h"
+#include "base/memory/weak_ptr.h"
+#include "base/notreached.h"
+#include "base/timer/timer.h"
+#include "ui/base/ui_base_features.h"
+#include "ui/gfx/x/connection.h"
+#include "ui/gfx/x/event.h"
+#include "ui/gfx/x/x11_atom_cache.h"
+#include "ui/gfx/x/xproto.h"
+
+namespace clipboard_util {
+namespace internal {
+
+namespace {
+
+// How long the selection owner has to provide the data, as for the
+// synchronous reads of ui::SelectionRequestor.
+constexpr base::TimeDelta kTransferTimeout = base::TimeDelta::FromSeconds(10);
+
+x11::Atom GetSelectionAtom(ui::ClipboardBuffer buffer) {
+  switch (buffer) {
+    case ui::ClipboardBuffer::kCopyPaste:
+      return x11::GetAtom("CLIPBOARD");
+    case ui::ClipboardBuffer::kSelection:
+      return x11::Atom::PRIMARY;
+    case ui::ClipboardBuffer::kDrag:
+      break;
+  }
+  NOTREACHED();
+  return x11::Atom::None;
+}
+
+// Transfers one selection target into a property of a window of its own,
+// handling the events of the UI thread's X connection instead of waiting for
+// them as ui::Clipboard does. Large data sent in increments (INCR) is put
+// together as the owner provides it. The reader deletes itself once it has
+// run its callback.
+class SelectionReader : public x11::EventObserver {
+ public:
+  SelectionReader(x11::Atom selection,
+                  x11::Atom target,
+                  ReadDataCallback callback)
+      : connection_(x11::Connection::Get()),
+        selection_(selection),
+        target_(target),
+        property_(x11::GetAtom("ELECTRON_CLIPBOARD_READ")),
+        incr_(x11::GetAtom("INCR")),
+        callback_(std::move(callback)) {}
+
+  ~SelectionReader() override {
+    connection_->RemoveEventObserver(this);
+    connection_->DestroyWindow({window_});
+    connection_->Flush();
+  }
+
+  void Start() {
+    window_ = connection_->GenerateId<x11::Window>();
+    connection_->CreateWindow({
+        .wid = window_,
+        .parent = connection_->default_root(),
+        .width = 1,
+        .height = 1,
+        .c_class = x11::WindowClass::InputOnly,
+        .override_redirect = x11::Bool32(true),
+        .event_mask = x11::EventMask::PropertyChange,
+    });
+    connection_->AddEventObserver(this);
+    connection_->ConvertSelection({
+        .requestor = window_,
+        .selection = selection_,
+        .target = target_,
+        .property = property_,
+        .time = x11::Time::CurrentTime,
+    });
+    connection_->Flush();
+    timeout_.Start(FROM_HERE, kTransferTimeout,
+                   base::BindOnce(&SelectionReader::Finish,
+                                  base::Unretained(this), base::nullopt));
+  }
+
+ private:
+  // x11::EventObserver:
+  void OnEvent(const x11::Event& event) override {
+    if (auto* notify = event.As<x11::SelectionNotifyEvent>()) {
+      if (notify->requestor != window_ || notify->selection != selection_ ||
+          state_ != State::kWaitingForNotify)
+        return;
+      // The owner refuses targets it does not have, which reads as no data.
+      if (notify->property == x11::Atom::None) {
+        Finish(std::string());
+        return;
+      }
+      ReadProperty();
+      return;
+    }
+    if (auto* property = event.As<x11::PropertyNotifyEvent>()) {
+      // Every increment of an INCR transfer is announced by a new value of
+      // the property.
+      if (property->window == window_ && property->atom == property_ &&
+          property->state == x11::Property::NewValue &&
+          state_ == State::kWaitingForIncrement)
+        ReadProperty();
+    }
+  }
+
+  void ReadProperty() {
+    state_ = State::kReadingProperty;
+    // Deleting the property tells an INCR owner to send the next increment.
+    connection_
+        ->GetProperty({
+            .c_delete = true,
+            .window = window_,
+            .property = property_,
+            .long_length = std::numeric_limits<uint32_t>::max(),
+        })
+        .OnResponse(base::BindOnce(&SelectionReader::OnProperty,
+                                   weak_factory_.GetWeakPtr()));
+    connection_->Flush();
+  }
+
+  void OnProperty(x11::GetPropertyResponse response) {
+    if (!response) {
+      Finish(base::nullopt);
+      return;
+    }
+    if (response->type == incr_) {
+      // The value is only a lower bound of the size, the data follows in
+      // increments.
+      in_incr_transfer_ = true;
+      state_ = State::kWaitingForIncrement;
+      return;
+    }
+    size_t size = response->value_len * response->format / 8;
+    if (response->value && size)
+      data_.append(response->value->front_as<char>(), size);
+    if (in_incr_transfer_ && size) {
+      // The owner has the full timeout for each increment.
+      state_ = State::kWaitingForIncrement;
+      timeout_.Reset();
+      return;
+    }
+    // A whole value, or the empty increment that ends an INCR transfer.
+    Finish(std::move(data_));
+  }
+
+  void Finish(base::Optional<std::string> data) {
+    std::move(callback_).Run(std::move(data));
+    delete this;
+  }
+
+  enum class State {
+    kWaitingForNotify,
+    kReadingProperty,
+    kWaitingForIncrement,
+  };
+
+  x11::Connection* const connection_;
+  const x11::Atom selection_;
+  const x11::Atom target_;
+  const x11::Atom property_;
+  const x11::Atom incr_;
+  ReadDataCallback callback_;
+
+  x11::Window window_ = x11::Window::None;
+  State state_ = State::kWaitingForNotify;
+  bool in_incr_transfer_ = false;
+  std::string data_;
+  base::OneShotTimer timeout_;
+
+  base::WeakPtrFactory<SelectionReader> weak_factory_{this};
+
+  DISALLOW_COPY_AND_ASSIGN(SelectionReader);
+};
+
+}  // namespace
+
+bool CanReadDataAsync(ui::ClipboardBuffer buffer) {
+  // The Ozone platforms, such as Wayland or headless, have no X connection.
+  return !features::IsUsingOzonePlatform() &&
+         buffer != ui::ClipboardBuffer::kDrag;
+}
+
+void ReadDataAsync(ui::ClipboardBuffer buffer,
+                   const ui::ClipboardFormatType& format,
+                   ReadDataCallback callback) {
+  // ui::Clipboard requests formats under the atom of their name as well.
+  auto* reader =
+      new SelectionReader(GetSelectionAtom(buffer),
+                          x11::GetAtom(format.GetName()), std::move(callback));
+  reader->Start();
+}
+
+bool HasNonPNGImages() {
+  // ui::Clipboard only reads images from image/png data on X11.
+  return false;
+}
+
+}  // namespace internal
+}  // namespace clipboard_util
@@ -16,7 +16,9 @@
 #include "gin/dictionary.h"
 #include "net/cert/x509_certificate.h"
 #include "net/cert/x509_util.h"
+#include "net/http/http_byte_range.h"
 #include "net/http/http_response_headers.h"
+#include "net/http/http_util.h"
 #include "net/http/http_version.h"
 #include "net/url_request/redirect_info.h"
 #include "services/network/public/cpp/resource_request.h"
@@ -26,6 +28,32 @@
 #include "shell/common/gin_converters/value_converter.h"
 #include "shell/common/node_includes.h"
 
+namespace electron {
+
+const char* WebRequestResourceTypeToName(
+    extensions::WebRequestResourceType type) {
+  switch (type) {
+    case extensions::WebRequestResourceType::MAIN_FRAME:
+      return "mainFrame";
+    case extensions::WebRequestResourceType::SUB_FRAME:
+      return "subFrame";
+    case extensions::WebRequestResourceType::STYLESHEET:
+      return "stylesheet";
+    case extensions::WebRequestResourceType::SCRIPT:
+      return "script";
+    case extensions::WebRequestResourceType::IMAGE:
+      return "image";
+    case extensions::WebRequestResourceType::OBJECT:
+      return "object";
+    case extensions::WebRequestResourceType::XHR:
+      return "xhr";
+    default:
+      return "other";
+  }
+}
+
+}  // namespace electron
+
 namespace gin {
 
 namespace {
@@ -345,6 +373,21 @@ bool Converter<scoped_refptr<network::ResourceRequestBody>>::FromV8(
   return true;
 }
 
+// static
+v8::Local<v8::Value> Converter<net::HttpByteRange>::ToV8(
+    v8::Isolate* isolate,
+    const net::HttpByteRange& val) {
+  gin::Dictionary dict = gin::Dictionary::CreateEmpty(isolate);
+  if (val.IsSuffixByteRange()) {
+    dict.Set("suffixLength", val.suffix_length());
+  } else {
+    dict.Set("start", val.first_byte_position());
+    if (val.HasLastBytePosition())
+      dict.Set("end", val.last_byte_position());
+  }
+  return ConvertToV8(isolate, dict);
+}
+
 // static
 v8::Local<v8::Value> Converter<network::ResourceRequest>::ToV8(
     v8::Isolate* isolate,
@@ -356,6 +399,12 @@ v8::Local<v8::Value> Converter<network::ResourceRequest>::ToV8(
   dict.Set("headers", val.headers);
   if (val.request_body)
     dict.Set("uploadData", ConvertToV8(isolate, *val.request_body));
+  std::string range_header;
+  std::vector<net::HttpByteRange> ranges;
+  if (val.headers.GetHeader(net::HttpRequestHeaders::kRange, &range_header) &&
+      net::HttpUtil::ParseRangeHeader(range_header, &ranges)) {
+    dict.Set("ranges", ranges);
+  }
   return ConvertToV8(isolate, dict);
 }
 
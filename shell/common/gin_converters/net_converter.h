@@ -9,6 +9,7 @@
 #include <utility>
 #include <vector>
 
+#include "extensions/browser/api/web_request/web_request_resource_type.h"
 #include "gin/converter.h"
 #include "services/network/public/mojom/fetch_api.mojom.h"
 #include "shell/browser/net/cert_verifier_client.h"
@@ -25,14 +26,31 @@ class X509Certificate;
 class HttpResponseHeaders;
 struct CertPrincipal;
 class HttpVersion;
+class HttpByteRange;
 }  // namespace net
 
 namespace network {
 struct ResourceRequest;
 }
 
+namespace electron {
+
+// Returns the name of |type| used in the resourceType of webRequest details.
+const char* WebRequestResourceTypeToName(
+    extensions::WebRequestResourceType type);
+
+}  // namespace electron
+
 namespace gin {
 
+template <>
+struct Converter<extensions::WebRequestResourceType> {
+  static v8::Local<v8::Value> ToV8(v8::Isolate* isolate,
+                                   extensions::WebRequestResourceType type) {
+    return StringToV8(isolate, electron::WebRequestResourceTypeToName(type));
+  }
+};
+
 template <>
 struct Converter<net::AuthChallengeInfo> {
   static v8::Local<v8::Value> ToV8(v8::Isolate* isolate,
@@ -90,6 +108,12 @@ struct Converter<scoped_refptr<network::ResourceRequestBody>> {
                      scoped_refptr<network::ResourceRequestBody>* out);
 };
 
+template <>
+struct Converter<net::HttpByteRange> {
+  static v8::Local<v8::Value> ToV8(v8::Isolate* isolate,
+                                   const net::HttpByteRange& val);
+};
+
 template <>
 struct Converter<network::ResourceRequest> {
   static v8::Local<v8::Value> ToV8(v8::Isolate* isolate,
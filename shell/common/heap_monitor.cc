@@ -0,0 +1,127 @@
+// Copyright (c) 2021 GitHub, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#include "shell/common/heap_monitor.h"
+
+#include "base/bind.h"
+#include "base/files/file.h"
+#include "base/threading/thread_restrictions.h"
+#include "base/threading/thread_task_runner_handle.h"
+#include "shell/common/heap_snapshot.h"
+
+namespace electron {
+
+HeapMonitor::HeapMonitor(v8::Isolate* isolate, Delegate* delegate)
+    : isolate_(isolate), delegate_(delegate) {
+  isolate_->AddNearHeapLimitCallback(&HeapMonitor::NearHeapLimitCallback,
+                                     this);
+  isolate_->AddGCEpilogueCallback(&HeapMonitor::GCEpilogueCallback, this,
+                                  v8::kGCTypeMarkSweepCompact);
+}
+
+HeapMonitor::~HeapMonitor() {
+  isolate_->RemoveGCEpilogueCallback(&HeapMonitor::GCEpilogueCallback, this);
+  isolate_->RemoveNearHeapLimitCallback(&HeapMonitor::NearHeapLimitCallback,
+                                        limit_before_raise_);
+}
+
+void HeapMonitor::SetOptions(const Options& options) {
+  options_ = options;
+  heap_snapshot_taken_ = false;
+  if (options_.max_old_space_size == 0)
+    return;
+
+  // A higher limit is applied by NearHeapLimitCallback once the current one
+  // is reached, a lower one has to be applied right away. The heap size limit
+  // of the statistics also counts the young generation, so it can not tell
+  // which one it is, but V8 never raises the old generation limit when
+  // restoring it.
+  LowerHeapLimit(options_.max_old_space_size);
+}
+
+void HeapMonitor::SetStatisticsEnabled(bool enabled) {
+  statistics_enabled_ = enabled;
+}
+
+// static
+size_t HeapMonitor::NearHeapLimitCallback(void* data,
+                                          size_t current_heap_limit,
+                                          size_t initial_heap_limit) {
+  return static_cast<HeapMonitor*>(data)->OnNearHeapLimit(current_heap_limit);
+}
+
+// static
+void HeapMonitor::GCEpilogueCallback(v8::Isolate* isolate,
+                                     v8::GCType type,
+                                     v8::GCCallbackFlags flags,
+                                     void* data) {
+  auto* self = static_cast<HeapMonitor*>(data);
+  // JavaScript can not run during a garbage collection.
+  if (self->statistics_enabled_ || self->limit_before_raise_) {
+    base::ThreadTaskRunnerHandle::Get()->PostTask(
+        FROM_HERE, base::BindOnce(&HeapMonitor::OnFullGC,
+                                  self->weak_factory_.GetWeakPtr()));
+  }
+}
+
+size_t HeapMonitor::OnNearHeapLimit(size_t current_heap_limit) {
+  if (options_.max_old_space_size > current_heap_limit &&
+      !limit_before_raise_)
+    return options_.max_old_space_size;
+
+  NearHeapLimitDetails details;
+  details.heap_limit = current_heap_limit;
+
+  if (!options_.heap_snapshot_path.empty() && !heap_snapshot_taken_) {
+    heap_snapshot_taken_ = true;
+    base::ThreadRestrictions::ScopedAllowIO allow_io;
+    base::File file(options_.heap_snapshot_path,
+                    base::File::FLAG_CREATE_ALWAYS | base::File::FLAG_WRITE);
+    if (TakeHeapSnapshot(isolate_, &file))
+      details.heap_snapshot_path = options_.heap_snapshot_path;
+  }
+
+  // The limit is only raised once, hitting it again is fatal.
+  if (options_.extra_old_space_size == 0 || limit_before_raise_)
+    return current_heap_limit;
+
+  limit_before_raise_ = current_heap_limit;
+  details.raised_heap_limit =
+      current_heap_limit + options_.extra_old_space_size;
+  // JavaScript can not run during a garbage collection.
+  base::ThreadTaskRunnerHandle::Get()->PostTask(
+      FROM_HERE, base::BindOnce(&HeapMonitor::NotifyNearHeapLimit,
+                                weak_factory_.GetWeakPtr(), details));
+  return details.raised_heap_limit;
+}
+
+void HeapMonitor::NotifyNearHeapLimit(const NearHeapLimitDetails& details) {
+  delegate_->OnNearHeapLimit(details);
+}
+
+void HeapMonitor::OnFullGC() {
+  if (limit_before_raise_) {
+    v8::HeapStatistics stats;
+    isolate_->GetHeapStatistics(&stats);
+    if (stats.used_heap_size() < limit_before_raise_ / 2) {
+      size_t heap_limit = limit_before_raise_;
+      limit_before_raise_ = 0;
+      LowerHeapLimit(heap_limit);
+    }
+  }
+
+  if (statistics_enabled_)
+    delegate_->OnHeapStatisticsUpdated();
+}
+
+void HeapMonitor::LowerHeapLimit(size_t heap_limit) {
+  // V8 restores the heap limit when a near heap limit callback is removed,
+  // without going below the live objects.
+  isolate_->RemoveNearHeapLimitCallback(&HeapMonitor::NearHeapLimitCallback,
+                                        heap_limit);
+  isolate_->AddNearHeapLimitCallback(&HeapMonitor::NearHeapLimitCallback,
+                                     this);
+}
+
+}  // namespace electron
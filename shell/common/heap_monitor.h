@@ -0,0 +1,85 @@
+// Copyright (c) 2021 GitHub, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#ifndef SHELL_COMMON_HEAP_MONITOR_H_
+#define SHELL_COMMON_HEAP_MONITOR_H_
+
+#include "base/files/file_path.h"
+#include "base/macros.h"
+#include "base/memory/weak_ptr.h"
+#include "v8/include/v8.h"
+
+namespace electron {
+
+// Watches the heap of the main isolate. It applies a configured heap limit,
+// and when the limit is nearly reached, it can write a heap snapshot and
+// raise the limit once so the app gets a chance to release memory instead
+// of crashing. The raised limit is restored after a full GC shrank the heap.
+class HeapMonitor {
+ public:
+  struct Options {
+    // Old generation limit in bytes, 0 keeps the default.
+    size_t max_old_space_size = 0;
+    // How much the limit is raised when it is nearly reached, 0 disables it.
+    size_t extra_old_space_size = 0;
+    // Written the first time the limit is nearly reached, empty disables it.
+    base::FilePath heap_snapshot_path;
+  };
+
+  struct NearHeapLimitDetails {
+    size_t heap_limit = 0;
+    size_t raised_heap_limit = 0;
+    // Empty unless the snapshot was written.
+    base::FilePath heap_snapshot_path;
+  };
+
+  class Delegate {
+   public:
+    // Called after the garbage collection that nearly reached the limit,
+    // only when the limit has been raised.
+    virtual void OnNearHeapLimit(const NearHeapLimitDetails& details) = 0;
+    // Called after every full garbage collection while enabled.
+    virtual void OnHeapStatisticsUpdated() = 0;
+
+   protected:
+    virtual ~Delegate() = default;
+  };
+
+  HeapMonitor(v8::Isolate* isolate, Delegate* delegate);
+  ~HeapMonitor();
+
+  void SetOptions(const Options& options);
+  void SetStatisticsEnabled(bool enabled);
+
+ private:
+  static size_t NearHeapLimitCallback(void* data,
+                                      size_t current_heap_limit,
+                                      size_t initial_heap_limit);
+  static void GCEpilogueCallback(v8::Isolate* isolate,
+                                 v8::GCType type,
+                                 v8::GCCallbackFlags flags,
+                                 void* data);
+
+  size_t OnNearHeapLimit(size_t current_heap_limit);
+  void NotifyNearHeapLimit(const NearHeapLimitDetails& details);
+  void OnFullGC();
+  // Replaces the current limit by |heap_limit| if it is lower.
+  void LowerHeapLimit(size_t heap_limit);
+
+  v8::Isolate* isolate_;
+  Delegate* delegate_;
+  Options options_;
+  bool statistics_enabled_ = false;
+  bool heap_snapshot_taken_ = false;
+  // The limit from before it was raised, 0 while it is not raised.
+  size_t limit_before_raise_ = 0;
+
+  base::WeakPtrFactory<HeapMonitor> weak_factory_{this};
+
+  DISALLOW_COPY_AND_ASSIGN(HeapMonitor);
+};
+
+}  // namespace electron
+
+#endif  // SHELL_COMMON_HEAP_MONITOR_H_
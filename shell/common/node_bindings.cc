@@ -67,6 +67,7 @@
   V(electron_browser_web_frame_main)     \
   V(electron_browser_web_view_manager)   \
   V(electron_browser_window)             \
+  V(electron_browser_worker_thread)      \
   V(electron_common_asar)                \
   V(electron_common_clipboard)           \
   V(electron_common_command_line)        \
@@ -78,6 +79,7 @@
   V(electron_common_screen)              \
   V(electron_common_shell)               \
   V(electron_common_v8_util)             \
+  V(electron_renderer_code_cache)        \
   V(electron_renderer_context_bridge)    \
   V(electron_renderer_crash_reporter)    \
   V(electron_renderer_ipc)               \
@@ -299,6 +301,10 @@ base::FilePath GetResourcesPath() {
 #endif
 }
 
+// The embed thread only waits for uv events, so the ones of web workers, which
+// pages can create by the dozen, do not need the platform's default stack.
+constexpr size_t kWorkerEmbedThreadStackSize = 256 * 1024;
+
 }  // namespace
 
 NodeBindings::NodeBindings(BrowserEnvironment browser_env)
@@ -548,7 +554,14 @@ void NodeBindings::PrepareMessageLoop() {
 
   // Start worker that will interrupt main loop when having uv events.
   uv_sem_init(&embed_sem_, 0);
-  uv_thread_create(&embed_thread_, EmbedThreadRunner, this);
+  if (in_worker_loop()) {
+    uv_thread_options_t options;
+    options.flags = UV_THREAD_HAS_STACK_SIZE;
+    options.stack_size = kWorkerEmbedThreadStackSize;
+    uv_thread_create_ex(&embed_thread_, &options, EmbedThreadRunner, this);
+  } else {
+    uv_thread_create(&embed_thread_, EmbedThreadRunner, this);
+  }
 }
 
 void NodeBindings::RunMessageLoop() {
@@ -142,6 +142,9 @@ const char kDisableBlinkFeatures[] = "disableBlinkFeatures";
 // Enable the node integration in WebWorker.
 const char kNodeIntegrationInWorker[] = "nodeIntegrationInWorker";
 
+// Limit of the renderer's V8 old generation in megabytes.
+const char kMaxOldSpaceSize[] = "maxOldSpaceSize";
+
 // Enable the web view tag.
 const char kWebviewTag[] = "webviewTag";
 
@@ -245,6 +248,9 @@ const char kScrollBounce[] = "scroll-bounce";
 // Command switch passed to renderer process to control nodeIntegration.
 const char kNodeIntegrationInWorker[] = "node-integration-in-worker";
 
+// Command switch passed to renderer process to control maxOldSpaceSize.
+const char kRendererMaxOldSpaceSize[] = "renderer-max-old-space-size";
+
 // Widevine options
 // Path to Widevine CDM binaries.
 const char kWidevineCdmPath[] = "widevine-cdm-path";
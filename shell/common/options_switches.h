@@ -72,6 +72,7 @@ extern const char kScrollBounce[];
 extern const char kEnableBlinkFeatures[];
 extern const char kDisableBlinkFeatures[];
 extern const char kNodeIntegrationInWorker[];
+extern const char kMaxOldSpaceSize[];
 extern const char kWebviewTag[];
 extern const char kNativeWindowOpen[];
 extern const char kCustomArgs[];
@@ -121,6 +122,7 @@ extern const char kEnableApiFilteringLogging[];
 
 extern const char kScrollBounce[];
 extern const char kNodeIntegrationInWorker[];
+extern const char kRendererMaxOldSpaceSize[];
 
 extern const char kWidevineCdmPath[];
 extern const char kWidevineCdmVersion[];
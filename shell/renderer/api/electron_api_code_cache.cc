@@ -0,0 +1,173 @@
+// Copyright (c) 2021 GitHub, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "base/containers/mru_cache.h"
+#include "base/macros.h"
+#include "base/memory/ref_counted_memory.h"
+#include "base/no_destructor.h"
+#include "base/synchronization/lock.h"
+#include "base/thread_annotations.h"
+#include "crypto/sha2.h"
+#include "shell/common/gin_helper/dictionary.h"
+#include "shell/common/node_includes.h"
+
+namespace {
+
+// Code caches of the CommonJS modules loaded by the Node.js environments of
+// the web workers in this process. The first worker that loads a module
+// caches its code once the module has run, and the workers that load it later
+// consume that cache instead of compiling the module again. Entries are
+// matched by file name and a hash of the source, and V8 rejects data that was
+// produced with different flags.
+class SharedCodeCache {
+ public:
+  static SharedCodeCache* GetInstance() {
+    static base::NoDestructor<SharedCodeCache> instance;
+    return instance.get();
+  }
+
+  SharedCodeCache() : entries_(Entries::NO_AUTO_EVICT) {}
+
+  scoped_refptr<base::RefCountedBytes> Get(const std::string& filename,
+                                           const std::string& source) {
+    base::AutoLock auto_lock(lock_);
+    if (!enabled_)
+      return nullptr;
+    auto it = entries_.Get(filename);
+    if (it == entries_.end() ||
+        it->second.source_hash != crypto::SHA256HashString(source)) {
+      misses_++;
+      return nullptr;
+    }
+    hits_++;
+    return it->second.data;
+  }
+
+  void Set(const std::string& filename,
+           const std::string& source,
+           std::vector<unsigned char> data) {
+    base::AutoLock auto_lock(lock_);
+    if (!enabled_ || data.size() > kMaxSize)
+      return;
+    auto it = entries_.Peek(filename);
+    if (it != entries_.end()) {
+      size_ -= it->second.data->size();
+      entries_.Erase(it);
+    }
+    size_ += data.size();
+    entries_.Put(filename,
+                 Entry{crypto::SHA256HashString(source),
+                       base::RefCountedBytes::TakeVector(&data)});
+    while (size_ > kMaxSize || entries_.size() > kMaxEntries) {
+      auto oldest = entries_.rbegin();
+      size_ -= oldest->second.data->size();
+      entries_.Erase(oldest);
+    }
+  }
+
+  void SetEnabled(bool enabled) {
+    base::AutoLock auto_lock(lock_);
+    enabled_ = enabled;
+    if (!enabled) {
+      entries_.Clear();
+      size_ = 0;
+    }
+  }
+
+  void GetStats(gin_helper::Dictionary* stats) {
+    base::AutoLock auto_lock(lock_);
+    stats->Set("hits", hits_);
+    stats->Set("misses", misses_);
+    stats->Set("entries", static_cast<uint64_t>(entries_.size()));
+    stats->Set("size", static_cast<uint64_t>(size_));
+  }
+
+ private:
+  struct Entry {
+    std::string source_hash;
+    scoped_refptr<base::RefCountedBytes> data;
+  };
+  using Entries = base::MRUCache<std::string, Entry>;
+
+  // A worker pool rarely loads more than a few megabytes of code, the limits
+  // only keep a page that loads many modules from growing the cache forever.
+  static constexpr size_t kMaxSize = 32 * 1024 * 1024;
+  static constexpr size_t kMaxEntries = 2048;
+
+  base::Lock lock_;
+  Entries entries_ GUARDED_BY(lock_);
+  size_t size_ GUARDED_BY(lock_) = 0;
+  bool enabled_ GUARDED_BY(lock_) = true;
+  uint64_t hits_ GUARDED_BY(lock_) = 0;
+  uint64_t misses_ GUARDED_BY(lock_) = 0;
+
+  DISALLOW_COPY_AND_ASSIGN(SharedCodeCache);
+};
+
+// Returns the cached code of |filename| as a Buffer that refers to the
+// shared data, or undefined if there is none for |source|.
+v8::Local<v8::Value> Get(v8::Isolate* isolate,
+                         const std::string& filename,
+                         const std::string& source) {
+  scoped_refptr<base::RefCountedBytes> data =
+      SharedCodeCache::GetInstance()->Get(filename, source);
+  if (!data)
+    return v8::Undefined(isolate);
+  char* bytes = const_cast<char*>(data->front_as<char>());
+  size_t length = data->size();
+  // The Buffer keeps a reference to the data, which V8 only reads.
+  return node::Buffer::New(
+             isolate, bytes, length,
+             [](char* data, void* hint) {
+               static_cast<base::RefCountedBytes*>(hint)->Release();
+             },
+             data.release())
+      .ToLocalChecked();
+}
+
+// Caches the code of |function|, the compiled wrapper of the module in
+// |filename|. Called once the module has run, so that the functions it
+// compiled while loading are cached as well.
+void Set(const std::string& filename,
+         const std::string& source,
+         v8::Local<v8::Function> function) {
+  std::unique_ptr<v8::ScriptCompiler::CachedData> cached_data(
+      v8::ScriptCompiler::CreateCodeCacheForFunction(function));
+  if (!cached_data)
+    return;
+  SharedCodeCache::GetInstance()->Set(
+      filename, source,
+      std::vector<unsigned char>(cached_data->data,
+                                 cached_data->data + cached_data->length));
+}
+
+void SetEnabledForTesting(bool enabled) {
+  SharedCodeCache::GetInstance()->SetEnabled(enabled);
+}
+
+v8::Local<v8::Value> GetStatsForTesting(v8::Isolate* isolate) {
+  gin_helper::Dictionary stats = gin::Dictionary::CreateEmpty(isolate);
+  SharedCodeCache::GetInstance()->GetStats(&stats);
+  return stats.GetHandle();
+}
+
+void Initialize(v8::Local<v8::Object> exports,
+                v8::Local<v8::Value> unused,
+                v8::Local<v8::Context> context,
+                void* priv) {
+  gin_helper::Dictionary dict(context->GetIsolate(), exports);
+  dict.SetMethod("get", &Get);
+  dict.SetMethod("set", &Set);
+  dict.SetMethod("setEnabledForTesting", &SetEnabledForTesting);
+  dict.SetMethod("getStatsForTesting", &GetStatsForTesting);
+}
+
+}  // namespace
+
+NODE_LINKED_MODULE_CONTEXT_AWARE(electron_renderer_code_cache, Initialize)
@@ -10,6 +10,7 @@
 #include <vector>
 
 #include "base/command_line.h"
+#include "base/strings/string_number_conversions.h"
 #include "base/strings/string_split.h"
 #include "base/strings/stringprintf.h"
 #include "components/network_hints/renderer/web_prescient_networking_impl.h"
@@ -21,7 +22,9 @@
 #include "content/public/renderer/render_view.h"
 #include "electron/buildflags/buildflags.h"
 #include "media/blink/multibuffer_data_source.h"
+#include "mojo/public/cpp/bindings/remote.h"
 #include "printing/buildflags/buildflags.h"
+#include "shell/common/api/api.mojom.h"
 #include "shell/common/color_util.h"
 #include "shell/common/gin_helper/dictionary.h"
 #include "shell/common/options_switches.h"
@@ -31,6 +34,7 @@
 #include "shell/renderer/electron_api_service_impl.h"
 #include "shell/renderer/electron_autofill_agent.h"
 #include "third_party/blink/public/common/associated_interfaces/associated_interface_registry.h"
+#include "third_party/blink/public/common/browser_interface_broker_proxy.h"
 #include "third_party/blink/public/common/web_preferences/web_preferences.h"
 #include "third_party/blink/public/web/blink.h"
 #include "third_party/blink/public/web/web_custom_element.h"  // NOLINT(build/include_alpha)
@@ -228,6 +232,23 @@ void RendererClientBase::RenderThreadStarted() {
     SetCurrentProcessExplicitAppUserModelID(app_id.c_str());
   }
 #endif
+
+  // Blink has already created the main thread isolate at this point, the
+  // limit is applied before any page script runs instead.
+  int max_old_space_size = 0;
+  if (base::StringToInt(
+          command_line->GetSwitchValueASCII(switches::kRendererMaxOldSpaceSize),
+          &max_old_space_size) &&
+      max_old_space_size > 0) {
+    HeapMonitor::Options options;
+    options.max_old_space_size = static_cast<size_t>(max_old_space_size)
+                                 << 20;
+    // Leave the page some room while the main process decides what to do.
+    options.extra_old_space_size = options.max_old_space_size / 4;
+    heap_monitor_ =
+        std::make_unique<HeapMonitor>(blink::MainThreadIsolate(), this);
+    heap_monitor_->SetOptions(options);
+  }
 }
 
 void RendererClientBase::ExposeInterfacesToBrowser(mojo::BinderMap* binders) {
@@ -247,6 +268,8 @@ void RendererClientBase::RenderFrameCreated(
   new PepperHelper(render_frame);
 #endif
   new ContentSettingsObserver(render_frame);
+  if (heap_monitor_ && render_frame->IsMainFrame())
+    main_frame_routing_ids_.insert(render_frame->GetRoutingID());
 #if BUILDFLAG(ENABLE_PRINTING)
   new printing::PrintRenderFrameHelper(
       render_frame,
@@ -290,6 +313,24 @@ void RendererClientBase::GetInterface(
 }
 #endif
 
+void RendererClientBase::OnNearHeapLimit(
+    const HeapMonitor::NearHeapLimitDetails& details) {
+  for (auto it = main_frame_routing_ids_.begin();
+       it != main_frame_routing_ids_.end();) {
+    auto* render_frame = content::RenderFrame::FromRoutingID(*it);
+    if (!render_frame) {
+      it = main_frame_routing_ids_.erase(it);
+      continue;
+    }
+    mojo::Remote<mojom::ElectronBrowser> browser_remote;
+    render_frame->GetBrowserInterfaceBroker()->GetInterface(
+        browser_remote.BindNewPipeAndPassReceiver());
+    browser_remote->OnNearHeapLimit(details.heap_limit,
+                                    details.raised_heap_limit);
+    ++it;
+  }
+}
+
 void RendererClientBase::DidClearWindowObject(
     content::RenderFrame* render_frame) {
   // Make sure every page will get a script context created.
@@ -6,6 +6,7 @@
 #define SHELL_RENDERER_RENDERER_CLIENT_BASE_H_
 
 #include <memory>
+#include <set>
 #include <string>
 #include <unordered_map>
 #include <vector>
@@ -14,6 +15,7 @@
 #include "electron/buildflags/buildflags.h"
 #include "printing/buildflags/buildflags.h"
 #include "shell/common/gin_helper/dictionary.h"
+#include "shell/common/heap_monitor.h"
 #include "third_party/blink/public/web/web_local_frame.h"
 // In SHARED_INTERMEDIATE_DIR.
 #include "widevine_cdm_version.h"  // NOLINT(build/include_directory)
@@ -50,7 +52,8 @@ class ElectronApiServiceImpl;
 class ElectronExtensionsRendererClient;
 #endif
 
-class RendererClientBase : public content::ContentRendererClient
+class RendererClientBase : public content::ContentRendererClient,
+                           public HeapMonitor::Delegate
 #if BUILDFLAG(ENABLE_BUILTIN_SPELLCHECKER)
     ,
                            public service_manager::LocalInterfaceProvider
@@ -141,6 +144,11 @@ class RendererClientBase : public content::ContentRendererClient
       const GURL& service_worker_scope,
       const GURL& script_url) override;
 
+  // HeapMonitor::Delegate:
+  void OnNearHeapLimit(
+      const HeapMonitor::NearHeapLimitDetails& details) override;
+  void OnHeapStatisticsUpdated() override {}
+
  protected:
 #if BUILDFLAG(ENABLE_ELECTRON_EXTENSIONS)
   // app_shell embedders may need custom extensions client interfaces.
@@ -161,6 +169,12 @@ class RendererClientBase : public content::ContentRendererClient
   // An increasing ID used for identifying an V8 context in this process.
   int64_t next_context_id_ = 0;
 
+  // Only created when the maxOldSpaceSize web preference is set.
+  std::unique_ptr<HeapMonitor> heap_monitor_;
+  // Routing IDs of the main frames to notify when the heap limit is nearly
+  // reached.
+  std::set<int> main_frame_routing_ids_;
+
 #if BUILDFLAG(ENABLE_BUILTIN_SPELLCHECKER)
   std::unique_ptr<SpellCheck> spellcheck_;
 #endif
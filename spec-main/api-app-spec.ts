@@ -143,6 +143,48 @@ describe('app module', () => {
     });
   });
 
+  describe('app.setHeapLimitOptions(options)', () => {
+    let appProcess: cp.ChildProcess | null = null;
+    afterEach(() => {
+      if (appProcess) appProcess.kill();
+    });
+
+    it('emits near-heap-limit with a heap snapshot instead of running out of memory', async function () {
+      this.timeout(120000);
+      const appPath = path.join(fixturesPath, 'api', 'heap-limit-app');
+      const heapSnapshotPath = path.join(app.getPath('temp'), `electron-heap-limit-${process.pid}.heapsnapshot`);
+      let output = '';
+      appProcess = cp.spawn(process.execPath, [appPath, heapSnapshotPath]);
+      appProcess.stdout!.on('data', data => { output += data; });
+      try {
+        const [code] = await emittedOnce(appProcess, 'exit');
+        expect(code).to.equal(0);
+        const { details, heapSnapshotSize } = JSON.parse(output);
+        expect(details.heapLimit).to.be.at.most(128 * 1024);
+        expect(details.raisedHeapLimit).to.equal(details.heapLimit + 64 * 1024);
+        expect(details.heapSnapshotPath).to.equal(heapSnapshotPath);
+        expect(heapSnapshotSize).to.be.greaterThan(0);
+      } finally {
+        if (fs.existsSync(heapSnapshotPath)) fs.unlinkSync(heapSnapshotPath);
+      }
+    });
+
+    it('does not accept invalid sizes', () => {
+      expect(() => app.setHeapLimitOptions({ maxOldSpaceSize: -1 })).to.throw(/maxOldSpaceSize must be a non-negative integer/);
+      expect(() => app.setHeapLimitOptions({ extraOldSpaceSize: 1.5 })).to.throw(/extraOldSpaceSize must be a non-negative integer/);
+    });
+  });
+
+  describe('heap-statistics-updated event', () => {
+    it('is emitted after a full garbage collection', async () => {
+      const emitted = emittedOnce(app, 'heap-statistics-updated');
+      require('vm').runInNewContext('gc')();
+      const [, heapStatistics] = await emitted;
+      expect(heapStatistics.usedHeapSize).to.be.a('number').that.is.greaterThan(0);
+      expect(heapStatistics.heapSizeLimit).to.be.a('number').that.is.greaterThan(0);
+    });
+  });
+
   describe('app.exit(exitCode)', () => {
     let appProcess: cp.ChildProcess | null = null;
 
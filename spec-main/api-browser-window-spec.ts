@@ -4441,6 +4441,26 @@ describe('BrowserWindow module', () => {
       w.loadFile(path.join(fixtures, 'api', 'offscreen-rendering.html'));
     });
 
+    ifit(process.platform === 'linux')('renders without a display in headless mode', async () => {
+      const appPath = path.join(__dirname, 'fixtures', 'api', 'headless-offscreen');
+      const env = { ...process.env };
+      delete env.DISPLAY;
+      delete env.WAYLAND_DISPLAY;
+      const appProcess = childProcess.spawn(process.execPath, [appPath, '--ozone-platform=headless'], { env });
+
+      let output = '';
+      appProcess.stdout.on('data', data => { output += data; });
+      appProcess.stderr.on('data', data => { output += data; });
+
+      const [code] = await emittedOnce(appProcess, 'exit');
+      expect(code).to.equal(0, output);
+      expect(output).to.include('Only offscreen windows can be created in headless mode');
+      expect(output).to.include('Cannot show dialogs in headless mode');
+      expect(output).to.include('Cannot show menus in headless mode');
+      expect(output).not.to.include('Showed native UI');
+      expect(output).to.include('Painted 100x100');
+    });
+
     describe('window.webContents.isOffscreen()', () => {
       it('is true for offscreen type', () => {
         w.loadFile(path.join(fixtures, 'api', 'offscreen-rendering.html'));
@@ -121,6 +121,109 @@ describe('netLog module', () => {
     expect(JSON.parse(dump).events.some((x: any) => x.params && x.params.bytes && Buffer.from(x.params.bytes, 'base64').includes(unique))).to.be.true('uuid present in dump');
   });
 
+  describe('recording', () => {
+    const makeRequest = () => new Promise<void>((resolve) => {
+      const req = net.request({ url: serverUrl, session: session.fromPartition('net-log') });
+      req.on('response', (response) => {
+        response.on('data', () => {});
+        response.on('end', () => resolve());
+      });
+      req.end();
+    });
+
+    const waitForEvents = async (predicate: (events: any[]) => boolean) => {
+      await makeRequest();
+      const events = await testNetLog().getRecordedEvents();
+      expect(predicate(events)).to.be.true('recorded events match');
+      return events;
+    };
+
+    afterEach(async () => {
+      if (testNetLog().currentlyRecording) {
+        await testNetLog().stopRecording();
+      }
+    });
+
+    it('records events in memory', async () => {
+      await testNetLog().startRecording();
+      expect(testNetLog().currentlyRecording).to.be.true('currently recording');
+      const events = await waitForEvents(events => events.some(e => e.type === 'URL_REQUEST_START_JOB'));
+      const event = events.find(e => e.type === 'URL_REQUEST_START_JOB');
+      expect(event.source.type).to.equal('URL_REQUEST');
+      expect(event.phase).to.be.oneOf(['PHASE_BEGIN', 'PHASE_END', 'PHASE_NONE']);
+      await testNetLog().stopRecording();
+      expect(testNetLog().currentlyRecording).to.be.false('currently recording');
+    });
+
+    it('keeps the events of earlier reads', async () => {
+      await testNetLog().startRecording({ eventTypes: ['URL_REQUEST_START_JOB'] });
+      const first = await waitForEvents(events => events.length > 0);
+      const second = await waitForEvents(events => events.length > first.length);
+      expect(second.slice(0, first.length)).to.deep.equal(first);
+      const [third, fourth] = await Promise.all([
+        testNetLog().getRecordedEvents(),
+        testNetLog().getRecordedEvents()
+      ]);
+      expect(third).to.deep.equal(second);
+      expect(fourth).to.deep.equal(second);
+    });
+
+    it('does not repeat events across reads', async () => {
+      await testNetLog().startRecording({ eventTypes: ['URL_REQUEST_START_JOB'] });
+      for (let i = 0; i < 5; i++) {
+        await makeRequest();
+        await testNetLog().getRecordedEvents();
+      }
+      const events = await testNetLog().getRecordedEvents();
+      const keys = events.map(e => `${e.time}:${e.source.id}:${e.type}:${e.phase}`);
+      expect(events).to.have.lengthOf.at.least(5);
+      expect(new Set(keys).size).to.equal(keys.length);
+    });
+
+    it('filters events by event and source type', async () => {
+      await testNetLog().startRecording({ eventTypes: ['URL_REQUEST_START_JOB'], sourceTypes: ['URL_REQUEST'] });
+      const events = await waitForEvents(events => events.length > 0);
+      for (const event of events) {
+        expect(event.type).to.equal('URL_REQUEST_START_JOB');
+        expect(event.source.type).to.equal('URL_REQUEST');
+      }
+    });
+
+    it('bounds the recorded events by maxSize', async () => {
+      const maxSize = 4096;
+      await testNetLog().startRecording({ maxSize });
+      const events = await waitForEvents(events => events.length > 0);
+      expect(JSON.stringify(events).length).to.be.at.most(maxSize * 2);
+      for (let i = 0; i < 10; i++) await makeRequest();
+      const later = await testNetLog().getRecordedEvents();
+      expect(JSON.stringify(later).length).to.be.at.most(maxSize * 2);
+    });
+
+    it('can record while logging to a file', async () => {
+      await testNetLog().startLogging(dumpFileDynamic);
+      await testNetLog().startRecording();
+      await waitForEvents(events => events.length > 0);
+      await testNetLog().stopLogging();
+      expect(testNetLog().currentlyRecording).to.be.true('currently recording');
+      expect(fs.existsSync(dumpFileDynamic)).to.be.true('dump file exists');
+    });
+
+    it('throws when already recording', async () => {
+      await testNetLog().startRecording();
+      expect(() => testNetLog().startRecording()).to.throw(/already a net log recording/);
+    });
+
+    it('throws on invalid options', () => {
+      expect(() => testNetLog().startRecording({ maxSize: 0 })).to.throw();
+      expect(() => testNetLog().startRecording({ captureMode: 'aoeu' as any })).to.throw();
+    });
+
+    it('rejects when not recording', async () => {
+      await expect(testNetLog().getRecordedEvents()).to.be.rejectedWith('No net log recording in progress');
+      await expect(testNetLog().stopRecording()).to.be.rejectedWith('No net log recording in progress');
+    });
+  });
+
   ifit(process.platform !== 'linux')('should begin and end logging automatically when --log-net-log is passed', async () => {
     const appProcess = ChildProcess.spawn(process.execPath,
       [appPath], {
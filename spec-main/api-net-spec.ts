@@ -1,6 +1,9 @@
 import { expect } from 'chai';
 import { net, session, ClientRequest, BrowserWindow, ClientRequestConstructorOptions } from 'electron/main';
+import * as fs from 'fs';
 import * as http from 'http';
+import * as os from 'os';
+import * as path from 'path';
 import * as url from 'url';
 import { AddressInfo, Socket } from 'net';
 import { emittedOnce } from './events-helpers';
@@ -176,6 +179,110 @@ describe('net module', () => {
       expect(response.statusCode).to.equal(200);
     });
 
+    it('should post all buffered chunks in order with a Content-Length', async () => {
+      const chunks = [1, 7, kOneKiloByte, 3, 64 * kOneKiloByte, 0, 5].map(size => randomBuffer(size));
+      const sent = Buffer.concat(chunks);
+      const serverUrl = await respondOnce.toSingleURL(async (request, response) => {
+        expect(request.headers['content-length']).to.equal(sent.length.toString());
+        expect(request.headers['transfer-encoding']).to.equal(undefined);
+        const received = await collectStreamBodyBuffer(request);
+        expect(received.equals(sent)).to.be.true();
+        response.end();
+      });
+      const urlRequest = net.request({
+        method: 'POST',
+        url: serverUrl
+      });
+      for (const chunk of chunks) {
+        urlRequest.write(chunk);
+      }
+      const response = await getResponse(urlRequest);
+      expect(response.statusCode).to.equal(200);
+    });
+
+    describe('file uploads', () => {
+      let tmpDir: string;
+      let filePath: string;
+      let fileContents: Buffer;
+      before(async () => {
+        tmpDir = await fs.promises.mkdtemp(path.join(os.tmpdir(), 'electron-net-spec-'));
+        filePath = path.join(tmpDir, 'upload.bin');
+        fileContents = randomBuffer(16 * kOneMegaByte);
+        await fs.promises.writeFile(filePath, fileContents);
+      });
+      after(async () => {
+        await fs.promises.rmdir(tmpDir, { recursive: true });
+      });
+
+      it('should upload a whole file', async () => {
+        const serverUrl = await respondOnce.toSingleURL(async (request, response) => {
+          expect(request.headers['content-length']).to.equal(fileContents.length.toString());
+          const received = await collectStreamBodyBuffer(request);
+          expect(received.equals(fileContents)).to.be.true();
+          response.end();
+        });
+        const urlRequest = net.request({ method: 'POST', url: serverUrl });
+        urlRequest.writeFile(filePath);
+        const response = await getResponse(urlRequest);
+        expect(response.statusCode).to.equal(200);
+      });
+
+      it('should upload a range of a file between written chunks', async () => {
+        const head = Buffer.from('head');
+        const tail = Buffer.from('tail');
+        const offset = kOneMegaByte + 3;
+        const length = 2 * kOneMegaByte;
+        const expected = Buffer.concat([head, fileContents.subarray(offset, offset + length), tail]);
+        const serverUrl = await respondOnce.toSingleURL(async (request, response) => {
+          const received = await collectStreamBodyBuffer(request);
+          expect(received.equals(expected)).to.be.true();
+          response.end();
+        });
+        const urlRequest = net.request({ method: 'POST', url: serverUrl });
+        urlRequest.write(head);
+        urlRequest.writeFile(filePath, { offset, length });
+        urlRequest.write(tail);
+        const response = await getResponse(urlRequest);
+        expect(response.statusCode).to.equal(200);
+      });
+
+      it('should not allow file uploads with chunked encoding', () => {
+        const urlRequest = net.request({ method: 'POST', url: 'http://127.0.0.1' });
+        urlRequest.chunkedEncoding = true;
+        expect(() => urlRequest.writeFile(filePath)).to.throw(/chunkedEncoding/);
+        urlRequest.abort();
+      });
+
+      it('should fail the request when the file does not exist', async () => {
+        const serverUrl = await respondOnce.toSingleURL((request, response) => {
+          response.end();
+        });
+        const urlRequest = net.request({ method: 'POST', url: serverUrl });
+        urlRequest.writeFile(path.join(tmpDir, 'does-not-exist'));
+        await expect(getResponse(urlRequest)).to.eventually.be.rejectedWith(/ERR_FILE_NOT_FOUND|ERR_ACCESS_DENIED/);
+      });
+    });
+
+    it('should post the bytes as they were when written', async () => {
+      const chunk = Buffer.from('first chunk');
+      const sent = Buffer.concat([chunk, chunk]);
+      const serverUrl = await respondOnce.toSingleURL(async (request, response) => {
+        const received = await collectStreamBodyBuffer(request);
+        expect(received.equals(sent)).to.be.true();
+        response.end();
+      });
+      const urlRequest = net.request({
+        method: 'POST',
+        url: serverUrl
+      });
+      // Reusing a buffer once its write callback has run is allowed.
+      await new Promise<void>(resolve => urlRequest.write(chunk, undefined, () => resolve()));
+      urlRequest.write(chunk);
+      chunk.fill(0);
+      const response = await getResponse(urlRequest);
+      expect(response.statusCode).to.equal(200);
+    });
+
     it('should support chunked encoding', async () => {
       const serverUrl = await respondOnce.toSingleURL((request, response) => {
         response.statusCode = 200;
@@ -1746,6 +1853,100 @@ describe('net module', () => {
       await collectStreamBody(response);
     });
 
+    it('should post a large body written in many small chunks', async () => {
+      const chunkSize = 16;
+      const sent = randomBuffer(4 * kOneMegaByte);
+      const serverUrl = await respondOnce.toSingleURL(async (request, response) => {
+        const received = await collectStreamBodyBuffer(request);
+        expect(received.equals(sent)).to.be.true();
+        response.end();
+      });
+      const urlRequest = net.request({ method: 'POST', url: serverUrl });
+      for (let offset = 0; offset < sent.length; offset += chunkSize) {
+        urlRequest.write(sent.subarray(offset, offset + chunkSize));
+      }
+      const response = await getResponse(urlRequest);
+      expect(response.statusCode).to.equal(200);
+    });
+
+    it('should allow reusing a chunk buffer once its write callback has run', async () => {
+      const chunkSize = 16 * kOneKiloByte;
+      const chunkCount = 64;
+      const serverUrl = await respondOnce.toSingleURL(async (request, response) => {
+        const received = await collectStreamBodyBuffer(request);
+        expect(received.length).to.equal(chunkSize * chunkCount);
+        for (let i = 0; i < chunkCount; i++) {
+          const chunk = received.subarray(i * chunkSize, (i + 1) * chunkSize);
+          expect(chunk.every(byte => byte === i)).to.be.true(`chunk ${i} was corrupted`);
+        }
+        response.end();
+      });
+      const urlRequest = net.request({ method: 'POST', url: serverUrl });
+      urlRequest.chunkedEncoding = true;
+      const responsePromise = new Promise<Electron.IncomingMessage>((resolve, reject) => {
+        urlRequest.on('response', resolve);
+        urlRequest.on('error', reject);
+      });
+      // A single buffer is refilled for every chunk as soon as the previous
+      // write has called back.
+      const buffer = Buffer.alloc(chunkSize);
+      for (let i = 0; i < chunkCount; i++) {
+        buffer.fill(i);
+        await new Promise<void>(resolve => urlRequest.write(buffer, undefined, () => resolve()));
+      }
+      urlRequest.end();
+      const response = await responsePromise;
+      expect(response.statusCode).to.equal(200);
+    });
+
+    it('should only emit drain once the native side consumes chunked uploads', async () => {
+      const chunk = randomBuffer(4 * kOneKiloByte);
+      let bytesWritten = 0;
+      let startReading = () => {};
+      const readingAllowed = new Promise<void>(resolve => { startReading = resolve; });
+      const serverUrl = await respondOnce.toSingleURL(async (request, response) => {
+        expect(request.headers['transfer-encoding']).to.equal('chunked');
+        await readingAllowed;
+        const received = await collectStreamBodyBuffer(request);
+        expect(received.length).to.equal(bytesWritten);
+        response.end();
+      });
+      const urlRequest = net.request({ method: 'POST', url: serverUrl });
+      urlRequest.chunkedEncoding = true;
+      const responsePromise = new Promise<Electron.IncomingMessage>((resolve, reject) => {
+        urlRequest.on('response', resolve);
+        urlRequest.on('error', reject);
+      });
+      // With chunks below the highWaterMark, write() only returns false once
+      // the data pipe stops taking them.
+      expect(chunk.length).to.be.below(urlRequest.writableHighWaterMark);
+      const write = (callback?: () => void) => {
+        bytesWritten += chunk.length;
+        return urlRequest.write(chunk, undefined, callback);
+      };
+      // The first chunk starts the request.
+      await new Promise<void>(resolve => write(resolve));
+
+      // Fill the pipe until drain stops coming while the server is not reading.
+      let drain: Promise<any> | undefined;
+      while (!drain) {
+        expect(bytesWritten).to.be.below(256 * kOneMegaByte);
+        if (write()) {
+          await new Promise(setImmediate);
+          continue;
+        }
+        const drained = emittedOnce(urlRequest, 'drain');
+        const drainedInTime = await Promise.race([drained.then(() => true), delay(500).then(() => false)]);
+        if (!drainedInTime) drain = drained;
+      }
+
+      startReading();
+      await drain;
+      urlRequest.end();
+      const response = await responsePromise;
+      expect(response.statusCode).to.equal(200);
+    });
+
     it('should finish sending data when urlRequest is unreferenced for chunked encoding', async () => {
       const serverUrl = await respondOnce.toSingleURL(async (request, response) => {
         const received = await collectStreamBodyBuffer(request);
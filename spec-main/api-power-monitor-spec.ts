@@ -173,6 +173,30 @@ describe('powerMonitor', () => {
       });
     });
 
+    describe('powerMonitor.setIdleThreshold', () => {
+      afterEach(() => {
+        powerMonitor.removeAllListeners('idle-state-changed');
+        powerMonitor.setIdleThreshold(60);
+      });
+
+      it('sets the threshold used for idle-state-changed', () => {
+        expect(powerMonitor.getIdleThreshold()).to.equal(60);
+        powerMonitor.on('idle-state-changed', () => {});
+        powerMonitor.setIdleThreshold(120);
+        expect(powerMonitor.getIdleThreshold()).to.equal(120);
+      });
+
+      it('does not accept non positive integer threshold', () => {
+        expect(() => {
+          powerMonitor.setIdleThreshold(0);
+        }).to.throw(/must be a positive integer/);
+
+        expect(() => {
+          powerMonitor.setIdleThreshold(1.5);
+        }).to.throw(/must be a positive integer/);
+      });
+    });
+
     describe('powerMonitor.onBatteryPower', () => {
       it('returns a boolean', () => {
         expect(powerMonitor.onBatteryPower).to.be.a('boolean');
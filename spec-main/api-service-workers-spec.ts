@@ -1,7 +1,7 @@
 import * as fs from 'fs';
 import * as http from 'http';
 import * as path from 'path';
-import { session, webContents, WebContents } from 'electron/main';
+import { session, webContents, WebContents, MessageChannelMain } from 'electron/main';
 import { expect } from 'chai';
 import { v4 } from 'uuid';
 import { AddressInfo } from 'net';
@@ -92,4 +92,85 @@ describe('session.serviceWorkers', () => {
       expect(messages['error log']).to.have.property('level', 3);
     });
   });
+
+  describe('with a custom protocol', () => {
+    const { serviceWorkerScheme } = global as any;
+    let origin: string;
+
+    beforeEach(async () => {
+      origin = `${serviceWorkerScheme}://${v4()}.com`;
+      ses.protocol.registerStringProtocol(serviceWorkerScheme, (request, cb) => {
+        const file = new URL(request.url).pathname.substr(1) || 'message.html';
+        cb({
+          mimeType: file.endsWith('.js') ? 'application/javascript' : 'text/html',
+          data: fs.readFileSync(path.resolve(__dirname, 'fixtures', 'api', 'service-workers', file), 'utf8')
+        });
+      });
+      await w.loadURL(`${origin}/message.html`);
+      await w.executeJavaScript('navigator.serviceWorker.ready.then(() => true)');
+    });
+
+    afterEach(() => {
+      ses.protocol.unregisterProtocol(serviceWorkerScheme);
+    });
+
+    describe('postMessage()', () => {
+      it('delivers a message and receives a reply over a MessagePortMain', async () => {
+        const { port1, port2 } = new MessageChannelMain();
+        port1.start();
+        const reply = emittedOnce(port1, 'message');
+        await ses.serviceWorkers.postMessage(`${origin}/`, 'ping', [port2]);
+        const [event] = await reply;
+        expect(event.data).to.deep.equal({ echo: 'ping' });
+      });
+
+      it('starts a stopped service worker to deliver the message', async () => {
+        await ses.serviceWorkers.stopAllRunning();
+        expect(ses.serviceWorkers.getAllRunning()).to.deep.equal({});
+        const { port1, port2 } = new MessageChannelMain();
+        port1.start();
+        const reply = emittedOnce(port1, 'message');
+        await ses.serviceWorkers.postMessage(`${origin}/`, 'wake', [port2]);
+        const [event] = await reply;
+        expect(event.data).to.deep.equal({ echo: 'wake' });
+      });
+
+      it('rejects for a scope without a service worker', async () => {
+        await expect(ses.serviceWorkers.postMessage(`${origin}/missing/`, 'ping')).to.eventually.be.rejected();
+      });
+
+      it('throws when the message cannot be serialized', () => {
+        expect(() => ses.serviceWorkers.postMessage(`${origin}/`, () => {})).to.throw(/An object could not be cloned/);
+      });
+    });
+
+    describe('startWorkerForScope()', () => {
+      it('starts the service worker for a scope', async () => {
+        await ses.serviceWorkers.stopAllRunning();
+        const versionId = await ses.serviceWorkers.startWorkerForScope(`${origin}/`);
+        const worker = ses.serviceWorkers.getFromVersionID(versionId);
+        expect(worker).to.have.property('scope', `${origin}/`);
+        expect(worker).to.have.property('scriptUrl', `${origin}/sw-message.js`);
+      });
+
+      it('rejects for a scope without a service worker', async () => {
+        await expect(ses.serviceWorkers.startWorkerForScope(`${origin}/missing/`)).to.eventually.be.rejectedWith(/Failed to start service worker/);
+      });
+    });
+
+    describe('stopRunningForOrigin()', () => {
+      it('stops the service workers of an origin', async () => {
+        const versionId = await ses.serviceWorkers.startWorkerForScope(`${origin}/`);
+        expect(ses.serviceWorkers.getAllRunning()).to.have.property(versionId.toString());
+        await ses.serviceWorkers.stopRunningForOrigin(origin);
+        expect(ses.serviceWorkers.getAllRunning()).to.not.have.property(versionId.toString());
+      });
+
+      it('resolves when no service worker of the origin is running', async () => {
+        await ses.serviceWorkers.stopAllRunning();
+        await ses.serviceWorkers.stopRunningForOrigin(origin);
+        expect(ses.serviceWorkers.getAllRunning()).to.deep.equal({});
+      });
+    });
+  });
 });
@@ -3,6 +3,7 @@ import * as http from 'http';
 import * as https from 'https';
 import * as path from 'path';
 import * as fs from 'fs';
+import * as os from 'os';
 import * as ChildProcess from 'child_process';
 import { app, session, BrowserWindow, net, ipcMain, Session } from 'electron/main';
 import * as send from 'send';
@@ -259,6 +260,160 @@ describe('session module', () => {
     });
   });
 
+  describe('ses.seedHttpCache(entries)', () => {
+    const content = '<html><body>seeded from the app</body></html>';
+    let server: http.Server;
+    let serverUrl: string;
+    let requestCount: number;
+    let bodyPath: string;
+    let scriptPath: string;
+    before(async () => {
+      bodyPath = path.join(os.tmpdir(), `electron-seed-http-cache-${process.pid}.html`);
+      fs.writeFileSync(bodyPath, content);
+      scriptPath = path.join(os.tmpdir(), `electron-seed-http-cache-${process.pid}.js`);
+      fs.writeFileSync(scriptPath, 'window.seeded = true');
+      // The server always fails, so a successful load must come from the cache.
+      // Only /page.html is served, it loads /seeded.js from 127.0.0.1.
+      server = http.createServer((req, res) => {
+        if (req.url === '/page.html') {
+          res.setHeader('Content-Type', 'text/html');
+          res.setHeader('Cache-Control', 'no-store');
+          res.end(`<script src="${serverUrl}/seeded.js"></script>`);
+          return;
+        }
+        requestCount++;
+        res.statusCode = 500;
+        res.end();
+      });
+      await new Promise<void>(resolve => server.listen(0, '127.0.0.1', resolve));
+      serverUrl = `http://127.0.0.1:${(server.address() as AddressInfo).port}`;
+    });
+    after(() => {
+      server.close();
+      fs.unlinkSync(bodyPath);
+      fs.unlinkSync(scriptPath);
+    });
+    beforeEach(() => {
+      requestCount = 0;
+    });
+    afterEach(closeAllWindows);
+
+    it('serves seeded entries from the cache', async () => {
+      const ses = session.fromPartition(`seed-http-cache-${Math.random()}`);
+      await ses.seedHttpCache([{
+        url: `${serverUrl}/seeded.html`,
+        path: bodyPath,
+        headers: {
+          'Content-Type': 'text/html',
+          'Cache-Control': 'max-age=3600'
+        }
+      }]);
+      const w = new BrowserWindow({ show: false, webPreferences: { session: ses } });
+      await w.loadURL(`${serverUrl}/seeded.html`);
+      const text = await w.webContents.executeJavaScript('document.body.textContent');
+      expect(text).to.equal('seeded from the app');
+      expect(requestCount).to.equal(0);
+      expect(await ses.getCacheSize()).to.be.greaterThan(0);
+    });
+
+    it('serves seeded subresources to pages of the top frame origin', async () => {
+      const ses = session.fromPartition(`seed-http-cache-${Math.random()}`);
+      const pageOrigin = serverUrl.replace('127.0.0.1', 'localhost');
+      await ses.seedHttpCache([{
+        url: `${serverUrl}/seeded.js`,
+        topFrameOrigin: pageOrigin,
+        path: scriptPath,
+        headers: {
+          'Content-Type': 'text/javascript',
+          'Cache-Control': 'max-age=3600'
+        }
+      }]);
+      const w = new BrowserWindow({ show: false, webPreferences: { session: ses } });
+      await w.loadURL(`${pageOrigin}/page.html`);
+      expect(await w.webContents.executeJavaScript('window.seeded')).to.equal(true);
+      expect(requestCount).to.equal(0);
+    });
+
+    it('does not serve seeded subresources to pages of other sites', async () => {
+      const ses = session.fromPartition(`seed-http-cache-${Math.random()}`);
+      await ses.seedHttpCache([{
+        url: `${serverUrl}/seeded.js`,
+        path: scriptPath,
+        headers: {
+          'Content-Type': 'text/javascript',
+          'Cache-Control': 'max-age=3600'
+        }
+      }]);
+      const w = new BrowserWindow({ show: false, webPreferences: { session: ses } });
+      await w.loadURL(`${serverUrl.replace('127.0.0.1', 'localhost')}/page.html`);
+      expect(await w.webContents.executeJavaScript('window.seeded')).to.equal(undefined);
+      expect(requestCount).to.equal(1);
+    });
+
+    it('serves seeded entries that vary on request headers', async () => {
+      const ses = session.fromPartition(`seed-http-cache-${Math.random()}`);
+      await ses.seedHttpCache([{
+        url: `${serverUrl}/vary.html`,
+        path: bodyPath,
+        headers: {
+          'Content-Type': 'text/html',
+          'Cache-Control': 'max-age=3600',
+          Vary: 'Accept-Encoding'
+        },
+        requestHeaders: { 'Accept-Encoding': 'gzip, deflate' }
+      }]);
+      const w = new BrowserWindow({ show: false, webPreferences: { session: ses } });
+      await w.loadURL(`${serverUrl}/vary.html`);
+      const text = await w.webContents.executeJavaScript('document.body.textContent');
+      expect(text).to.equal('seeded from the app');
+      expect(requestCount).to.equal(0);
+    });
+
+    it('revalidates stale entries with the server', async () => {
+      const ses = session.fromPartition(`seed-http-cache-${Math.random()}`);
+      await ses.seedHttpCache([{
+        url: `${serverUrl}/stale.html`,
+        path: bodyPath,
+        headers: { 'Content-Type': 'text/html', 'Cache-Control': 'no-cache' }
+      }]);
+      const w = new BrowserWindow({ show: false, webPreferences: { session: ses } });
+      await w.loadURL(`${serverUrl}/stale.html`).catch(() => {});
+      expect(requestCount).to.equal(1);
+    });
+
+    it('rejects when the body file does not exist', async () => {
+      const ses = session.fromPartition(`seed-http-cache-${Math.random()}`);
+      await expect(ses.seedHttpCache([{
+        url: `${serverUrl}/missing.html`,
+        path: path.join(os.tmpdir(), 'electron-seed-http-cache-missing.html')
+      }])).to.eventually.be.rejectedWith(/ERR_FILE_NOT_FOUND/);
+    });
+
+    it('does not accept uncacheable entries', () => {
+      const ses = session.defaultSession;
+      expect(() => ses.seedHttpCache([{ url: 'file:///index.html', path: bodyPath }])).to.throw(/http URL/);
+      expect(() => ses.seedHttpCache([{ url: 'https://127.0.0.1/a.html', path: bodyPath }])).to.throw(/http URL/);
+      expect(() => ses.seedHttpCache([{ url: `${serverUrl}/a.html`, path: 'a.html' }])).to.throw(/absolute/);
+      expect(() => ses.seedHttpCache([{ url: `${serverUrl}/a.html`, topFrameOrigin: 'not a url', path: bodyPath }])).to.throw(/topFrameOrigin/);
+      expect(() => ses.seedHttpCache([{
+        url: `${serverUrl}/a.html`,
+        path: bodyPath,
+        headers: { 'Cache-Control': 'no-store' }
+      }])).to.throw(/no-store/);
+      expect(() => ses.seedHttpCache([{
+        url: `${serverUrl}/a.html`,
+        path: bodyPath,
+        headers: { Vary: '*' }
+      }])).to.throw(/Vary/);
+      expect(() => ses.seedHttpCache([{
+        url: `${serverUrl}/a.html`,
+        path: bodyPath,
+        headers: { Vary: 'Accept-Encoding, Accept-Language' },
+        requestHeaders: { 'Accept-Encoding': 'gzip, deflate' }
+      }])).to.throw(/Accept-Language/);
+    });
+  });
+
   describe('will-download event', () => {
     afterEach(closeAllWindows);
     it('can cancel default download behavior', async () => {
@@ -1029,6 +1184,104 @@ describe('session module', () => {
     });
   });
 
+  describe('ses.setTrafficClasses(classes)', () => {
+    const body = Buffer.alloc(20000, 'a');
+    let server: http.Server;
+    let serverUrl: string;
+    let ses: Session;
+
+    before(async () => {
+      server = http.createServer((req, res) => {
+        res.setHeader('Content-Type', 'text/plain');
+        res.end(body);
+      });
+      await new Promise<void>(resolve => server.listen(0, '127.0.0.1', () => resolve()));
+      serverUrl = `http://127.0.0.1:${(server.address() as AddressInfo).port}`;
+    });
+
+    after(() => {
+      server.close();
+    });
+
+    beforeEach(() => {
+      ses = session.fromPartition(`traffic-classes-${Math.random()}`);
+    });
+
+    const fetch = (url: string, uploadData?: string) => new Promise<number>((resolve, reject) => {
+      const start = Date.now();
+      const request = net.request({ url, method: uploadData ? 'POST' : 'GET', session: ses });
+      request.on('response', (response) => {
+        response.on('data', () => {});
+        response.on('end', () => resolve(Date.now() - start));
+      });
+      request.on('error', reject);
+      request.end(uploadData);
+    });
+
+    it('counts requests and bytes per class', async () => {
+      ses.setTrafficClasses([
+        { name: 'sync', urls: ['*://127.0.0.1/sync/*'] },
+        { name: 'other' }
+      ]);
+      await fetch(`${serverUrl}/sync/a`, 'hello');
+      await fetch(`${serverUrl}/sync/b`);
+      await fetch(`${serverUrl}/ui`);
+
+      const stats = ses.getTrafficClassStats();
+      expect(stats.sync.requestCount).to.equal(2);
+      expect(stats.sync.bytesReceived).to.be.at.least(2 * body.length);
+      expect(stats.sync.bytesSent).to.equal('hello'.length);
+      expect(stats.other.requestCount).to.equal(1);
+      expect(stats.other.bytesReceived).to.be.at.least(body.length);
+    });
+
+    it('counts every byte of large uploads', async () => {
+      ses.setTrafficClasses([{ name: 'upload' }]);
+      const upload = 'a'.repeat(4 * 1024 * 1024);
+      await fetch(`${serverUrl}/upload`, upload);
+      expect(ses.getTrafficClassStats().upload.bytesSent).to.equal(upload.length);
+    });
+
+    it('does not count requests that webRequest cancels', async () => {
+      ses.setTrafficClasses([{ name: 'all' }]);
+      ses.webRequest.onBeforeRequest((details, callback) => {
+        callback({ cancel: details.url.endsWith('/blocked') });
+      });
+      await expect(fetch(`${serverUrl}/blocked`, 'hello')).to.eventually.be.rejectedWith('net::ERR_BLOCKED_BY_CLIENT');
+      await fetch(`${serverUrl}/allowed`);
+      const stats = ses.getTrafficClassStats();
+      expect(stats.all.requestCount).to.equal(1);
+      expect(stats.all.bytesSent).to.equal(0);
+    });
+
+    it('throttles only the matching class', async () => {
+      ses.setTrafficClasses([
+        { name: 'sync', urls: ['*://127.0.0.1/sync/*'], priority: 'lowest', downloadThroughput: 10000 }
+      ]);
+      const [syncTime, uiTime] = await Promise.all([
+        fetch(`${serverUrl}/sync/a`),
+        fetch(`${serverUrl}/ui`)
+      ]);
+      expect(syncTime).to.be.at.least(1000);
+      expect(uiTime).to.be.below(syncTime);
+    });
+
+    it('resets the counters when the classes are replaced', async () => {
+      ses.setTrafficClasses([{ name: 'all' }]);
+      await fetch(`${serverUrl}/ui`);
+      ses.setTrafficClasses([{ name: 'all' }]);
+      expect(ses.getTrafficClassStats()).to.deep.equal({
+        all: { requestCount: 0, bytesSent: 0, bytesReceived: 0 }
+      });
+    });
+
+    it('throws for invalid classes', () => {
+      expect(() => ses.setTrafficClasses([{ name: '' }])).to.throw(/must have a name/);
+      expect(() => ses.setTrafficClasses([{ name: 'a', urls: ['not a pattern'] }])).to.throw(/Invalid url pattern/);
+      expect(() => ses.setTrafficClasses([{ name: 'a', priority: 'urgent' as any }])).to.throw(/Invalid priority/);
+    });
+  });
+
   describe('ses.isPersistent()', () => {
     afterEach(closeAllWindows);
 
@@ -157,6 +157,50 @@ describe('tray module', () => {
     });
   });
 
+  describe('tray.setAnimatedImage(images)', () => {
+    const assetsPath = path.resolve(__dirname, '..', 'spec', 'fixtures', 'assets');
+    const frames = ['1x1.png', '3x3.png', 'logo.png'].map(name => nativeImage.createFromPath(path.join(assetsPath, name)));
+
+    it('animates until stopped', () => {
+      expect(tray.isAnimating()).to.be.false('animating');
+      tray.setAnimatedImage(frames, { interval: 20 });
+      expect(tray.isAnimating()).to.be.true('not animating');
+      tray.stopAnimation();
+      expect(tray.isAnimating()).to.be.false('animating');
+    });
+
+    it('is stopped by setImage', () => {
+      tray.setAnimatedImage(frames);
+      tray.setImage(nativeImage.createEmpty());
+      expect(tray.isAnimating()).to.be.false('animating');
+    });
+
+    it('does not animate a single frame', () => {
+      tray.setAnimatedImage([frames[0]]);
+      expect(tray.isAnimating()).to.be.false('animating');
+    });
+
+    it('throws for invalid arguments', () => {
+      expect(() => {
+        tray.setAnimatedImage([]);
+      }).to.throw(/images must not be empty/);
+      expect(() => {
+        tray.setAnimatedImage(frames, { interval: 1 });
+      }).to.throw(/interval must be at least 16 milliseconds/);
+      const badPath = path.resolve('I', 'Do', 'Not', 'Exist');
+      expect(() => {
+        tray.setAnimatedImage([badPath]);
+      }).to.throw(/Failed to load image from path (.+)/);
+    });
+
+    it('can switch badge counts while animating', () => {
+      tray.setAnimatedImage(frames, { interval: 20 });
+      expect(() => {
+        for (const count of [1, 2, 100, 1, 0]) tray.setBadgeCount(count);
+      }).to.not.throw();
+    });
+  });
+
   ifdescribe(process.platform === 'win32')('tray.displayBalloon(image)', () => {
     it('throws a descriptive error for a missing file', () => {
       const badPath = path.resolve('I', 'Do', 'Not', 'Exist');
@@ -751,6 +751,185 @@ describe('webContents module', () => {
     });
   });
 
+  ifdescribe(features.isOffscreenRenderingEnabled())('sendInputEvents(events)', () => {
+    let w: BrowserWindow;
+    beforeEach(async () => {
+      w = new BrowserWindow({
+        show: false,
+        width: 100,
+        height: 100,
+        webPreferences: { offscreen: true, backgroundThrottling: false }
+      });
+      await w.loadFile(path.join(fixturesPath, 'pages', 'input-events-counter.html'));
+    });
+    afterEach(closeAllWindows);
+
+    const waitForCount = async (name: string, count: number, timeout = 5000) => {
+      const deadline = Date.now() + timeout;
+      let current = 0;
+      while ((current = await w.webContents.executeJavaScript(`counts.${name}`)) < count) {
+        if (Date.now() > deadline) {
+          throw new Error(`Expected ${count} ${name} events but only got ${current}`);
+        }
+        await delay(10);
+      }
+    };
+
+    it('sends every event of the batch in order', async () => {
+      const sent = w.webContents.sendInputEvents([
+        { type: 'keyDown', keyCode: 'A' },
+        { type: 'keyDown', keyCode: 'B' },
+        { type: 'keyDown', keyCode: 'C' }
+      ]);
+      expect(sent).to.equal(3);
+      await waitForCount('keydown', 3);
+    });
+
+    it('coalesces consecutive mouse moves', async () => {
+      const moves = [];
+      for (let i = 1; i <= 10; i++) {
+        moves.push({ type: 'mouseMove', x: i * 5, y: i * 4 } as const);
+      }
+      expect(w.webContents.sendInputEvents(moves)).to.equal(1);
+      await waitForCount('mousemove', 1);
+      const lastMove = await w.webContents.executeJavaScript('lastMove');
+      expect(lastMove).to.deep.equal({ x: 50, y: 40 });
+    });
+
+    it('coalesces consecutive wheel events', async () => {
+      const wheels = [];
+      for (let i = 0; i < 5; i++) {
+        wheels.push({ type: 'mouseWheel', x: 10, y: 10, deltaY: -10 } as const);
+      }
+      expect(w.webContents.sendInputEvents(wheels)).to.equal(1);
+      await waitForCount('wheel', 1);
+    });
+
+    it('does not coalesce events separated by other events', () => {
+      const sent = w.webContents.sendInputEvents([
+        { type: 'mouseMove', x: 10, y: 10 },
+        { type: 'mouseMove', x: 20, y: 20 },
+        { type: 'keyDown', keyCode: 'A' },
+        { type: 'mouseMove', x: 30, y: 30 }
+      ]);
+      expect(sent).to.equal(3);
+    });
+
+    it('sends every event when coalescing is disabled', async () => {
+      const moves = [];
+      for (let i = 1; i <= 10; i++) {
+        moves.push({ type: 'mouseMove', x: i * 5, y: i * 4 } as const);
+      }
+      expect(w.webContents.sendInputEvents(moves, { coalesce: false })).to.equal(10);
+      await waitForCount('forwardedmove', 10);
+    });
+
+    it('keeps the spacing between event timestamps', async () => {
+      w.webContents.sendInputEvents([
+        { type: 'keyDown', keyCode: 'A', timestamp: 1000 },
+        { type: 'keyDown', keyCode: 'B', timestamp: 1500 }
+      ]);
+      await waitForCount('keydown', 2);
+      const [first, second] = await w.webContents.executeJavaScript('keyTimeStamps');
+      expect(second - first).to.be.closeTo(500, 1);
+    });
+
+    it('throws and sends nothing if an event is invalid', async () => {
+      expect(() => {
+        w.webContents.sendInputEvents([
+          { type: 'keyDown', keyCode: 'A' },
+          { type: 'invalid' } as any
+        ]);
+      }).to.throw('Invalid event object at index 1');
+      w.webContents.sendInputEvent({ type: 'keyDown', keyCode: 'B' });
+      await waitForCount('keydown', 1);
+      expect(await w.webContents.executeJavaScript('counts.keydown')).to.equal(1);
+    });
+  });
+
+  ifdescribe(features.isOffscreenRenderingEnabled())('startRecording(path)', () => {
+    let w: BrowserWindow;
+    let recordingPath: string;
+    beforeEach(async () => {
+      w = new BrowserWindow({
+        show: false,
+        width: 100,
+        height: 100,
+        webPreferences: { offscreen: true, backgroundThrottling: false }
+      });
+      recordingPath = path.join(app.getPath('temp'), `electron-recording-${Date.now()}.webm`);
+      // The capturer only delivers frames when the page repaints.
+      await w.loadFile(path.join(fixturesPath, 'pages', 'animation.html'));
+    });
+    afterEach(async () => {
+      await closeAllWindows();
+      if (fs.existsSync(recordingPath)) fs.unlinkSync(recordingPath);
+    });
+
+    it('records the page into a WebM file', async () => {
+      await w.webContents.startRecording(recordingPath);
+      expect(w.webContents.isRecording()).to.be.true('isRecording');
+      await delay(500);
+      const stats = await w.webContents.stopRecording();
+      expect(w.webContents.isRecording()).to.be.false('isRecording');
+
+      expect(stats.framesEncoded).to.be.greaterThan(0);
+      expect(stats.framesCaptured).to.equal(stats.framesEncoded + stats.framesDropped);
+
+      // Every WebM file starts with the EBML magic number.
+      const data = fs.readFileSync(recordingPath);
+      expect(data.readUInt32BE(0)).to.equal(0x1A45DFA3);
+      expect(data.includes('webm')).to.be.true('has webm doctype');
+    });
+
+    it('supports the vp9 codec', async () => {
+      await w.webContents.startRecording(recordingPath, { codec: 'vp9', frameRate: 10 });
+      await delay(300);
+      const stats = await w.webContents.stopRecording();
+      expect(stats.framesEncoded).to.be.greaterThan(0);
+      expect(fs.statSync(recordingPath).size).to.be.greaterThan(0);
+    });
+
+    it('does not capture frames while paused', async () => {
+      await w.webContents.startRecording(recordingPath);
+      await delay(200);
+      w.webContents.pauseRecording();
+      await delay(100);
+      const stats = await w.webContents.stopRecording();
+      const captured = stats.framesCaptured;
+      expect(captured).to.be.greaterThan(0);
+      // A recording that was paused right away captures (almost) nothing.
+      await w.webContents.startRecording(recordingPath);
+      w.webContents.pauseRecording();
+      await delay(300);
+      w.webContents.resumeRecording();
+      const pausedStats = await w.webContents.stopRecording();
+      expect(pausedStats.framesCaptured).to.be.lessThan(captured);
+    });
+
+    it('rejects when a recording is already in progress', async () => {
+      await w.webContents.startRecording(recordingPath);
+      await expect(w.webContents.startRecording(recordingPath)).to.eventually.be.rejectedWith('A recording is already in progress');
+      await w.webContents.stopRecording();
+    });
+
+    it('rejects invalid options', async () => {
+      await expect(w.webContents.startRecording(recordingPath, { codec: 'h264' as any })).to.eventually.be.rejectedWith('Unsupported codec: h264');
+      await expect(w.webContents.startRecording(recordingPath, { frameRate: 0 })).to.eventually.be.rejectedWith('frameRate must be between 1 and 60');
+      expect(w.webContents.isRecording()).to.be.false('isRecording');
+    });
+
+    it('rejects stopRecording() without a recording', async () => {
+      await expect(w.webContents.stopRecording()).to.eventually.be.rejectedWith('No recording is in progress');
+    });
+
+    it('rejects when the file can not be opened', async () => {
+      const badPath = path.join(recordingPath, 'does-not-exist', 'out.webm');
+      await expect(w.webContents.startRecording(badPath)).to.eventually.be.rejectedWith(/Failed to open file/);
+      expect(w.webContents.isRecording()).to.be.false('isRecording');
+    });
+  });
+
   describe('insertCSS', () => {
     afterEach(closeAllWindows);
     it('supports inserting CSS', async () => {
@@ -1294,6 +1473,27 @@ describe('webContents module', () => {
     });
   });
 
+  describe('setDirectoryEnumerationOptions(options)', () => {
+    afterEach(closeAllWindows);
+    it('accepts valid options', () => {
+      const w = new BrowserWindow({ show: false });
+      expect(() => {
+        w.webContents.setDirectoryEnumerationOptions({ maxFiles: 100, ignore: ['node_modules', '*.log'] });
+        w.webContents.setDirectoryEnumerationOptions({});
+      }).to.not.throw();
+    });
+
+    it('rejects invalid options', () => {
+      const w = new BrowserWindow({ show: false });
+      expect(() => {
+        w.webContents.setDirectoryEnumerationOptions({ maxFiles: -1 });
+      }).to.throw(/maxFiles must be a non-negative integer/);
+      expect(() => {
+        w.webContents.setDirectoryEnumerationOptions({ ignore: 'node_modules' as any });
+      }).to.throw(/ignore must be an array of strings/);
+    });
+  });
+
   const crashPrefs = [
     {
       nodeIntegration: true
@@ -2034,6 +2234,81 @@ describe('webContents module', () => {
     });
   });
 
+  describe('near-heap-limit event', () => {
+    afterEach(closeAllWindows);
+
+    const createLeakingWindow = async () => {
+      const w = new BrowserWindow({ show: false, webPreferences: { maxOldSpaceSize: 128 } });
+      await w.loadFile(path.join(fixturesPath, 'pages', 'leak.html'));
+      return w;
+    };
+
+    it('is emitted with the heap limits', async () => {
+      const w = await createLeakingWindow();
+      const nearHeapLimit = emittedOnce(w.webContents, 'near-heap-limit');
+      w.webContents.executeJavaScript('leak()');
+      const [, details] = await nearHeapLimit;
+      await w.webContents.executeJavaScript('stopLeak()');
+      expect(details.heapLimit).to.be.at.most(128 * 1024);
+      expect(details.raisedHeapLimit).to.be.greaterThan(details.heapLimit);
+    });
+
+    it('does not terminate the renderer', async () => {
+      const w = await createLeakingWindow();
+      let processGone = false;
+      w.webContents.on('render-process-gone', () => { processGone = true; });
+      const nearHeapLimit = emittedOnce(w.webContents, 'near-heap-limit');
+      w.webContents.executeJavaScript('leak()');
+      await nearHeapLimit;
+      await w.webContents.executeJavaScript('stopLeak()');
+      await delay(500);
+      expect(processGone).to.be.false();
+      expect(await w.webContents.executeJavaScript('leaked.length')).to.equal(0);
+    });
+
+    it('lets the page be reloaded', async () => {
+      const w = await createLeakingWindow();
+      w.webContents.once('near-heap-limit', () => {
+        w.webContents.reload();
+      });
+      w.webContents.executeJavaScript('leak()');
+      await emittedOnce(w.webContents, 'did-finish-load');
+      expect(await w.webContents.executeJavaScript('leaked.length')).to.equal(0);
+    });
+
+    it('is only emitted on the WebContents that set maxOldSpaceSize', async () => {
+      // The child window shares the renderer process of the page, and a
+      // maxOldSpaceSize of 0 does not set a limit.
+      const w = new BrowserWindow({ show: false, webPreferences: { maxOldSpaceSize: 128, nativeWindowOpen: true } });
+      await w.loadFile(path.join(fixturesPath, 'pages', 'leak.html'));
+      w.webContents.setWindowOpenHandler(() => ({
+        action: 'allow',
+        overrideBrowserWindowOptions: { show: false, webPreferences: { maxOldSpaceSize: 0 } }
+      }));
+      const childCreated = emittedOnce(app, 'browser-window-created');
+      w.webContents.executeJavaScript('window.open("about:blank") && null');
+      const [, child] = await childCreated;
+      let emittedOnChild = false;
+      child.webContents.on('near-heap-limit', () => { emittedOnChild = true; });
+      const nearHeapLimit = emittedOnce(w.webContents, 'near-heap-limit');
+      w.webContents.executeJavaScript('leak()');
+      await nearHeapLimit;
+      await w.webContents.executeJavaScript('stopLeak()');
+      expect(emittedOnChild).to.be.false();
+    });
+
+    it('is not emitted without maxOldSpaceSize', async () => {
+      const w = new BrowserWindow({ show: false });
+      await w.loadFile(path.join(fixturesPath, 'pages', 'leak.html'));
+      let emitted = false;
+      w.webContents.on('near-heap-limit', () => { emitted = true; });
+      await w.webContents.executeJavaScript('leak()');
+      await delay(500);
+      await w.webContents.executeJavaScript('stopLeak()');
+      expect(emitted).to.be.false();
+    });
+  });
+
   it('emits a cancelable event before creating a child webcontents', async () => {
     const w = new BrowserWindow({
       show: false,
@@ -2,7 +2,7 @@ import { expect } from 'chai';
 import * as http from 'http';
 import * as path from 'path';
 import * as url from 'url';
-import { BrowserWindow, WebFrameMain, webFrameMain, ipcMain } from 'electron/main';
+import { BrowserWindow, WebFrameMain, webFrameMain, ipcMain, session } from 'electron/main';
 import { closeAllWindows } from './window-helpers';
 import { emittedOnce, emittedNTimes } from './events-helpers';
 import { AddressInfo } from 'net';
@@ -179,6 +179,190 @@ describe('webFrameMain module', () => {
     });
   });
 
+  describe('webFrameMain.broadcast', () => {
+    const createWindow = (partition?: string) => new BrowserWindow({
+      show: false,
+      webPreferences: {
+        partition,
+        preload: path.join(subframesPath, 'preload.js'),
+        nodeIntegrationInSubFrames: true
+      }
+    });
+
+    it('sends a message to every target', async () => {
+      const windows = [createWindow(), createWindow(), createWindow()];
+      await Promise.all(windows.map(w => w.loadURL('about:blank')));
+      const pongs = emittedNTimes(ipcMain, 'preload-pong', windows.length);
+      const count = webFrameMain.broadcast(windows.map(w => w.webContents), 'preload-ping');
+      expect(count).to.equal(windows.length);
+      const senders = (await pongs).map(([event]) => event.sender);
+      expect(senders).to.have.members(windows.map(w => w.webContents));
+    });
+
+    it('sends a message once to a frame listed twice', async () => {
+      const w = createWindow();
+      await w.loadURL('about:blank');
+      const count = webFrameMain.broadcast([w.webContents.mainFrame, w.webContents.mainFrame], 'preload-ping');
+      expect(count).to.equal(1);
+    });
+
+    it('sends a message to every frame in a session', async () => {
+      const partition = 'broadcast-session';
+      const w = createWindow(partition);
+      const other = createWindow();
+      await Promise.all([
+        w.loadFile(path.join(subframesPath, 'frame-with-frame-container.html')),
+        other.loadURL('about:blank')
+      ]);
+      const pongs = emittedNTimes(ipcMain, 'preload-pong', 3);
+      const count = webFrameMain.broadcast(session.fromPartition(partition), 'preload-ping');
+      expect(count).to.equal(3);
+      const routingIds = (await pongs).map(([, routingId]) => routingId);
+      expect(routingIds).to.have.members(w.webContents.mainFrame.framesInSubtree.map(frame => frame.routingId));
+    });
+
+    it('throws when the arguments can not be serialized', async () => {
+      const w = createWindow();
+      await w.loadURL('about:blank');
+      expect(() => webFrameMain.broadcast([w.webContents], 'preload-ping', () => {})).to.throw(/Failed to serialize arguments/);
+    });
+
+    it('accepts a mix of WebContents and WebFrameMain targets', async () => {
+      const windows = [createWindow(), createWindow()];
+      await Promise.all(windows.map(w => w.loadURL('about:blank')));
+      const pongs = emittedNTimes(ipcMain, 'preload-pong', windows.length);
+      const count = webFrameMain.broadcast([windows[0].webContents, windows[1].webContents.mainFrame, windows[0].webContents.mainFrame], 'preload-ping');
+      expect(count).to.equal(windows.length);
+      const senders = (await pongs).map(([event]) => event.sender);
+      expect(senders).to.have.members(windows.map(w => w.webContents));
+    });
+
+    it('throws without sending anything when a frame was disposed', async () => {
+      const w = createWindow();
+      const disposed = createWindow();
+      await Promise.all([w.loadURL('about:blank'), disposed.loadURL('about:blank')]);
+      const disposedFrame = disposed.webContents.mainFrame;
+      disposed.destroy();
+      await new Promise(resolve => setTimeout(resolve, 0));
+      let received = false;
+      ipcMain.once('preload-pong', () => { received = true; });
+      expect(() => webFrameMain.broadcast([w.webContents.mainFrame, disposedFrame], 'preload-ping')).to.throw(/Render frame was disposed/);
+      await new Promise(resolve => setTimeout(resolve, 100));
+      expect(received).to.be.false();
+      ipcMain.removeAllListeners('preload-pong');
+    });
+
+    it('is faster than a loop of send calls across offscreen windows', async function () {
+      this.timeout(60000);
+      const windowCount = 20;
+      const rounds = 10;
+      const windows = Array.from({ length: windowCount }, () => new BrowserWindow({
+        show: false,
+        webPreferences: {
+          offscreen: true,
+          preload: path.join(subframesPath, 'preload.js')
+        }
+      }));
+      await Promise.all(windows.map(w => w.loadURL('about:blank')));
+      const frames = windows.map(w => w.webContents.mainFrame);
+      // Large enough that serializing it dominates the cost of a send.
+      const state = { items: Array.from({ length: 10000 }, (_, i) => ({ id: i, name: `item ${i}` })) };
+
+      const measure = async (send: () => void) => {
+        const pongs = emittedNTimes(ipcMain, 'preload-pong', windowCount * rounds);
+        const start = process.hrtime.bigint();
+        for (let i = 0; i < rounds; i++) send();
+        const elapsed = Number(process.hrtime.bigint() - start) / 1e6;
+        await pongs;
+        return elapsed;
+      };
+      const loopMs = await measure(() => frames.forEach(frame => frame.send('preload-ping', state)));
+      const broadcastMs = await measure(() => webFrameMain.broadcast(frames, 'preload-ping', state));
+      console.log(`    send loop: ${loopMs.toFixed(1)}ms, broadcast: ${broadcastMs.toFixed(1)}ms ` +
+                  `(${windowCount} windows, ${rounds} rounds)`);
+      expect(broadcastMs).to.be.below(loopMs);
+    });
+  });
+
+  describe('WebFrame.getFrameTreeSnapshot', () => {
+    it('describes every frame in the subtree', async () => {
+      const w = new BrowserWindow({ show: false, webPreferences: { contextIsolation: true } });
+      await w.loadFile(path.join(subframesPath, 'frame-with-frame-container.html'));
+      const webFrame = w.webContents.mainFrame;
+      const snapshot = webFrame.getFrameTreeSnapshot();
+
+      expect(snapshot.map(entry => entry.url)).to.deep.equal(webFrame.framesInSubtree.map(frame => frame.url));
+      const [root, child, grandchild] = snapshot;
+      expect(root.parentFrameTreeNodeId).to.be.null();
+      expect(root.frameTreeNodeId).to.equal(webFrame.frameTreeNodeId);
+      expect(root.processId).to.equal(webFrame.processId);
+      expect(root.routingId).to.equal(webFrame.routingId);
+      expect(child.parentFrameTreeNodeId).to.equal(root.frameTreeNodeId);
+      expect(grandchild.parentFrameTreeNodeId).to.equal(child.frameTreeNodeId);
+      expect(grandchild.origin).to.be.a('string');
+    });
+
+    it('only describes the subtree of a subframe', async () => {
+      const w = new BrowserWindow({ show: false, webPreferences: { contextIsolation: true } });
+      await w.loadFile(path.join(subframesPath, 'frame-with-frame-container.html'));
+      const snapshot = w.webContents.mainFrame.frames[0].getFrameTreeSnapshot();
+      expect(snapshot.map(entry => entry.url)).to.deep.equal([fileUrl('frame-with-frame.html'), fileUrl('frame.html')]);
+    });
+  });
+
+  describe('"frame-tree-changed" event', () => {
+    it('reports existing frames as added', async () => {
+      const w = new BrowserWindow({ show: false, webPreferences: { contextIsolation: true } });
+      await w.loadFile(path.join(subframesPath, 'frame-with-frame-container.html'));
+      const [, details] = await emittedOnce(w.webContents, 'frame-tree-changed');
+      expect(details.added).to.have.lengthOf(3);
+      expect(details.changed).to.be.empty();
+      expect(details.removed).to.be.empty();
+    });
+
+    it('reports removed frames', async () => {
+      const w = new BrowserWindow({ show: false, webPreferences: { contextIsolation: true } });
+      await w.loadFile(path.join(subframesPath, 'frame-with-frame-container.html'));
+      const [childId, grandchildId] = w.webContents.mainFrame.framesInSubtree.slice(1).map(frame => frame.frameTreeNodeId);
+      // Keep the observer alive between the one-off listeners below.
+      w.webContents.on('frame-tree-changed', () => {});
+      await emittedOnce(w.webContents, 'frame-tree-changed');
+
+      const changed = emittedOnce(w.webContents, 'frame-tree-changed');
+      await w.webContents.executeJavaScript('document.querySelector("iframe").remove()');
+      const [, details] = await changed;
+      expect(details.added).to.be.empty();
+      expect(details.removed).to.have.members([childId, grandchildId]);
+    });
+
+    it('reports navigated frames as changed', async () => {
+      const w = new BrowserWindow({ show: false, webPreferences: { contextIsolation: true } });
+      await w.loadFile(path.join(subframesPath, 'frame-container.html'));
+      w.webContents.on('frame-tree-changed', () => {});
+      await emittedOnce(w.webContents, 'frame-tree-changed');
+      const childId = w.webContents.mainFrame.frames[0].frameTreeNodeId;
+      const navigatedUrl = `${fileUrl('frame.html')}?navigated`;
+
+      const changed = emittedOnce(w.webContents, 'frame-tree-changed');
+      await w.webContents.executeJavaScript(`document.querySelector('iframe').src = ${JSON.stringify(navigatedUrl)}`);
+      const [, details] = await changed;
+      expect(details.changed).to.have.lengthOf(1);
+      expect(details.changed[0].frameTreeNodeId).to.equal(childId);
+      expect(details.changed[0].url).to.equal(navigatedUrl);
+    });
+
+    it('starts over after the last listener is removed', async () => {
+      const w = new BrowserWindow({ show: false, webPreferences: { contextIsolation: true } });
+      await w.loadFile(path.join(subframesPath, 'frame-with-frame-container.html'));
+      await emittedOnce(w.webContents, 'frame-tree-changed');
+      expect(w.webContents.listenerCount('frame-tree-changed')).to.equal(0);
+
+      // A new observer reports the whole tree again.
+      const [, details] = await emittedOnce(w.webContents, 'frame-tree-changed');
+      expect(details.added).to.have.lengthOf(3);
+    });
+  });
+
   describe('disposed WebFrames', () => {
     let w: BrowserWindow;
     let webFrame: WebFrameMain;
@@ -1,4 +1,7 @@
 import { expect } from 'chai';
+import * as crypto from 'crypto';
+import * as fs from 'fs';
+import * as os from 'os';
 import * as path from 'path';
 import { BrowserWindow, ipcMain } from 'electron/main';
 import { closeAllWindows } from './window-helpers';
@@ -79,4 +82,121 @@ describe('asar package', () => {
       }
     });
   });
+
+  describe('integrity', () => {
+    const blockSize = 1024;
+    let tmpDir: string;
+    let archiveCount = 0;
+
+    const sha256 = (data: Buffer) => crypto.createHash('sha256').update(data).digest('hex');
+
+    // Writes an archive where each file carries a block integrity computed
+    // from |files|, with |contents| overriding the bytes actually stored.
+    const createArchive = (files: Record<string, Buffer>, contents: Record<string, Buffer> = {}, fileBlockSize = blockSize) => {
+      const header: any = { files: {} };
+      let offset = 0;
+      for (const [name, data] of Object.entries(files)) {
+        const blocks = [];
+        for (let i = 0; i < data.length; i += fileBlockSize) {
+          blocks.push(sha256(data.subarray(i, i + fileBlockSize)));
+        }
+        header.files[name] = {
+          size: data.length,
+          offset: String(offset),
+          integrity: { algorithm: 'SHA256', hash: sha256(data), blockSize: fileBlockSize, blocks }
+        };
+        offset += data.length;
+      }
+      const json = Buffer.from(JSON.stringify(header));
+      const headerPickle = Buffer.alloc(8 + ((json.length + 3) & ~3));
+      headerPickle.writeUInt32LE(headerPickle.length - 4, 0);
+      headerPickle.writeInt32LE(json.length, 4);
+      json.copy(headerPickle, 8);
+      const sizePickle = Buffer.alloc(8);
+      sizePickle.writeUInt32LE(4, 0);
+      sizePickle.writeUInt32LE(headerPickle.length, 4);
+      const body = Object.keys(files).map(name => contents[name] || files[name]);
+      const archivePath = path.join(tmpDir, `integrity-${archiveCount++}.asar`);
+      fs.writeFileSync(archivePath, Buffer.concat([sizePickle, headerPickle, ...body]));
+      return archivePath;
+    };
+
+    const tamper = (data: Buffer, position: number) => {
+      const copy = Buffer.from(data);
+      copy[position] ^= 0xff;
+      return copy;
+    };
+
+    before(() => {
+      tmpDir = fs.mkdtempSync(path.join(os.tmpdir(), 'electron-asar-integrity-'));
+    });
+
+    after(() => {
+      fs.rmdirSync(tmpDir, { recursive: true });
+    });
+
+    it('reads files that match their integrity', async () => {
+      const data = crypto.randomBytes(blockSize * 3 + 17);
+      const json = Buffer.from(JSON.stringify({ hello: 'world' }));
+      const archive = createArchive({ 'data.bin': data, 'data.json': json });
+      expect(fs.readFileSync(path.join(archive, 'data.bin')).equals(data)).to.be.true();
+      expect((await fs.promises.readFile(path.join(archive, 'data.bin'))).equals(data)).to.be.true();
+      expect(require(path.join(archive, 'data.json'))).to.deep.equal({ hello: 'world' });
+    });
+
+    it('throws when a file does not match its integrity', async () => {
+      const data = crypto.randomBytes(blockSize * 3);
+      const archive = createArchive({ 'data.bin': data }, { 'data.bin': tamper(data, blockSize + 1) });
+      const filePath = path.join(archive, 'data.bin');
+      expect(() => fs.readFileSync(filePath)).to.throw().with.property('code', 'ERR_ASAR_INTEGRITY');
+      await expect(fs.promises.readFile(filePath)).to.eventually.be.rejected().and.have.property('code', 'ERR_ASAR_INTEGRITY');
+      expect(() => fs.openSync(filePath, 'r')).to.throw().with.property('code', 'ERR_ASAR_INTEGRITY');
+    });
+
+    it('only verifies the files that are read', () => {
+      const large = crypto.randomBytes(blockSize * 1024);
+      const small = Buffer.from('small');
+      const archive = createArchive({ 'large.bin': large, 'small.txt': small }, { 'large.bin': tamper(large, large.length - 1) });
+      expect(fs.readFileSync(path.join(archive, 'small.txt'), 'utf8')).to.equal('small');
+      expect(() => fs.readFileSync(path.join(archive, 'large.bin'))).to.throw().with.property('code', 'ERR_ASAR_INTEGRITY');
+    });
+
+    it('loads pages that match their integrity', async () => {
+      const html = Buffer.from('<html><body>verified</body></html>');
+      const archive = createArchive({ 'index.html': html });
+      const w = new BrowserWindow({ show: false });
+      await w.loadFile(path.join(archive, 'index.html'));
+      expect(await w.webContents.executeJavaScript('document.body.textContent')).to.equal('verified');
+    });
+
+    it('fails to load pages that do not match their integrity', async () => {
+      const html = Buffer.from(`<html><body>${'x'.repeat(blockSize * 2)}</body></html>`);
+      const archive = createArchive({ 'index.html': html }, { 'index.html': tamper(html, 10) });
+      const w = new BrowserWindow({ show: false });
+      await expect(w.loadFile(path.join(archive, 'index.html'))).to.eventually.be.rejectedWith(/ERR_INVALID_RESPONSE/);
+    });
+
+    it('does not send any byte of a block that does not match its integrity', async () => {
+      // A single block, larger than the buffer read to sniff the MIME type,
+      // whose tail is tampered with.
+      const data = Buffer.alloc(64 * 1024, 'a');
+      const html = Buffer.from('<html><body>verified</body></html>');
+      const archive = createArchive(
+        { 'index.html': html, 'data.txt': data },
+        { 'data.txt': tamper(data, data.length - 1) },
+        data.length);
+      const w = new BrowserWindow({ show: false });
+      await w.loadFile(path.join(archive, 'index.html'));
+      const result = await w.webContents.executeJavaScript(`new Promise((resolve) => {
+        const xhr = new XMLHttpRequest();
+        let received = 0;
+        xhr.onprogress = (event) => { received = Math.max(received, event.loaded); };
+        xhr.onload = () => resolve({ loaded: true, received: xhr.responseText.length });
+        xhr.onerror = () => resolve({ loaded: false, received });
+        xhr.open('GET', 'data.txt');
+        xhr.send();
+      })`);
+      expect(result).to.deep.equal({ loaded: false, received: 0 });
+    });
+  });
 });
@@ -0,0 +1,39 @@
+const { app, BrowserWindow, Menu, dialog } = require('electron');
+const path = require('path');
+
+let win;
+app.whenReady().then(function () {
+  try {
+    win = new BrowserWindow({ show: false });
+    console.log('Created onscreen window');
+  } catch (error) {
+    console.log(error.message);
+  }
+
+  win = new BrowserWindow({
+    width: 100,
+    height: 100,
+    show: false,
+    webPreferences: {
+      offscreen: true
+    }
+  });
+  for (const show of [
+    () => dialog.showMessageBoxSync(win, { message: 'message' }),
+    () => dialog.showOpenDialog(win, {}),
+    () => Menu.buildFromTemplate([{ label: 'item' }]).popup({ window: win })
+  ]) {
+    try {
+      show();
+      console.log('Showed native UI');
+    } catch (error) {
+      console.log(error.message);
+    }
+  }
+  win.webContents.once('paint', (event, dirty, image) => {
+    const { width, height } = image.getSize();
+    console.log(`Painted ${width}x${height}`);
+    app.quit();
+  });
+  win.loadFile(path.resolve(__dirname, '..', '..', '..', '..', 'spec', 'fixtures', 'api', 'offscreen-rendering.html'));
+});
@@ -0,0 +1,7 @@
+self.addEventListener('activate', function (event) {
+  event.waitUntil(self.clients.claim());
+});
+
+self.addEventListener('message', function (event) {
+  event.ports[0].postMessage({ echo: event.data });
+});
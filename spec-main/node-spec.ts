@@ -1,5 +1,6 @@
 import { expect } from 'chai';
 import * as childProcess from 'child_process';
+import * as fs from 'fs';
 import * as path from 'path';
 import * as util from 'util';
 import { emittedOnce } from './events-helpers';
@@ -33,6 +34,202 @@ describe('node feature', () => {
     expect(code).to.equal(0);
   });
 
+  describe('V8 background tasks', () => {
+    // A module with enough functions to be compiled by background jobs.
+    const wasmSource = `
+      const leb = (n) => { const out = []; do { let b = n & 0x7f; n >>>= 7; if (n) b |= 0x80; out.push(b); } while (n); return out; };
+      const section = (id, body) => [id, ...leb(body.length), ...body];
+      const count = 2000;
+      const body = [0, 0x41, 42, 0x0b];
+      const bytes = new Uint8Array([0, 0x61, 0x73, 0x6d, 1, 0, 0, 0,
+        ...section(1, [1, 0x60, 0, 1, 0x7f]),
+        ...section(3, [...leb(count), ...new Array(count).fill(0)]),
+        ...section(7, [1, 1, 0x66, 0, 0]),
+        ...section(10, [...leb(count), ...[].concat(...new Array(count).fill([body.length, ...body]))])]);
+      WebAssembly.instantiate(bytes).then(({ instance }) => instance.exports.f())`;
+
+    it('run in the browser process', async () => {
+      // eslint-disable-next-line no-eval
+      expect(await eval(wasmSource)).to.equal(42);
+    });
+
+    it('run in a worker thread of the browser process', async () => {
+      const { Worker } = require('worker_threads');
+      const worker = new Worker(`
+        const { parentPort } = require('worker_threads');
+        ${wasmSource}.then(result => parentPort.postMessage(result));
+      `, { eval: true });
+      const [result] = await emittedOnce(worker, 'message');
+      expect(result).to.equal(42);
+      await worker.terminate();
+    });
+
+    it('run with ELECTRON_RUN_AS_NODE', async () => {
+      const child = childProcess.spawn(process.execPath, ['-e', `${wasmSource}.then(result => console.log(result))`], {
+        env: { ...process.env, ELECTRON_RUN_AS_NODE: 'true' }
+      });
+      let output = '';
+      child.stdout.on('data', data => { output += data; });
+      const [code] = await emittedOnce(child, 'close');
+      expect(code).to.equal(0);
+      expect(output.trim()).to.equal('42');
+    });
+
+    // Benchmarks, the numbers are reported rather than compared as they
+    // depend on the machine.
+    ifit(process.platform === 'linux')('reports the threads of the browser process', async () => {
+      // eslint-disable-next-line no-eval
+      await eval(wasmSource);
+      const names = fs.readdirSync('/proc/self/task').map(tid => {
+        return fs.readFileSync(`/proc/self/task/${tid}/comm`, 'utf8').trim();
+      });
+      const counts: Record<string, number> = {};
+      for (const name of names) counts[name] = (counts[name] || 0) + 1;
+      console.log(`browser process threads: ${names.length}`, counts);
+      expect(names.some(name => name.startsWith('ThreadPool'))).to.be.true('has ThreadPool threads');
+    });
+
+    it('reports the GC pauses of the browser process', async () => {
+      const { PerformanceObserver } = require('perf_hooks');
+      const pauses: number[] = [];
+      const observer = new PerformanceObserver((list: any) => {
+        for (const entry of list.getEntries()) pauses.push(entry.duration);
+      });
+      observer.observe({ entryTypes: ['gc'] });
+      let retained: number[][] = [];
+      for (let i = 0; i < 200; i++) {
+        for (let j = 0; j < 100; j++) retained.push(new Array(1000).fill(i));
+        if (retained.length > 5000) retained = [];
+        await new Promise(resolve => setImmediate(resolve));
+      }
+      await new Promise(resolve => setTimeout(resolve, 100));
+      observer.disconnect();
+      expect(pauses).to.not.be.empty('GC pauses');
+      pauses.sort((a, b) => a - b);
+      const total = pauses.reduce((sum, pause) => sum + pause, 0);
+      const percentile = (p: number) => pauses[Math.min(pauses.length - 1, Math.floor(pauses.length * p))];
+      console.log(`browser process GC pauses: ${pauses.length}, total ${total.toFixed(1)}ms, ` +
+        `p50 ${percentile(0.5).toFixed(2)}ms, p95 ${percentile(0.95).toFixed(2)}ms, max ${pauses[pauses.length - 1].toFixed(2)}ms`);
+    });
+  });
+
+  describe('V8 idle time garbage collection', () => {
+    const runIdleGCApp = async (args: string[]) => {
+      const appPath = path.join(fixtures, 'api', 'idle-gc-app');
+      const child = childProcess.spawn(process.execPath, [appPath, ...args]);
+      let output = '';
+      child.stdout.on('data', data => { output += data; });
+      const [code] = await emittedOnce(child, 'close');
+      expect(code).to.equal(0);
+      const report = output.split('\n').find(line => line.startsWith('{"burst"'));
+      return JSON.parse(report!);
+    };
+
+    // The idle periods are counted from the trace events of IdleGCScheduler,
+    // whether V8 collects garbage in them depends on the state of its heap.
+    it('gives V8 idle time while the browser process is idle', async function () {
+      this.timeout(30000);
+      const { idlePeriods, burst, idle } = await runIdleGCApp([]);
+      expect(idlePeriods).to.be.greaterThan(0);
+      expect(burst).to.be.an('array');
+      expect(idle).to.be.an('array');
+    });
+
+    it('can be disabled with --disable-features=IdleTimeGarbageCollection', async function () {
+      this.timeout(30000);
+      const { idlePeriods } = await runIdleGCApp(['--disable-features=IdleTimeGarbageCollection']);
+      expect(idlePeriods).to.equal(0);
+    });
+
+    // A benchmark, the distributions are reported rather than compared as
+    // they depend on the machine.
+    it('reports the GC pauses with and without idle time', async function () {
+      this.timeout(60000);
+      const summarize = ({ burst, idle }: { burst: number[], idle: number[] }) => {
+        const sum = (pauses: number[]) => pauses.reduce((total, pause) => total + pause, 0);
+        const total = sum(burst) + sum(idle);
+        return {
+          pauses: burst.length + idle.length,
+          totalMs: +total.toFixed(2),
+          burstShare: total ? +(sum(burst) / total).toFixed(3) : 0,
+          maxBurstMs: +Math.max(0, ...burst).toFixed(2)
+        };
+      };
+      const enabled = summarize(await runIdleGCApp([]));
+      const disabled = summarize(await runIdleGCApp(['--disable-features=IdleTimeGarbageCollection']));
+      console.log('GC pauses with idle time garbage collection:', enabled);
+      console.log('GC pauses without idle time garbage collection:', disabled);
+      expect(enabled.pauses).to.be.greaterThan(0);
+      expect(disabled.pauses).to.be.greaterThan(0);
+    });
+  });
+
+  describe('worker_threads in the browser process', () => {
+    const { Worker } = require('worker_threads');
+
+    const runWorkers = async (count: number, source: string, workerData?: any) => {
+      const workers = new Array(count).fill(0).map(() => new Worker(source, { eval: true, workerData }));
+      try {
+        return await Promise.all(workers.map(async worker => {
+          const [result] = await emittedOnce(worker, 'message');
+          return result;
+        }));
+      } finally {
+        await Promise.all(workers.map(worker => worker.terminate()));
+      }
+    };
+
+    it('can use nativeImage from several workers at once', async () => {
+      const png = fs.readFileSync(path.join(fixtures, 'assets', 'logo.png'));
+      const results = await runWorkers(4, `
+        const { parentPort, workerData } = require('worker_threads');
+        const { nativeImage } = require('electron');
+        let size;
+        for (let i = 0; i < 20; i++) {
+          const image = nativeImage.createFromBuffer(Buffer.from(workerData));
+          const resized = nativeImage.createFromBuffer(image.resize({ width: 32 }).toPNG());
+          size = resized.getSize();
+        }
+        parentPort.postMessage(size);
+      `, png);
+      for (const size of results) {
+        expect(size.width).to.equal(32);
+      }
+    });
+
+    it('can read asar archives from several workers at once', async () => {
+      const results = await runWorkers(4, `
+        const { parentPort, workerData } = require('worker_threads');
+        const fs = require('fs');
+        parentPort.postMessage(fs.readFileSync(workerData).toString().trim());
+      `, path.join(fixtures, 'test.asar', 'a.asar', 'file1'));
+      expect(results).to.deep.equal(new Array(4).fill('file1'));
+    });
+
+    it('throws for the nativeImage methods that need the main thread', async () => {
+      const [errors] = await runWorkers(1, `
+        const { parentPort } = require('worker_threads');
+        const { nativeImage } = require('electron');
+        const errors = [];
+        try { nativeImage.createThumbnailFromPath(__filename, { width: 32, height: 32 }); } catch (error) { errors.push(error.message); }
+        try { nativeImage.createFromNamedImage('NSActionTemplate'); } catch (error) { errors.push(error.message); }
+        parentPort.postMessage(errors);
+      `);
+      expect(errors).to.deep.equal([
+        'nativeImage.createThumbnailFromPath() can only be used on the main thread',
+        'nativeImage.createFromNamedImage() can only be used on the main thread'
+      ]);
+    });
+
+    it('does not expose the modules that need the main thread', async () => {
+      const [names] = await runWorkers(1, `
+        const { parentPort } = require('worker_threads');
+        parentPort.postMessage(Object.keys(require('electron')));
+      `);
+      expect(names).to.deep.equal(['nativeImage']);
+    });
+  });
+
   describe('contexts', () => {
     describe('setTimeout called under Chromium event loop in browser process', () => {
       it('Can be scheduled in time', (done) => {
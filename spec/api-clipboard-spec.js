@@ -24,6 +24,23 @@ describe('clipboard module', () => {
     });
   });
 
+  describe('clipboard.readImageAsync()', () => {
+    it('resolves with a NativeImage instance', async () => {
+      const p = path.join(fixtures, 'assets', 'logo.png');
+      const i = nativeImage.createFromPath(p);
+      clipboard.writeImage(p);
+      const readImage = await clipboard.readImageAsync();
+      expect(readImage.isEmpty()).to.be.false();
+      expect(readImage.getSize()).to.deep.equal(i.getSize());
+    });
+
+    it('resolves with an empty image when the clipboard has no image', async () => {
+      clipboard.writeText('not an image');
+      const readImage = await clipboard.readImageAsync();
+      expect(readImage.isEmpty()).to.be.true();
+    });
+  });
+
   describe('clipboard.readText()', () => {
     it('returns unicode string correctly', () => {
       const text = '千江有水千江月，万里无云万里天';
@@ -119,10 +136,32 @@ describe('clipboard module', () => {
       expect(buffer.equals(clipboard.readBuffer('public.utf8-plain-text'))).to.equal(true);
     });
 
+    it('reads a large Buffer', () => {
+      const buffer = Buffer.alloc(4 * 1024 * 1024, 'electron');
+      clipboard.writeBuffer('public.utf8-plain-text', buffer);
+      expect(buffer.equals(clipboard.readBuffer('public.utf8-plain-text'))).to.equal(true);
+    });
+
     it('throws an error when a non-Buffer is specified', () => {
       expect(() => {
         clipboard.writeBuffer('public.utf8-plain-text', 'hello');
       }).to.throw(/buffer must be a node Buffer/);
     });
   });
+
+  describe('clipboard.readBufferAsync(format)', () => {
+    it('resolves with a Buffer for the specified format', async () => {
+      const buffer = Buffer.from('readBufferAsync', 'utf8');
+      clipboard.writeBuffer('public.utf8-plain-text', buffer);
+      const result = await clipboard.readBufferAsync('public.utf8-plain-text');
+      expect(Buffer.isBuffer(result)).to.equal(true);
+      expect(buffer.equals(result)).to.equal(true);
+    });
+
+    it('resolves with an empty Buffer for a missing format', async () => {
+      clipboard.clear();
+      const result = await clipboard.readBufferAsync('electron/does-not-exist');
+      expect(result.length).to.equal(0);
+    });
+  });
 });
@@ -274,6 +274,38 @@ describe('chromium feature', () => {
       expect(event.channel).to.equal('object function object function');
     });
 
+    it('many Workers with nodeIntegrationInWorker can read from asar archives', async () => {
+      const webview = new WebView();
+      const eventPromise = waitForEvent(webview, 'ipc-message');
+      webview.src = `file://${fixtures}/pages/worker-pool.html`;
+      webview.setAttribute('webpreferences', 'nodeIntegration, nodeIntegrationInWorker, contextIsolation=no');
+      document.body.appendChild(webview);
+      const event = await eventPromise;
+      webview.remove();
+      expect(event.channel).to.equal(Array(16).fill('file1').join(' '));
+    });
+
+    it('Workers with nodeIntegrationInWorker share the code cache of the modules they require', async function () {
+      this.timeout(60000);
+      const webview = new WebView();
+      const eventPromise = waitForEvent(webview, 'ipc-message');
+      webview.src = `file://${fixtures}/pages/worker-startup.html`;
+      webview.setAttribute('webpreferences', 'nodeIntegration, nodeIntegrationInWorker, contextIsolation=no');
+      document.body.appendChild(webview);
+      const event = await eventPromise;
+      webview.remove();
+      const [{ count, withoutCache, withCache }] = event.args;
+      const describePool = ({ medianLatency, medianRequireTime, residentSetGrowth }) =>
+        `median startup ${medianLatency.toFixed(1)}ms, median require ${medianRequireTime.toFixed(1)}ms` +
+        (residentSetGrowth === undefined ? '' : `, resident set growth ${Math.round(residentSetGrowth / 1024)}MB`);
+      console.log(`    ${count} workers without the code cache: ${describePool(withoutCache)}`);
+      console.log(`    ${count} workers with the code cache: ${describePool(withCache)}`);
+      expect(withoutCache.cacheHits).to.equal(0);
+      // Every worker after the first one consumes the cached code.
+      expect(withCache.cacheHits).to.be.at.least(count - 1);
+      expect(withCache.medianRequireTime).to.be.below(withoutCache.medianRequireTime);
+    });
+
     describe('SharedWorker', () => {
       it('can work', async () => {
         const worker = new SharedWorker('../fixtures/workers/shared_worker.js');
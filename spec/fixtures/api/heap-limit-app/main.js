@@ -0,0 +1,24 @@
+const { app } = require('electron');
+const fs = require('fs');
+
+const heapSnapshotPath = process.argv[2];
+
+app.setHeapLimitOptions({
+  maxOldSpaceSize: 128,
+  extraOldSpaceSize: 64,
+  heapSnapshotPath
+});
+
+// Leak until the heap limit is nearly reached.
+let leak = [];
+const timer = setInterval(() => {
+  for (let i = 0; i < 100; i++) leak.push(new Array(1000).fill(i));
+}, 1);
+
+app.once('near-heap-limit', (event, details) => {
+  clearInterval(timer);
+  leak = null;
+  const heapSnapshotSize = fs.statSync(details.heapSnapshotPath).size;
+  process.stdout.write(JSON.stringify({ details, heapSnapshotSize }));
+  app.exit(0);
+});
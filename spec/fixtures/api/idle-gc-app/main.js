@@ -0,0 +1,47 @@
+const { app, contentTracing } = require('electron');
+const fs = require('fs');
+const { performance, PerformanceObserver } = require('perf_hooks');
+
+// Alternates bursts of allocations with idle periods, and reports the
+// garbage collection pauses that happened in each, along with the number of
+// idle periods that were given to V8.
+const rounds = 15;
+const burstTime = 30;
+const idleTime = 300;
+
+const bursts = [];
+const pauses = { burst: [], idle: [] };
+
+const observer = new PerformanceObserver(list => {
+  for (const entry of list.getEntries()) {
+    const inBurst = bursts.some(([start, end]) => entry.startTime >= start && entry.startTime <= end);
+    pauses[inBurst ? 'burst' : 'idle'].push(entry.duration);
+  }
+});
+observer.observe({ entryTypes: ['gc'] });
+
+let retained = [];
+function burst () {
+  const start = performance.now();
+  while (performance.now() - start < burstTime) {
+    const garbage = new Array(1000).fill(start);
+    if (retained.length < 5000) retained.push(garbage);
+  }
+  bursts.push([start, performance.now()]);
+  if (retained.length >= 5000) retained = [];
+}
+
+app.whenReady().then(async () => {
+  await contentTracing.startRecording({ included_categories: ['electron'] });
+  for (let i = 0; i < rounds; i++) {
+    burst();
+    await new Promise(resolve => setTimeout(resolve, idleTime));
+  }
+  observer.disconnect();
+  const tracePath = await contentTracing.stopRecording();
+  const { traceEvents } = JSON.parse(fs.readFileSync(tracePath, 'utf8'));
+  fs.unlinkSync(tracePath);
+  const idlePeriods = traceEvents.filter(event => event.name === 'IdleGCScheduler::RunIdlePeriod').length;
+  process.stdout.write(`\n${JSON.stringify({ ...pauses, idlePeriods })}\n`);
+  app.quit();
+});
@@ -0,0 +1,2 @@
+const fs = require('fs');
+self.postMessage(fs.readFileSync(`${self.name}/a.asar/file1`).toString().trim());
@@ -0,0 +1,3 @@
+const start = performance.now();
+require(self.name);
+self.postMessage(performance.now() - start);
@@ -59,6 +59,7 @@ declare namespace NodeJS {
     size: number;
     unpacked: boolean;
     offset: number;
+    hasIntegrity: boolean;
   };
 
   type AsarFileStat = {
@@ -77,6 +78,7 @@ declare namespace NodeJS {
     realpath(path: string): string | false;
     copyFileOut(path: string): string | false;
     getFd(): number | -1;
+    verifyRead(path: string, buffer: Buffer, position: number): boolean;
   }
 
   interface AsarBinding {
@@ -132,13 +134,22 @@ declare namespace NodeJS {
     done: () => void;
   };
   type BodyFunc = (pipe: DataPipe) => void;
+  type UploadElement = {
+    type: 'file';
+    filePath: string;
+    offset?: number;
+    length?: number;
+  } | {
+    type: 'blob';
+    blobUUID: string;
+  };
   type CreateURLLoaderOptions = {
     method: string;
     url: string;
     extraHeaders?: Record<string, string>;
     useSessionCookies?: boolean;
     credentials?: 'include' | 'omit';
-    body: Uint8Array | BodyFunc;
+    body: Uint8Array | (Uint8Array | UploadElement)[] | BodyFunc;
     session?: Electron.Session;
     partition?: string;
     referrer?: string;
@@ -238,9 +249,11 @@ declare namespace NodeJS {
     _linkedBinding(name: 'electron_browser_view'): { View: Electron.View };
     _linkedBinding(name: 'electron_browser_web_contents_view'): { WebContentsView: typeof Electron.WebContentsView };
     _linkedBinding(name: 'electron_browser_web_view_manager'): WebViewManagerBinding;
+    _linkedBinding(name: 'electron_browser_worker_thread'): { setUpIsolate(): void };
     _linkedBinding(name: 'electron_browser_web_frame_main'): {
       WebFrameMain: typeof Electron.WebFrameMain;
       fromId(processId: number, routingId: number): Electron.WebFrameMain;
+      _broadcast(frames: Electron.WebFrameMain[], internal: boolean, channel: string, args: any[]): number;
     }
     _linkedBinding(name: 'electron_renderer_crash_reporter'): Electron.CrashReporter;
     _linkedBinding(name: 'electron_renderer_ipc'): { ipc: IpcRendererBinding };
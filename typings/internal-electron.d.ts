@@ -14,6 +14,7 @@ declare namespace Electron {
 
   interface App {
     _setDefaultAppPaths(packagePath: string | null): void;
+    _setHeapStatisticsEnabled(enabled: boolean): void;
     setVersion(version: string): void;
     setDesktopName(name: string): void;
     setAppPath(path: string | null): void;
@@ -56,6 +57,8 @@ declare namespace Electron {
   }
 
   interface WebContents {
+    _startObservingFrameTree(): void;
+    _stopObservingFrameTree(): void;
     _getURL(): string;
     _loadURL(url: string, options: ElectronInternal.LoadURLOptions): void;
     _stop(): void;